@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+"""
+Compara duas execucoes dos benchmarks do radar.
+
+Uso:
+    python compare_bench.py antes.txt depois.txt
+
+Os arquivos sao a saida do console do benchmark (linhas "BENCH {json}");
+as demais linhas sao ignoradas.
+"""
+
+import json
+import sys
+
+
+def load(path):
+    """Le os resultados de um arquivo de saida, indexados pelo nome."""
+    results = {}
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            idx = line.find("BENCH {")
+            if idx < 0:
+                continue
+            entry = json.loads(line[idx + len("BENCH "):])
+            results[entry["name"]] = entry
+    return results
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(__doc__)
+        return 1
+
+    before = load(sys.argv[1])
+    after = load(sys.argv[2])
+
+    boards = {e["board"] for e in list(before.values()) + list(after.values())}
+    if len(boards) > 1:
+        print(f"AVISO: placas diferentes ({', '.join(sorted(boards))})")
+
+    rev_a = next(iter(before.values()), {}).get("rev", "?")
+    rev_b = next(iter(after.values()), {}).get("rev", "?")
+
+    print(f"{'funcao':34} {rev_a:>14} {rev_b:>14} {'delta':>8}")
+    for name in sorted(set(before) | set(after)):
+        a = before.get(name, {}).get("cycles_per_call")
+        b = after.get(name, {}).get("cycles_per_call")
+        if a is None or b is None:
+            print(f"{name:34} {a if a is not None else '-':>14} "
+                  f"{b if b is not None else '-':>14} {'':>8}")
+            continue
+        delta = ((b - a) / a * 100.0) if a else 0.0
+        print(f"{name:34} {a:>14.2f} {b:>14.2f} {delta:>+7.1f}%")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
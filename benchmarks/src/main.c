@@ -0,0 +1,193 @@
+/**
+ * @file main.c
+ * @brief Benchmarks das funções do caminho de detecção
+ *
+ * Mede ciclos por chamada e chamadas por segundo de:
+ * - calculate_speed_kmh / calculate_speed_centi_kmh(_fast)
+ * - determine_speed_status / determine_speed_status_centi
+ * - validate_mercosul_plate (corpus de 630 placas)
+ * - plate_strip_spaces (placas como entregues pelo camera_service)
+ * - format_display_frame / display_render_update
+ *
+ * Cada resultado é uma linha "BENCH {json}" com a revisão e a placa,
+ * para comparar commits com benchmarks/compare_bench.py. Compare
+ * apenas resultados da mesma placa.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include "utils/calculations.h"
+#include "utils/plate_validator.h"
+#include "utils/display_format.h"
+#include "utils/display_render.h"
+#include "plate_corpus.h"
+
+#ifndef RADAR_BENCH_REV
+#define RADAR_BENCH_REV "unknown"
+#endif
+
+/* Parâmetros do caminho de detecção (valores padrão do Kconfig) */
+#define BENCH_DISTANCE_MM 1000
+#define BENCH_SPEED_LIMIT_KMH 60
+#define BENCH_WARNING_PERCENT 90
+
+/* Repetições de cada medição */
+#define BENCH_CALLS 20000
+#define BENCH_FRAME_CALLS 500
+
+/* Corpus de tempos: veículos de 20 a 160 km/h */
+#define TIME_CORPUS_SIZE 256
+
+static uint32_t time_corpus_us[TIME_CORPUS_SIZE];
+static uint32_t speed_corpus_centi[TIME_CORPUS_SIZE];
+
+/* Impede que o compilador descarte as chamadas medidas */
+static volatile uint32_t bench_sink;
+
+/**
+ * @brief Gera o corpus de tempos entre sensores
+ */
+static void time_corpus_init(void)
+{
+    for (int i = 0; i < TIME_CORPUS_SIZE; i++) {
+        /* 20,00 a 160,00 km/h em passos irregulares */
+        uint32_t speed_centi = 2000 + (uint32_t)((i * 5477) % 14001);
+
+        time_corpus_us[i] = (uint32_t)(((uint64_t)BENCH_DISTANCE_MM * 360000U) / speed_centi);
+        speed_corpus_centi[i] = speed_centi;
+    }
+}
+
+/**
+ * @brief Imprime um resultado em formato JSON (uma linha)
+ */
+static void bench_report(const char *name, uint32_t calls, uint32_t cycles)
+{
+    uint64_t per_call_x100 = ((uint64_t)cycles * 100U) / calls;
+    uint64_t calls_per_sec = (cycles != 0)
+        ? ((uint64_t)calls * sys_clock_hw_cycles_per_sec()) / cycles
+        : 0;
+
+    printk("BENCH {\"rev\":\"%s\",\"board\":\"%s\",\"name\":\"%s\","
+           "\"calls\":%u,\"cycles\":%u,\"cycles_per_call\":%llu.%02llu,"
+           "\"calls_per_sec\":%llu}\n",
+           RADAR_BENCH_REV, CONFIG_BOARD, name, calls, cycles,
+           per_call_x100 / 100U, per_call_x100 % 100U, calls_per_sec);
+}
+
+/*
+ * Mede o corpo (argumentos variádicos) repetido "calls" vezes, com
+ * i = índice da chamada e o escalonador travado. k_cycle_get_32() dá
+ * margem de sobra para as durações medidas aqui (< 1 s).
+ */
+#define BENCH_RUN(name, calls, ...)                                     \
+    do {                                                                \
+        uint32_t acc = 0;                                               \
+        k_sched_lock();                                                 \
+        uint32_t start = k_cycle_get_32();                              \
+        for (uint32_t i = 0; i < (calls); i++) {                        \
+            __VA_ARGS__;                                                \
+        }                                                               \
+        uint32_t cycles = k_cycle_get_32() - start;                     \
+        k_sched_unlock();                                               \
+        bench_sink = acc;                                               \
+        bench_report(name, calls, cycles);                              \
+    } while (0)
+
+static void bench_speed(void)
+{
+    BENCH_RUN("calculate_speed_kmh", BENCH_CALLS,
+              acc += calculate_speed_kmh(time_corpus_us[i % TIME_CORPUS_SIZE] / 1000,
+                                         BENCH_DISTANCE_MM));
+
+    BENCH_RUN("calculate_speed_centi_kmh", BENCH_CALLS,
+              acc += calculate_speed_centi_kmh(time_corpus_us[i % TIME_CORPUS_SIZE],
+                                               BENCH_DISTANCE_MM));
+
+    BENCH_RUN("calculate_speed_centi_kmh_fast", BENCH_CALLS,
+              acc += calculate_speed_centi_kmh_fast(time_corpus_us[i % TIME_CORPUS_SIZE],
+                                                    BENCH_DISTANCE_MM));
+}
+
+static void bench_status(void)
+{
+    BENCH_RUN("determine_speed_status", BENCH_CALLS,
+              acc += determine_speed_status(speed_corpus_centi[i % TIME_CORPUS_SIZE] / 100,
+                                            BENCH_SPEED_LIMIT_KMH,
+                                            BENCH_WARNING_PERCENT));
+
+    BENCH_RUN("determine_speed_status_centi", BENCH_CALLS,
+              acc += determine_speed_status_centi(speed_corpus_centi[i % TIME_CORPUS_SIZE],
+                                                  BENCH_SPEED_LIMIT_KMH,
+                                                  BENCH_WARNING_PERCENT));
+}
+
+static void bench_plates(void)
+{
+    char plate[8];
+
+    BENCH_RUN("validate_mercosul_plate", BENCH_CALLS,
+              acc += validate_mercosul_plate(plate_corpus_clean[i % PLATE_CORPUS_SIZE], NULL));
+
+    BENCH_RUN("plate_strip_spaces", BENCH_CALLS,
+              acc += plate_strip_spaces(plate, sizeof(plate),
+                                        plate_corpus_raw[i % PLATE_CORPUS_SIZE]));
+}
+
+static void bench_display(void)
+{
+    static char frame[DISPLAY_FRAME_MAX_LEN];
+    display_data_msg_t data = {
+        .speed_limit = BENCH_SPEED_LIMIT_KMH,
+        .vehicle_type = VEHICLE_TYPE_LIGHT,
+    };
+
+    BENCH_RUN("format_display_frame", BENCH_FRAME_CALLS,
+              data.seq = i;
+              data.speed_centi_kmh = speed_corpus_centi[i % TIME_CORPUS_SIZE];
+              data.status = determine_speed_status_centi(data.speed_centi_kmh,
+                                                         BENCH_SPEED_LIMIT_KMH,
+                                                         BENCH_WARNING_PERCENT);
+              /* Metade dos quadros com placa (infrações capturadas) */
+              data.plate[0] = '\0';
+              if (i % 2) {
+                  plate_strip_spaces(data.plate, sizeof(data.plate),
+                                     plate_corpus_raw[i % PLATE_CORPUS_SIZE]);
+              }
+              acc += format_display_frame(frame, sizeof(frame), &data));
+
+    /* Mesma sequência: quadro novo a cada veículo e só a placa depois */
+    static struct display_renderer renderer;
+    static char update[DISPLAY_UPDATE_MAX_LEN];
+
+    display_renderer_init(&renderer);
+    BENCH_RUN("display_render_update", BENCH_FRAME_CALLS,
+              data.seq = i / 2;
+              data.speed_centi_kmh = speed_corpus_centi[(i / 2) % TIME_CORPUS_SIZE];
+              data.status = determine_speed_status_centi(data.speed_centi_kmh,
+                                                         BENCH_SPEED_LIMIT_KMH,
+                                                         BENCH_WARNING_PERCENT);
+              data.plate[0] = '\0';
+              if (i % 2) {
+                  plate_strip_spaces(data.plate, sizeof(data.plate),
+                                     plate_corpus_raw[i % PLATE_CORPUS_SIZE]);
+              }
+              acc += display_render_update(&renderer, &data, update, sizeof(update)));
+}
+
+int main(void)
+{
+    time_corpus_init();
+    plate_corpus_init();
+
+    printk("BENCH_START rev=%s board=%s cycles_per_sec=%u\n",
+           RADAR_BENCH_REV, CONFIG_BOARD, sys_clock_hw_cycles_per_sec());
+
+    bench_speed();
+    bench_status();
+    bench_plates();
+    bench_display();
+
+    printk("BENCH_DONE\n");
+    return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file plate_corpus.h
+ * @brief Corpus de placas para os benchmarks
+ *
+ * Reproduz a composição do banco do camera_service (630 placas, 139
+ * Mercosul válidas: 100 BR, 19 UY, 10 AR, 10 PY; o restante em formato
+ * inválido) de forma determinística, para que os resultados sejam
+ * comparáveis entre commits. Metade das placas recebe um espaço
+ * no meio, como o camera_service entrega.
+ */
+
+#ifndef RADAR_BENCH_PLATE_CORPUS_H
+#define RADAR_BENCH_PLATE_CORPUS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define PLATE_CORPUS_SIZE 630
+#define PLATE_CORPUS_MAX_LEN 12
+
+/** Placas como entregues pelo camera_service (com espaços) */
+static char plate_corpus_raw[PLATE_CORPUS_SIZE][PLATE_CORPUS_MAX_LEN];
+
+/** Mesmas placas já sem espaços */
+static char plate_corpus_clean[PLATE_CORPUS_SIZE][PLATE_CORPUS_MAX_LEN];
+
+/* Composição do banco: padrão e quantidade */
+static const struct {
+    const char *pattern;
+    uint16_t count;
+} plate_corpus_mix[] = {
+    { "LLLNLNN", 100 },  /* Brasil */
+    { "LLLNNNN", 19 },   /* Uruguai */
+    { "LLNNNLL", 10 },   /* Argentina */
+    { "LLLLNNN", 10 },   /* Paraguai */
+    { "LLNLNNN", 164 },  /* Inválidas: classes trocadas */
+    { "LLLNLN", 164 },   /* Inválidas: curtas */
+    { "LLLNLNNN", 163 }, /* Inválidas: longas */
+};
+
+static uint32_t plate_corpus_rand_state = 0x2545F491;
+
+static inline uint32_t plate_corpus_rand(void)
+{
+    /* xorshift32: determinístico e independente da plataforma */
+    uint32_t x = plate_corpus_rand_state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    plate_corpus_rand_state = x;
+    return x;
+}
+
+/**
+ * @brief Gera o corpus (sempre o mesmo conteúdo)
+ */
+static inline void plate_corpus_init(void)
+{
+    int idx = 0;
+
+    for (size_t m = 0; m < sizeof(plate_corpus_mix) / sizeof(plate_corpus_mix[0]); m++) {
+        for (uint16_t n = 0; n < plate_corpus_mix[m].count; n++, idx++) {
+            const char *p = plate_corpus_mix[m].pattern;
+            char *clean = plate_corpus_clean[idx];
+            char *raw = plate_corpus_raw[idx];
+            int len = 0;
+
+            for (; p[len] != '\0'; len++) {
+                uint32_t r = plate_corpus_rand();
+
+                clean[len] = (p[len] == 'L') ? (char)('A' + r % 26) : (char)('0' + r % 10);
+            }
+            clean[len] = '\0';
+
+            /* Metade com espaço após o 3º caractere */
+            int out = 0;
+            for (int i = 0; i < len; i++) {
+                if (i == 3 && (idx % 2) == 0) {
+                    raw[out++] = ' ';
+                }
+                raw[out++] = clean[i];
+            }
+            raw[out] = '\0';
+        }
+    }
+}
+
+#endif /* RADAR_BENCH_PLATE_CORPUS_H */
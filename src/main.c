@@ -16,13 +16,38 @@
 #include <string.h>
 #include "types.h"
 #include "utils/calculations.h"
+#include "utils/axle_class.h"
 #include "utils/plate_validator.h"
+#include "utils/detection_store.h"
+#include "utils/plate_cache.h"
+#include "utils/traffic_stats.h"
+#include "utils/vehicle_pool.h"
+#include "utils/latency_hist.h"
+#include "utils/radar_stats.h"
+#include "radar_settings.h"
 
 LOG_MODULE_REGISTER(main, LOG_LEVEL_INF);
 
-/* Filas de mensagens */
-K_MSGQ_DEFINE(sensor_msgq, sizeof(sensor_data_msg_t), 10, 4);
-K_MSGQ_DEFINE(display_msgq, sizeof(display_data_msg_t), 10, 4);
+/* Registros de veículo (alocados pelo sensor, soltos pelo último estágio) */
+K_MEM_SLAB_DEFINE(vehicle_pool, sizeof(vehicle_record_t), VEHICLE_POOL_SIZE, 4);
+
+/* Filas de mensagens (cada item é um vehicle_record_t * com uma referência) */
+K_MSGQ_DEFINE(sensor_msgq, sizeof(vehicle_record_t *), 10, 4);
+K_MSGQ_DEFINE(display_msgq, sizeof(vehicle_record_t *), 10, 4);
+K_MSGQ_DEFINE(journal_msgq, sizeof(vehicle_record_t *), 16, 4);
+
+/**
+ * @brief Placa a gravar em detections (estágio de captura -> principal)
+ *
+ * A thread principal é a única escritora de detections; o estágio de
+ * captura não escreve lá diretamente.
+ */
+typedef struct {
+    uint64_t plate_key;     /**< plate_pack_key() */
+    uint32_t store_seq;     /**< Registro em detection_store */
+} store_plate_msg_t;
+
+K_MSGQ_DEFINE(store_plate_msgq, sizeof(store_plate_msg_t), 8, 8);
 
 /* Canais ZBUS */
 ZBUS_CHAN_DEFINE(camera_trigger_chan,
@@ -31,6 +56,7 @@ ZBUS_CHAN_DEFINE(camera_trigger_chan,
                  NULL,
                  ZBUS_OBSERVERS_EMPTY,
                  ZBUS_MSG_INIT(0));
+BUILD_ASSERT(sizeof(camera_trigger_event_t) <= CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_STATIC_DATA_SIZE);
 
 ZBUS_CHAN_DEFINE(camera_result_chan,
                  camera_result_event_t,
@@ -38,109 +64,447 @@ ZBUS_CHAN_DEFINE(camera_result_chan,
                  NULL,
                  ZBUS_OBSERVERS_EMPTY,
                  ZBUS_MSG_INIT(0));
+BUILD_ASSERT(sizeof(camera_result_event_t) <= CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_STATIC_DATA_SIZE);
+
+/* Detecções recentes (escritas apenas pela thread principal, placas via store_plate_msgq) */
+struct detection_store detections;
+
+/* Estatísticas de tráfego por faixa (minuto/hora/dia) */
+struct traffic_stats traffic;
+
+/* Latência por estágio (cada estágio registra a sua transição) */
+struct latency_stats latency;
+
+/* Contadores do pipeline (incrementados pelos estágios, lidos pelo shell) */
+struct radar_stats radar_stats;
+
+/* Placas capturadas recentemente (apenas o estágio de captura acessa) */
+static struct plate_cache recent_plates;
+
+/* MSG_SUBSCRIBER para resultado da câmera (cada resultado chega por valor),
+ * ligado ao canal em tempo de compilação */
+ZBUS_MSG_SUBSCRIBER_DEFINE(camera_result_sub);
+ZBUS_CHAN_ADD_OBS(camera_result_chan, camera_result_sub, 3);
+
+/* Capturas em andamento */
+#define MAX_PENDING_CAPTURES 8
+
+/**
+ * @brief Infração aguardando o resultado da câmera
+ */
+typedef struct {
+    bool in_use;                     /**< Entrada ocupada */
+    uint32_t request_id;             /**< Requisição de captura associada */
+    int64_t deadline;                /**< Instante limite para o resultado */
+    vehicle_record_t *vehicle;       /**< Veículo (referência da tabela) */
+} pending_capture_t;
+
+static pending_capture_t pending_captures[MAX_PENDING_CAPTURES];
+static uint32_t next_request_id = 1;
+K_MUTEX_DEFINE(pending_lock);
+
+/**
+ * @brief Registra uma infração aguardando captura
+ *
+ * A tabela guarda uma referência ao veículo até o resultado ou o timeout.
+ *
+ * @return Identificador da requisição, ou 0 se não há entrada livre
+ */
+static uint32_t pending_capture_add(vehicle_record_t *vehicle)
+{
+    uint32_t request_id = 0;
+
+    k_mutex_lock(&pending_lock, K_FOREVER);
+    for (int i = 0; i < MAX_PENDING_CAPTURES; i++) {
+        if (!pending_captures[i].in_use) {
+            /* 0 é reservado para "sem requisição" */
+            if (next_request_id == 0) {
+                next_request_id = 1;
+            }
+            request_id = next_request_id++;
+
+            pending_captures[i].in_use = true;
+            pending_captures[i].request_id = request_id;
+            pending_captures[i].deadline = k_uptime_get() + CAPTURE_TIMEOUT_MS;
+            pending_captures[i].vehicle = vehicle_record_ref(vehicle);
+            break;
+        }
+    }
+    k_mutex_unlock(&pending_lock);
+
+    return request_id;
+}
+
+/**
+ * @brief Retira da tabela a infração associada a uma requisição
+ *
+ * A referência ao veículo passa para quem chamou (out->vehicle).
+ *
+ * @return true se a requisição estava pendente
+ */
+static bool pending_capture_take(uint32_t request_id, pending_capture_t *out)
+{
+    bool found = false;
+
+    k_mutex_lock(&pending_lock, K_FOREVER);
+    for (int i = 0; i < MAX_PENDING_CAPTURES; i++) {
+        if (pending_captures[i].in_use &&
+            pending_captures[i].request_id == request_id) {
+            *out = pending_captures[i];
+            pending_captures[i].in_use = false;
+            found = true;
+            break;
+        }
+    }
+    k_mutex_unlock(&pending_lock);
+
+    return found;
+}
+
+/**
+ * @brief Descarta capturas vencidas
+ *
+ * @return Tempo até o próximo vencimento (CAPTURE_TIMEOUT_MS se não há
+ *         pendências, já que uma nova infração vence depois disso)
+ */
+static k_timeout_t pending_capture_expire(void)
+{
+    int64_t now = k_uptime_get();
+    int64_t next_deadline = INT64_MAX;
+
+    k_mutex_lock(&pending_lock, K_FOREVER);
+    for (int i = 0; i < MAX_PENDING_CAPTURES; i++) {
+        if (!pending_captures[i].in_use) {
+            continue;
+        }
+        if (pending_captures[i].deadline <= now) {
+            LOG_ERR("Timeout aguardando resultado da camera (requisicao %u)",
+                    pending_captures[i].request_id);
+            pending_captures[i].in_use = false;
+            vehicle_record_unref(pending_captures[i].vehicle);
+            atomic_inc(&radar_stats.camera_timeout);
+        } else if (pending_captures[i].deadline < next_deadline) {
+            next_deadline = pending_captures[i].deadline;
+        }
+    }
+    k_mutex_unlock(&pending_lock);
+
+    if (next_deadline == INT64_MAX) {
+        return K_MSEC(CAPTURE_TIMEOUT_MS);
+    }
+    return K_MSEC(next_deadline - now);
+}
+
+/**
+ * @brief Envia o veículo para o display (sem espera)
+ */
+static void display_vehicle(vehicle_record_t *vehicle)
+{
+    vehicle_record_t *ref = vehicle_record_ref(vehicle);
+
+    if (k_msgq_put(&display_msgq, &ref, K_NO_WAIT) != 0) {
+        LOG_WRN("Fila do display cheia (veiculo %u)", vehicle->seq);
+        atomic_inc(&radar_stats.display_drops);
+        vehicle_record_unref(ref);
+        return;
+    }
+
+    radar_stats_raise(&radar_stats.display_msgq_hwm, k_msgq_num_used_get(&display_msgq));
+}
+
+/**
+ * @brief Envia a infração para o journal em flash (sem espera)
+ */
+static void journal_violation(vehicle_record_t *vehicle)
+{
+    vehicle_record_t *ref = vehicle_record_ref(vehicle);
+
+    if (k_msgq_put(&journal_msgq, &ref, K_NO_WAIT) != 0) {
+        LOG_ERR("Fila do journal cheia - infracao nao persistida");
+        atomic_inc(&radar_stats.journal_drops);
+        vehicle_record_unref(ref);
+    }
+}
+
+/**
+ * @brief Trata o resultado de uma captura e atualiza o display
+ */
+static void process_camera_result(const camera_result_event_t *result)
+{
+    pending_capture_t capture;
+
+    if (!pending_capture_take(result->request_id, &capture)) {
+        LOG_WRN("Resultado da camera sem infracao pendente (requisicao %u)",
+                result->request_id);
+        return;
+    }
+
+    vehicle_record_t *vehicle = capture.vehicle;
+    uint32_t result_cyc = latency_stamp();
+
+    latency_record_cycles(&latency, LATENCY_SPAN_TRIGGER_RESULT, vehicle->trigger_cyc, result_cyc);
+    latency_record_cycles(&latency, LATENCY_SPAN_ISR_RESULT, vehicle->isr_cyc, result_cyc);
+
+    if (result->valid) {
+        atomic_inc(&radar_stats.camera_ok);
+        
+        uint64_t key = plate_pack_key(result->plate);
+        const plate_cache_entry_t *history;
+
+        /* Placa valida: atualiza display e registra */
+        vehicle_record_set_plate(vehicle, result->plate, k_uptime_get_32());
+        display_vehicle(vehicle);
+        
+        store_plate_msg_t update = { .plate_key = key, .store_seq = vehicle->store_seq };
+        
+        if (k_msgq_put(&store_plate_msgq, &update, K_NO_WAIT) != 0) {
+            LOG_WRN("Fila de placas cheia - placa fora do historico (veiculo %u)",
+                    vehicle->seq);
+        }
+
+        switch (plate_cache_record(&recent_plates, key, vehicle->captured_ms,
+                                   vehicle->speed_centi_kmh, &history)) {
+        case PLATE_CACHE_DUPLICATE:
+            /* Mesma passagem capturada de novo: não registra outra infração */
+            LOG_WRN(">>> Captura duplicada - Placa: %s (ja registrada) <<<", result->plate);
+            break;
+        case PLATE_CACHE_REPEAT:
+            LOG_WRN(">>> INFRACAO REGISTRADA - Placa: %s <<<", result->plate);
+            if (history->count >= CONFIG_RADAR_REPEAT_OFFENDER_COUNT) {
+                LOG_WRN(">>> REINCIDENTE - %u infracoes, maxima %u.%02u km/h <<<",
+                        history->count, history->max_speed_centi_kmh / 100,
+                        history->max_speed_centi_kmh % 100);
+            }
+            journal_violation(vehicle);
+            break;
+        default:
+            LOG_WRN(">>> INFRACAO REGISTRADA - Placa: %s <<<", result->plate);
+            journal_violation(vehicle);
+            break;
+        }
+    } else if (strncmp(result->plate, "ERR", 3) == 0) {
+        /* Erro de camera: atualiza display com codigo de erro */
+        atomic_inc(&radar_stats.camera_error);
+        vehicle_record_set_plate(vehicle, result->plate, k_uptime_get_32());
+        display_vehicle(vehicle);
+        LOG_ERR(">>> Falha na camera: %s <<<", result->plate);
+    } else {
+        /* Placa formato invalido: apenas loga, NAO atualiza display */
+        atomic_inc(&radar_stats.camera_invalid);
+        LOG_ERR(">>> INFRACAO NAO REGISTRADA - Placa formato invalido <<<");
+    }
 
-/* Subscriber para resultado da câmera */
-ZBUS_SUBSCRIBER_DEFINE(camera_result_sub, 4);
+    vehicle_record_unref(vehicle);
+}
 
 /**
- * @brief Processa dados do sensor e detecta infrações
+ * @brief Estágio assíncrono de captura
+ *
+ * Recebe os resultados da câmera, casa cada um com a infração pela
+ * request_id (podem chegar fora de ordem) e descarta capturas vencidas.
+ * A thread principal nunca espera pela câmera.
  */
-static void process_vehicle_detection(const sensor_data_msg_t *sensor_data)
+static void capture_result_thread_entry(void *p1, void *p2, void *p3)
 {
-    /* Calcula velocidade */
-    uint32_t speed = calculate_speed_kmh(sensor_data->time_delta_ms, 
-                                          CONFIG_RADAR_SENSOR_DISTANCE_MM);
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    const struct zbus_channel *chan;
+    camera_result_event_t result;
+
+    plate_cache_init(&recent_plates, CONFIG_RADAR_PLATE_CACHE_TTL_S * MSEC_PER_SEC,
+                     CONFIG_RADAR_PLATE_DUPLICATE_WINDOW_MS);
+
+    while (1) {
+        k_timeout_t timeout = pending_capture_expire();
+
+        if (zbus_sub_wait_msg(&camera_result_sub, &chan, &result, timeout) == 0) {
+            process_camera_result(&result);
+        }
+    }
+}
+
+#define CAPTURE_RESULT_THREAD_STACK_SIZE 2048
+#define CAPTURE_RESULT_THREAD_PRIORITY 6
+
+K_THREAD_DEFINE(capture_result_thread, CAPTURE_RESULT_THREAD_STACK_SIZE,
+                capture_result_thread_entry, NULL, NULL, NULL,
+                CAPTURE_RESULT_THREAD_PRIORITY, 0, 0);
+
+/* Sequência de veículos enviada ao display (apenas a thread principal escreve) */
+static uint32_t next_vehicle_seq = 1;
+
+/**
+ * @brief Calcula velocidade e status do veículo e detecta infrações
+ *
+ * Os campos calculados são preenchidos antes do primeiro envio do
+ * registro a outro estágio. A configuração vem do snapshot publicado,
+ * lido uma vez por veículo e sem trava.
+ */
+static void process_vehicle_detection(vehicle_record_t *vehicle)
+{
+    const radar_config_t *cfg = radar_config_get(&radar_config);
+    
+    /* Calcula velocidade (centésimos de km/h) */
+    vehicle->speed_centi_kmh = calculate_speed_centi_kmh_fast(vehicle->time_delta_us,
+                                                              cfg->sensor_distance_mm);
+    
+    /* Classifica pelos espaçamentos entre eixos, já em mm */
+    uint16_t spacing_mm[VEHICLE_MAX_AXLES - 1];
+    
+    axle_spacings_mm(vehicle->axle_gap_us, vehicle->axle_count, vehicle->speed_centi_kmh,
+                     spacing_mm);
+    vehicle->vehicle_class = classify_axles(spacing_mm, vehicle->axle_count);
+    vehicle->vehicle_type = vehicle_class_type(vehicle->vehicle_class, vehicle->axle_count);
+    radar_stats_class(&radar_stats, vehicle->vehicle_class);
+    LOG_DBG("Faixa %u: %u eixos, classe %s", vehicle->lane_id, vehicle->axle_count,
+            vehicle_class_name(vehicle->vehicle_class));
     
     /* Determina limite aplicavel */
-    uint32_t limit = get_speed_limit(sensor_data->vehicle_type,
-                                      CONFIG_RADAR_SPEED_LIMIT_LIGHT_KMH,
-                                      CONFIG_RADAR_SPEED_LIMIT_HEAVY_KMH);
+    vehicle->speed_limit = get_speed_limit(vehicle->vehicle_type,
+                                           cfg->speed_limit_light_kmh,
+                                           cfg->speed_limit_heavy_kmh);
     
     /* Determina status */
-    speed_status_t status = determine_speed_status(speed, limit, 
-                                                     CONFIG_RADAR_WARNING_THRESHOLD_PERCENT);
-    
-    /* Envia para display */
-    display_data_msg_t display_msg = {
-        .speed_kmh = speed,
-        .vehicle_type = sensor_data->vehicle_type,
-        .status = status,
-        .speed_limit = limit,
-        .plate = {0}  /* Inicializa vazio */
-    };
+    vehicle->status = determine_speed_status_centi(vehicle->speed_centi_kmh,
+                                                   vehicle->speed_limit,
+                                                   cfg->warning_threshold_percent);
+    vehicle->seq = next_vehicle_seq++;
+    
+    /* Registra a detecção (O(1), sem alocação) */
+    vehicle->store_seq = detection_store_append(&detections, k_uptime_get_32(),
+                                                vehicle->speed_centi_kmh,
+                                                vehicle->speed_limit,
+                                                vehicle->vehicle_type,
+                                                vehicle->lane_id);
+    
+    /*
+     * Agrega volume, classes, velocidades e headway da faixa. A faixa
+     * sempre cabe: sensor_thread.c verifica NUM_LANES na compilação.
+     */
+    (void)traffic_stats_record(&traffic, vehicle->lane_id, k_uptime_get(),
+                               vehicle->vehicle_type, vehicle->speed_centi_kmh,
+                               vehicle->status == SPEED_STATUS_VIOLATION);
+    
+    radar_stats_detection(&radar_stats, vehicle->vehicle_type, vehicle->lane_id,
+                          vehicle->status == SPEED_STATUS_VIOLATION);
     
-    k_msgq_put(&display_msgq, &display_msg, K_NO_WAIT);
+    vehicle->compute_cyc = latency_stamp();
+    latency_record_cycles(&latency, LATENCY_SPAN_DEQUEUE_COMPUTE,
+                          vehicle->dequeue_cyc, vehicle->compute_cyc);
     
-    /* Pequeno delay para display processar primeiro */
-    k_msleep(50);
+    /* A ordem no display é garantida pela fila e pelo seq, sem delays */
+    display_vehicle(vehicle);
     
-    /* Se infracao, aciona camera */
-    if (status == SPEED_STATUS_VIOLATION) {
-        LOG_WRN("*** INFRACAO DETECTADA! Acionando camera... ***");
+    /* Se infracao, aciona camera sem aguardar o resultado */
+    if (vehicle->status == SPEED_STATUS_VIOLATION) {
+        LOG_WRN("*** INFRACAO DETECTADA (faixa %u)! Acionando camera... ***",
+                vehicle->lane_id);
+        
+        uint32_t request_id = pending_capture_add(vehicle);
+        if (request_id == 0) {
+            LOG_ERR("Capturas pendentes esgotadas - infracao descartada");
+            atomic_inc(&radar_stats.capture_drops);
+            return;
+        }
         
         camera_trigger_event_t trigger = {
-            .speed_kmh = speed,
-            .vehicle_type = sensor_data->vehicle_type
+            .request_id = request_id,
+            .vehicle = vehicle_record_ref(vehicle)
         };
         
-        /* Subscreve ao canal de resultado antes de publicar trigger */
-        zbus_chan_add_obs(&camera_result_chan, &camera_result_sub, K_NO_WAIT);
-        
-        /* Publica evento de trigger */
-        if (zbus_chan_pub(&camera_trigger_chan, &trigger, K_MSEC(100)) == 0) {
-            /* Aguarda resultado da camera (com timeout) */
-            const struct zbus_channel *chan;
+        /* Publica evento de trigger; o resultado chega ao estagio de captura */
+        if (zbus_chan_pub(&camera_trigger_chan, &trigger, K_MSEC(100)) != 0) {
+            pending_capture_t discarded;
             
-            if (zbus_sub_wait(&camera_result_sub, &chan, K_SECONDS(2)) == 0) {
-                camera_result_event_t result;
-                
-                if (zbus_chan_read(chan, &result, K_MSEC(100)) == 0) {
-                    if (result.valid) {
-                        /* Placa valida: atualiza display e registra */
-                        strncpy(display_msg.plate, result.plate, sizeof(display_msg.plate) - 1);
-                        k_msgq_put(&display_msgq, &display_msg, K_NO_WAIT);
-                        k_msleep(50);
-                        LOG_WRN(">>> INFRACAO REGISTRADA - Placa: %s <<<", result.plate);
-                    } else if (strncmp(result.plate, "ERR", 3) == 0) {
-                        /* Erro de camera: atualiza display com codigo de erro */
-                        strncpy(display_msg.plate, result.plate, sizeof(display_msg.plate) - 1);
-                        k_msgq_put(&display_msgq, &display_msg, K_NO_WAIT);
-                        k_msleep(50);
-                        LOG_ERR(">>> Falha na camera: %s <<<", result.plate);
-                    } else {
-                        /* Placa formato invalido: apenas loga, NAO atualiza display */
-                        LOG_ERR(">>> INFRACAO NAO REGISTRADA - Placa formato invalido <<<");
-                    }
-                }
-            } else {
-                LOG_ERR("Timeout aguardando resultado da camera");
+            LOG_ERR("Falha ao acionar camera (requisicao %u)", request_id);
+            atomic_inc(&radar_stats.capture_drops);
+            vehicle_record_unref(trigger.vehicle);
+            if (pending_capture_take(request_id, &discarded)) {
+                vehicle_record_unref(discarded.vehicle);
             }
         }
     }
 }
 
+#if CONFIG_RADAR_LATENCY_LOG_INTERVAL_S > 0
+/**
+ * @brief Registra no log p50/p99/máximo de cada transição com amostras
+ */
+static void latency_log_handler(struct k_work *work)
+{
+    latency_summary_t s;
+
+    for (int i = 0; i < LATENCY_SPAN_COUNT; i++) {
+        latency_hist_summary(&latency.span[i], &s);
+        if (s.count == 0) {
+            continue;
+        }
+        LOG_INF("Latencia %-17s n=%u p50=%u us p99=%u us max=%u us",
+                latency_span_name(i), s.count, s.p50_us, s.p99_us, s.max_us);
+    }
+
+    k_work_reschedule(k_work_delayable_from_work(work),
+                      K_SECONDS(CONFIG_RADAR_LATENCY_LOG_INTERVAL_S));
+}
+
+K_WORK_DELAYABLE_DEFINE(latency_log_work, latency_log_handler);
+#endif
+
 int main(void)
 {
-    sensor_data_msg_t sensor_msg;
+    vehicle_record_t *vehicle;
     
     LOG_INF("+========================================+");
     LOG_INF("|   RADAR ELETRONICO - INICIALIZANDO    |");
     LOG_INF("+========================================+");
     
+    /* Limites e geometria: valores gravados, ou os do Kconfig */
+    radar_settings_init();
+    
     LOG_INF("Configuracoes:");
-    LOG_INF("  - Distancia entre sensores: %d mm", CONFIG_RADAR_SENSOR_DISTANCE_MM);
-    LOG_INF("  - Limite veiculos leves: %d km/h", CONFIG_RADAR_SPEED_LIMIT_LIGHT_KMH);
-    LOG_INF("  - Limite veiculos pesados: %d km/h", CONFIG_RADAR_SPEED_LIMIT_HEAVY_KMH);
-    LOG_INF("  - Limiar de alerta: %d%%", CONFIG_RADAR_WARNING_THRESHOLD_PERCENT);
     LOG_INF("  - Taxa de falha da camera: %d%%", CONFIG_RADAR_CAMERA_FAILURE_RATE_PERCENT);
     
+    detection_store_init(&detections);
+    traffic_stats_init(&traffic);
+    latency_stats_reset(&latency);
+    
+#if CONFIG_RADAR_LATENCY_LOG_INTERVAL_S > 0
+    k_work_schedule(&latency_log_work, K_SECONDS(CONFIG_RADAR_LATENCY_LOG_INTERVAL_S));
+#endif
+    
     LOG_INF("\nSistema operacional - aguardando deteccoes...\n");
     
+    /* Veículos do sensor e placas do estágio de captura */
+    struct k_poll_event events[] = {
+        K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_MSGQ_DATA_AVAILABLE,
+                                 K_POLL_MODE_NOTIFY_ONLY, &sensor_msgq),
+        K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_MSGQ_DATA_AVAILABLE,
+                                 K_POLL_MODE_NOTIFY_ONLY, &store_plate_msgq),
+    };
+    store_plate_msg_t update;
+    
     /* Loop principal */
     while (1) {
-        /* Aguarda dados dos sensores */
-        if (k_msgq_get(&sensor_msgq, &sensor_msg, K_FOREVER) == 0) {
-            process_vehicle_detection(&sensor_msg);
+        k_poll(events, ARRAY_SIZE(events), K_FOREVER);
+        
+        /* Placas primeiro: o registro pode estar prestes a ser reciclado */
+        while (k_msgq_get(&store_plate_msgq, &update, K_NO_WAIT) == 0) {
+            detection_store_set_plate(&detections, update.store_seq, update.plate_key);
+        }
+        
+        /* Dados dos sensores */
+        if (k_msgq_get(&sensor_msgq, &vehicle, K_NO_WAIT) == 0) {
+            vehicle->dequeue_cyc = latency_stamp();
+            latency_record_cycles(&latency, LATENCY_SPAN_ISR_DEQUEUE,
+                                  vehicle->isr_cyc, vehicle->dequeue_cyc);
+            process_vehicle_detection(vehicle);
+            vehicle_record_unref(vehicle);
+        }
+        
+        for (size_t i = 0; i < ARRAY_SIZE(events); i++) {
+            events[i].state = K_POLL_STATE_NOT_READY;
         }
     }
 
@@ -0,0 +1,147 @@
+/**
+ * @file radar_settings.c
+ * @brief Persistência e atualização da configuração em tempo de execução
+ *
+ * Os valores gravados ("radar/distance_mm", "radar/limit_light",
+ * "radar/limit_heavy", "radar/warning_pct") são lidos uma vez no boot e
+ * a cada alteração; o caminho de detecção só lê o snapshot publicado.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/settings/settings.h>
+#include <stdio.h>
+#include "radar_settings.h"
+
+LOG_MODULE_REGISTER(radar_settings, LOG_LEVEL_INF);
+
+struct radar_config_store radar_config = RADAR_CONFIG_STORE_INITIALIZER(radar_config);
+
+/* Serializa os escritores do snapshot (shell e carregamento) */
+K_MUTEX_DEFINE(config_lock);
+
+/**
+ * @brief Registra no log o snapshot publicado
+ */
+static void log_config(const radar_config_t *cfg)
+{
+    LOG_INF("Configuracao v%u: distancia %u mm, limites %u/%u km/h, alerta %u%%",
+            cfg->version, cfg->sensor_distance_mm, cfg->speed_limit_light_kmh,
+            cfg->speed_limit_heavy_kmh, cfg->warning_threshold_percent);
+}
+
+#ifdef CONFIG_SETTINGS
+/* Valores lidos durante settings_load (publicados no commit) */
+static radar_config_t staged;
+
+static int radar_settings_load_value(const char *key, size_t len, settings_read_cb read_cb,
+                                     void *cb_arg)
+{
+    uint32_t *field = radar_config_field(&staged, key);
+    uint32_t value;
+    ssize_t rc;
+
+    if (field == NULL) {
+        return -ENOENT;
+    }
+    if (len != sizeof(value)) {
+        return -EINVAL;
+    }
+
+    rc = read_cb(cb_arg, &value, sizeof(value));
+    if (rc < 0) {
+        return (int)rc;
+    }
+
+    *field = value;
+    return 0;
+}
+
+static int radar_settings_commit(void)
+{
+    const radar_config_t *published;
+
+    k_mutex_lock(&config_lock, K_FOREVER);
+    published = radar_config_publish(&radar_config, &staged);
+    if (published == NULL) {
+        /* Valores gravados fora da faixa: mantém o snapshot atual */
+        LOG_WRN("Configuracao gravada invalida - mantendo v%u",
+                radar_config_get(&radar_config)->version);
+        staged = *radar_config_get(&radar_config);
+    }
+    k_mutex_unlock(&config_lock);
+
+    if (published != NULL) {
+        log_config(published);
+    }
+    return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(radar, "radar", NULL, radar_settings_load_value,
+                               radar_settings_commit, NULL);
+#endif /* CONFIG_SETTINGS */
+
+int radar_settings_init(void)
+{
+#ifdef CONFIG_SETTINGS
+    int ret;
+
+    k_mutex_lock(&config_lock, K_FOREVER);
+    staged = *radar_config_get(&radar_config);
+    k_mutex_unlock(&config_lock);
+
+    ret = settings_subsys_init();
+    if (ret != 0) {
+        LOG_ERR("Falha ao iniciar settings (erro %d) - usando Kconfig", ret);
+        log_config(radar_config_get(&radar_config));
+        return ret;
+    }
+
+    return settings_load_subtree("radar");
+#else
+    log_config(radar_config_get(&radar_config));
+    return 0;
+#endif
+}
+
+int radar_settings_set(const char *key, uint32_t value)
+{
+    radar_config_t next;
+    const radar_config_t *published;
+    uint32_t *field;
+
+    k_mutex_lock(&config_lock, K_FOREVER);
+
+    next = *radar_config_get(&radar_config);
+    field = radar_config_field(&next, key);
+    if (field == NULL) {
+        k_mutex_unlock(&config_lock);
+        return -ENOENT;
+    }
+
+    *field = value;
+    published = radar_config_publish(&radar_config, &next);
+
+#ifdef CONFIG_SETTINGS
+    if (published != NULL) {
+        staged = *published;
+    }
+#endif
+
+    k_mutex_unlock(&config_lock);
+
+    if (published == NULL) {
+        return -EINVAL;
+    }
+
+    log_config(published);
+
+#ifdef CONFIG_SETTINGS
+    char name[32];
+
+    snprintf(name, sizeof(name), "radar/%s", key);
+    return settings_save_one(name, &value, sizeof(value));
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,36 @@
+/**
+ * @file radar_settings.h
+ * @brief Configuração em tempo de execução persistida via settings
+ *
+ * O snapshot publicado (radar_config.h) é lido sem trava pelo caminho de
+ * detecção; as atualizações passam por aqui, que valida, publica e
+ * grava cada campo como "radar/<chave>".
+ */
+
+#ifndef RADAR_SETTINGS_H
+#define RADAR_SETTINGS_H
+
+#include <stdint.h>
+#include "utils/radar_config.h"
+
+/** Snapshot publicado (radar_settings.c) */
+extern struct radar_config_store radar_config;
+
+/**
+ * @brief Carrega os valores gravados e publica o snapshot resultante
+ *
+ * Sem valores gravados (ou sem CONFIG_SETTINGS), permanecem os do Kconfig.
+ *
+ * @return 0 ou erro do subsistema de settings
+ */
+int radar_settings_init(void);
+
+/**
+ * @brief Altera um campo, publica o novo snapshot e grava o valor
+ *
+ * @return 0, -ENOENT (chave desconhecida), -EINVAL (valor fora da faixa)
+ *         ou erro ao gravar (o snapshot já foi publicado)
+ */
+int radar_settings_set(const char *key, uint32_t value);
+
+#endif /* RADAR_SETTINGS_H */
@@ -0,0 +1,247 @@
+/**
+ * @file radar_shell.c
+ * @brief Comandos de shell para inspeção do radar em tempo de execução
+ *
+ * radar stats    - detecções por classe, infrações, câmera e descartes
+ * radar queues   - ocupação atual e máxima das filas
+ * radar lanes    - detecções e infrações por faixa
+ * radar classes  - detecções por classe de eixos
+ * radar plates   - placas capturadas das detecções mais recentes
+ * radar latency  - p50/p99/máximo de cada transição do pipeline
+ * radar reset    - zera contadores, níveis máximos e histogramas
+ * radar config   - mostra ou altera limites e geometria (persistidos)
+ *
+ * Os comandos de leitura apenas leem contadores atômicos (radar_stats.h
+ * e latency_hist.h), o armazenamento de detecções (detection_store.h) e
+ * o snapshot publicado da configuração: nenhuma trava do caminho de
+ * detecção é tomada.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/shell/shell.h>
+#include <stdlib.h>
+#include "types.h"
+#include "utils/radar_stats.h"
+#include "utils/latency_hist.h"
+#include "utils/axle_class.h"
+#include "utils/detection_store.h"
+#include "utils/plate_validator.h"
+#include "radar_settings.h"
+
+/* Faixas realmente monitoradas (mesma contagem do sensor_thread.c) */
+#if DT_HAS_COMPAT_STATUS_OKAY(radar_sensor_pair)
+#define SHELL_NUM_LANES DT_NUM_INST_STATUS_OKAY(radar_sensor_pair)
+#else
+#define SHELL_NUM_LANES 1
+#endif
+
+/* Definidos no main.c */
+extern struct radar_stats radar_stats;
+extern struct latency_stats latency;
+extern struct k_msgq sensor_msgq;
+extern struct k_msgq display_msgq;
+extern struct k_msgq journal_msgq;
+extern struct k_mem_slab vehicle_pool;
+extern struct detection_store detections;
+
+/** Placas listadas por "radar plates" */
+#define SHELL_RECENT_PLATES 10
+
+#define STAT(name) ((uint32_t)atomic_get(&radar_stats.name))
+
+static int cmd_radar_stats(const struct shell *sh, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    shell_print(sh, "Deteccoes:   %u (leves %u, pesados %u)",
+                radar_stats_total_detections(&radar_stats),
+                STAT(detections[VEHICLE_TYPE_LIGHT]), STAT(detections[VEHICLE_TYPE_HEAVY]));
+    shell_print(sh, "Infracoes:   %u", STAT(violations));
+    shell_print(sh, "Camera:      %u ok, %u erro, %u invalida, %u timeout",
+                STAT(camera_ok), STAT(camera_error), STAT(camera_invalid),
+                STAT(camera_timeout));
+    shell_print(sh, "Descartes:   bordas %u, faixa %u, pool %u, sensor %u, captura %u, "
+                "display %u, journal %u", STAT(edge_drops), STAT(tracker_drops),
+                STAT(pool_drops), STAT(sensor_drops), STAT(capture_drops),
+                STAT(display_drops), STAT(journal_drops));
+    shell_print(sh, "Pool:        %u/%u registros em uso",
+                k_mem_slab_num_used_get(&vehicle_pool),
+                k_mem_slab_num_used_get(&vehicle_pool) +
+                k_mem_slab_num_free_get(&vehicle_pool));
+    return 0;
+}
+
+/**
+ * @brief Imprime ocupação, capacidade e nível máximo de uma fila
+ */
+static void print_queue(const struct shell *sh, const char *name, struct k_msgq *msgq,
+                        const atomic_t *hwm)
+{
+    struct k_msgq_attrs attrs;
+
+    k_msgq_get_attrs(msgq, &attrs);
+
+    if (hwm != NULL) {
+        shell_print(sh, "%-13s %2u/%-2u (maximo %u)", name, attrs.used_msgs,
+                    attrs.max_msgs, (uint32_t)atomic_get(hwm));
+    } else {
+        shell_print(sh, "%-13s %2u/%-2u", name, attrs.used_msgs, attrs.max_msgs);
+    }
+}
+
+static int cmd_radar_queues(const struct shell *sh, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    print_queue(sh, "sensor_msgq", &sensor_msgq, &radar_stats.sensor_msgq_hwm);
+    print_queue(sh, "display_msgq", &display_msgq, &radar_stats.display_msgq_hwm);
+    print_queue(sh, "journal_msgq", &journal_msgq, NULL);
+    return 0;
+}
+
+static int cmd_radar_lanes(const struct shell *sh, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    for (int i = 0; i < SHELL_NUM_LANES; i++) {
+        shell_print(sh, "Faixa %d: %u deteccoes, %u infracoes", i,
+                    (uint32_t)atomic_get(&radar_stats.lanes[i].detections),
+                    (uint32_t)atomic_get(&radar_stats.lanes[i].violations));
+    }
+    return 0;
+}
+
+static int cmd_radar_classes(const struct shell *sh, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    for (int i = 0; i < VEHICLE_CLASS_COUNT; i++) {
+        shell_print(sh, "%-13s %u", vehicle_class_name(i), STAT(classes[i]));
+    }
+    return 0;
+}
+
+static int cmd_radar_plates(const struct shell *sh, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    uint32_t head = (uint32_t)atomic_get(&detections.head);
+    char plate[PLATE_MAX_LEN + 1];
+    int shown = 0;
+
+    for (uint32_t n = 0; n < DETECTION_STORE_CAPACITY && head - n != DETECTION_SEQ_INVALID &&
+                         shown < SHELL_RECENT_PLATES; n++) {
+        uint64_t key;
+
+        /* Registro sobrescrito ou em escrita: pula (a leitura não trava) */
+        if (!detection_store_get_plate(&detections, head - n, &key) || key == 0) {
+            continue;
+        }
+
+        plate_unpack_key(key, plate);
+        shell_print(sh, "#%u %s", head - n, plate);
+        shown++;
+    }
+
+    if (shown == 0) {
+        shell_print(sh, "Nenhuma placa recente");
+    }
+    return 0;
+}
+
+static int cmd_radar_latency(const struct shell *sh, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    latency_summary_t s;
+
+    shell_print(sh, "%-17s %8s %10s %10s %10s", "transicao", "n", "p50 (us)", "p99 (us)",
+                "max (us)");
+    for (int i = 0; i < LATENCY_SPAN_COUNT; i++) {
+        latency_hist_summary(&latency.span[i], &s);
+        shell_print(sh, "%-17s %8u %10u %10u %10u", latency_span_name(i), s.count,
+                    s.p50_us, s.p99_us, s.max_us);
+    }
+    return 0;
+}
+
+static int cmd_radar_reset(const struct shell *sh, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    radar_stats_reset(&radar_stats);
+    latency_stats_reset(&latency);
+    shell_print(sh, "Contadores, niveis maximos e latencias zerados");
+    return 0;
+}
+
+static int cmd_radar_config(const struct shell *sh, size_t argc, char **argv)
+{
+    if (argc == 1) {
+        radar_config_t cfg = *radar_config_get(&radar_config);
+
+        shell_print(sh, "Versao %u", cfg.version);
+        for (int i = 0; i < RADAR_CONFIG_KEY_COUNT; i++) {
+            shell_print(sh, "  %-12s %u", radar_config_key(i),
+                        *radar_config_field(&cfg, radar_config_key(i)));
+        }
+        return 0;
+    }
+
+    if (argc != 3) {
+        shell_error(sh, "Uso: radar config [<chave> <valor>]");
+        return -EINVAL;
+    }
+
+    char *end;
+    unsigned long value = strtoul(argv[2], &end, 10);
+
+    if (end == argv[2] || *end != '\0' || value > UINT32_MAX) {
+        shell_error(sh, "Valor invalido: %s", argv[2]);
+        return -EINVAL;
+    }
+
+    int ret = radar_settings_set(argv[1], (uint32_t)value);
+
+    switch (ret) {
+    case 0:
+        shell_print(sh, "%s = %lu (versao %u)", argv[1], value,
+                    radar_config_get(&radar_config)->version);
+        break;
+    case -ENOENT:
+        shell_error(sh, "Chave desconhecida: %s", argv[1]);
+        break;
+    case -EINVAL:
+        shell_error(sh, "Valor fora da faixa: %s = %lu", argv[1], value);
+        break;
+    default:
+        shell_warn(sh, "Aplicado, mas nao gravado (erro %d)", ret);
+        break;
+    }
+    return ret;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(radar_cmds,
+    SHELL_CMD(stats, NULL, "Deteccoes, infracoes, camera e descartes", cmd_radar_stats),
+    SHELL_CMD(queues, NULL, "Ocupacao atual e maxima das filas", cmd_radar_queues),
+    SHELL_CMD(lanes, NULL, "Deteccoes e infracoes por faixa", cmd_radar_lanes),
+    SHELL_CMD(classes, NULL, "Deteccoes por classe de eixos", cmd_radar_classes),
+    SHELL_CMD(plates, NULL, "Placas das deteccoes mais recentes", cmd_radar_plates),
+    SHELL_CMD(latency, NULL, "p50/p99/max de cada transicao do pipeline", cmd_radar_latency),
+    SHELL_CMD(reset, NULL, "Zera contadores, niveis maximos e latencias", cmd_radar_reset),
+    SHELL_CMD_ARG(config, NULL,
+                  "Mostra a configuracao, ou altera uma chave: radar config <chave> <valor>\n"
+                  "Chaves: distance_mm, limit_light, limit_heavy, warning_pct",
+                  cmd_radar_config, 1, 2),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(radar, &radar_cmds, "Estatisticas do radar em tempo de execucao", NULL);
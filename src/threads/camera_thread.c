@@ -16,6 +16,9 @@
 #include "camera_service.h"
 #include "../types.h"
 #include "../utils/plate_validator.h"
+#include "../utils/vehicle_pool.h"
+#include "../utils/latency_hist.h"
+#include "../utils/capture_inflight.h"
 
 LOG_MODULE_REGISTER(camera_thread, LOG_LEVEL_INF);
 
@@ -25,6 +28,69 @@ ZBUS_CHAN_DECLARE(camera_result_chan);
 
 /* Canal do camera_service (externo) */
 ZBUS_CHAN_DECLARE(chan_camera_evt);
+BUILD_ASSERT(sizeof(struct msg_camera_evt) <= CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_STATIC_DATA_SIZE);
+
+/* Histogramas de latência (main.c) */
+extern struct latency_stats latency;
+
+/* Requisições em andamento (push na integração, pop no processador de eventos) */
+static struct capture_inflight inflight;
+static struct k_spinlock inflight_lock;
+
+/**
+ * @brief Enfileira a requisição antes de acionar o camera_service
+ */
+static bool inflight_push(uint32_t request_id)
+{
+    k_spinlock_key_t key = k_spin_lock(&inflight_lock);
+    bool ok = capture_inflight_push(&inflight, request_id,
+                                    k_uptime_get() + CAPTURE_TIMEOUT_MS);
+
+    k_spin_unlock(&inflight_lock, key);
+    return ok;
+}
+
+/**
+ * @brief Desfaz o último push (captura não foi aceita pelo camera_service)
+ */
+static void inflight_drop_last(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&inflight_lock);
+
+    capture_inflight_drop_last(&inflight);
+    k_spin_unlock(&inflight_lock, key);
+}
+
+/**
+ * @brief Casa o evento recebido com a requisição mais antiga em andamento
+ *
+ * @param expired Saída: requisições vencidas descartadas (evento atrasado)
+ * @return Identificador da requisição, ou 0 se o evento deve ser descartado
+ */
+static uint32_t inflight_pop(uint32_t *expired)
+{
+    int64_t now = k_uptime_get();
+    k_spinlock_key_t key = k_spin_lock(&inflight_lock);
+    uint32_t request_id = capture_inflight_pop(&inflight, now, expired);
+
+    k_spin_unlock(&inflight_lock, key);
+    return request_id;
+}
+
+/**
+ * @brief Publica resultado de erro para uma requisição
+ */
+static void publish_capture_error(uint32_t request_id)
+{
+    camera_result_event_t result = {0};
+
+    result.request_id = request_id;
+    result.valid = false;
+    result.timestamp = k_uptime_get();
+    snprintf(result.plate, sizeof(result.plate), "ERROR");
+
+    zbus_chan_pub(&camera_result_chan, &result, K_MSEC(100));
+}
 
 /**
  * @brief Processa trigger da câmera usando camera_service
@@ -33,24 +99,35 @@ static void process_camera_capture(const camera_trigger_event_t *trigger)
 {
     int ret;
     
-    LOG_INF("=== CAPTURA INICIADA ===");
-    LOG_INF("Velocidade: %u km/h, Tipo: %s", 
-            trigger->speed_kmh,
-            trigger->vehicle_type == VEHICLE_TYPE_LIGHT ? "LEVE" : "PESADO");
+    vehicle_record_t *vehicle = trigger->vehicle;
+    
+    /* Lido pelo estágio de captura quando o resultado chegar */
+    vehicle->trigger_cyc = latency_stamp();
+    latency_record_cycles(&latency, LATENCY_SPAN_COMPUTE_TRIGGER,
+                          vehicle->compute_cyc, vehicle->trigger_cyc);
+    
+    LOG_INF("=== CAPTURA INICIADA (requisicao %u) ===", trigger->request_id);
+    LOG_INF("Velocidade: %u.%02u km/h, Tipo: %s", 
+            vehicle->speed_centi_kmh / 100, vehicle->speed_centi_kmh % 100,
+            vehicle->vehicle_type == VEHICLE_TYPE_LIGHT ? "LEVE" : "PESADO");
+    
+    /* Registra antes de acionar: o evento pode chegar antes do retorno */
+    if (!inflight_push(trigger->request_id)) {
+        LOG_ERR("Capturas em andamento esgotadas (requisicao %u)", trigger->request_id);
+        publish_capture_error(trigger->request_id);
+        return;
+    }
     
-    /* Chama API do camera_service para iniciar captura */
-    ret = camera_api_capture(K_SECONDS(5));
+    /* Mesmo prazo da entrada em andamento: depois dele o evento é descartado */
+    ret = camera_api_capture(K_MSEC(CAPTURE_TIMEOUT_MS));
     if (ret != 0) {
         /* Falha ao iniciar captura */
-        camera_result_event_t result = {0};
-        result.valid = false;
-        result.timestamp = k_uptime_get();
-        snprintf(result.plate, sizeof(result.plate), "ERROR");
+        inflight_drop_last();
         
         LOG_ERR("Falha ao iniciar captura (erro %d)", ret);
         
         /* Publica resultado de erro */
-        zbus_chan_pub(&camera_result_chan, &result, K_MSEC(100));
+        publish_capture_error(trigger->request_id);
         return;
     }
     
@@ -59,11 +136,18 @@ static void process_camera_capture(const camera_trigger_event_t *trigger)
     /* A resposta virá via chan_camera_evt e será processada no listener */
 }
 
-/* Subscriber do ZBUS para camera_trigger_chan */
-ZBUS_SUBSCRIBER_DEFINE(camera_sub, 4);
+/*
+ * Observadores ligados aos canais em tempo de compilação: nenhum nó de
+ * observador é alocado em tempo de execução.
+ */
+
+/* MSG_SUBSCRIBER para camera_trigger_chan (triggers em sequência não se sobrescrevem) */
+ZBUS_MSG_SUBSCRIBER_DEFINE(camera_sub);
+ZBUS_CHAN_ADD_OBS(camera_trigger_chan, camera_sub, 3);
 
 /* MSG_SUBSCRIBER para eventos do camera_service (bloqueante) */
 ZBUS_MSG_SUBSCRIBER_DEFINE(camera_evt_sub);
+ZBUS_CHAN_ADD_OBS(chan_camera_evt, camera_evt_sub, 3);
 
 /**
  * @brief Processa eventos do camera_service em uma thread dedicada
@@ -80,9 +164,6 @@ static void camera_evt_processor_thread(void *p1, void *p2, void *p3)
     
     LOG_INF("Thread processadora de eventos camera_service iniciada");
     
-    /* Adiciona msg_subscriber ao canal de eventos do camera_service */
-    zbus_chan_add_obs(&chan_camera_evt, &camera_evt_sub, K_NO_WAIT);
-    
     while (1) {
         /* Aguarda eventos do camera_service (bloqueante) */
         if (zbus_sub_wait_msg(&camera_evt_sub, &chan, &evt, K_FOREVER) == 0) {
@@ -90,33 +171,35 @@ static void camera_evt_processor_thread(void *p1, void *p2, void *p3)
             LOG_INF("Tipo: %d", evt.type);
             
             camera_result_event_t result = {0};
+            uint32_t expired;
+            
+            result.request_id = inflight_pop(&expired);
             result.timestamp = k_uptime_get();
             
+            if (expired != 0) {
+                LOG_WRN("%u captura(s) vencida(s); evento atrasado descartado", expired);
+                continue;
+            }
+            
+            if (result.request_id == 0) {
+                LOG_WRN("Evento sem captura em andamento (descartado)");
+                continue;
+            }
+            
             switch (evt.type) {
             case MSG_CAMERA_EVT_TYPE_DATA:
                 /* Captura bem-sucedida */
                 if (evt.captured_data != NULL && evt.captured_data->plate != NULL) {
-                    /* Copia placa */
-                    strncpy(result.plate, evt.captured_data->plate, sizeof(result.plate) - 1);
-                    result.plate[sizeof(result.plate) - 1] = '\0';
-                    
-                    /* Remove espaços (bug do camera_service) */
-                    char clean_plate[8] = {0};
-                    int clean_idx = 0;
-                    for (int i = 0; result.plate[i] != '\0' && clean_idx < 7; i++) {
-                        if (result.plate[i] != ' ') {
-                            clean_plate[clean_idx++] = result.plate[i];
-                        }
-                    }
-                    clean_plate[clean_idx] = '\0';
+                    /* Copia placa removendo espaços (bug do camera_service) */
+                    size_t clean_len = plate_strip_spaces(result.plate, sizeof(result.plate),
+                                                          evt.captured_data->plate);
                     
-                    LOG_INF("Placa recebida: '%s' -> limpa: '%s'", result.plate, clean_plate);
+                    LOG_INF("Placa recebida: '%s' -> limpa: '%s'",
+                            evt.captured_data->plate, result.plate);
                     
-                    /* Copia placa limpa de volta */
-                    strncpy(result.plate, clean_plate, sizeof(result.plate));
-                    
-                    /* Valida placa Mercosul */
-                    result.valid = validate_mercosul_plate(result.plate, &country);
+                    /* Valida placa Mercosul (placa truncada nunca é válida) */
+                    result.valid = (clean_len < sizeof(result.plate)) &&
+                                   validate_mercosul_plate(result.plate, &country);
                     
                     if (result.valid) {
                         LOG_INF("Placa capturada: %s (%s)", 
@@ -168,24 +251,18 @@ void camera_integration_thread_entry(void *p1, void *p2, void *p3)
     
     LOG_INF("Thread de integração camera iniciada");
     
-    /* Adiciona subscriber ao canal de trigger interno */
-    zbus_chan_add_obs(&camera_trigger_chan, &camera_sub, K_NO_WAIT);
-    
     LOG_INF("Aguardando triggers de captura...");
     
     /* Loop principal - aguarda triggers */
     while (1) {
         const struct zbus_channel *chan;
+        camera_trigger_event_t trigger;
         
         /* Aguarda mensagens no ZBUS */
-        if (zbus_sub_wait(&camera_sub, &chan, K_FOREVER) == 0) {
-            camera_trigger_event_t trigger;
-            
-            if (zbus_chan_read(chan, &trigger, K_MSEC(100)) == 0) {
-                process_camera_capture(&trigger);
-            } else {
-                LOG_ERR("Falha ao ler dados do canal de trigger");
-            }
+        if (zbus_sub_wait_msg(&camera_sub, &chan, &trigger, K_FOREVER) == 0) {
+            process_camera_capture(&trigger);
+            /* O resultado é casado pela request_id; o veículo não é mais usado aqui */
+            vehicle_record_unref(trigger.vehicle);
         }
     }
 }
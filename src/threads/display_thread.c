@@ -3,7 +3,19 @@
  * @brief Thread de atualização do display
  * 
  * Recebe dados da thread principal e exibe no Display Dummy
- * com formatação de cores ANSI (verde/amarelo/vermelho)
+ * com formatação de cores ANSI (verde/amarelo/vermelho).
+ *
+ * Com CONFIG_RADAR_DISPLAY_INCREMENTAL, o quadro fica fixo no topo do
+ * console e só os campos alterados são reescritos; sem ele, cada
+ * atualização imprime o quadro inteiro.
+ *
+ * Se o devicetree escolhe um display (chosen zephyr,display), o painel
+ * também é desenhado em framebuffer e só os retângulos alterados são
+ * enviados ao driver pela API de display do Zephyr.
+ *
+ * A fila é drenada a cada passagem e as mensagens são fundidas por
+ * faixa (display_coalesce.h): só o veículo mais recente é desenhado, no
+ * máximo uma vez a cada CONFIG_RADAR_DISPLAY_REFRESH_MS.
  */
 
 #include <zephyr/kernel.h>
@@ -12,131 +24,171 @@
 #include <zephyr/logging/log.h>
 #include <stdio.h>
 #include "../types.h"
+#include "../utils/display_format.h"
+#include "../utils/display_render.h"
+#include "../utils/display_coalesce.h"
+#include "../utils/vehicle_pool.h"
+#include "../utils/sign_render.h"
+#include "../utils/latency_hist.h"
 
 LOG_MODULE_REGISTER(display_thread, LOG_LEVEL_INF);
 
-/* Códigos de cores ANSI para o console */
-#define ANSI_COLOR_GREEN   "\x1b[32m"
-#define ANSI_COLOR_YELLOW  "\x1b[33m"
-#define ANSI_COLOR_RED     "\x1b[31m"
-#define ANSI_COLOR_RESET   "\x1b[0m"
-#define ANSI_BOLD          "\x1b[1m"
-
 /* Fila de mensagens do display */
 extern struct k_msgq display_msgq;
 
+/* Histogramas de latência (main.c) */
+extern struct latency_stats latency;
+
+#ifdef CONFIG_RADAR_DISPLAY_INCREMENTAL
+/* Conteúdo atual do quadro fixo */
+static struct display_renderer renderer;
+#endif
+
+#if DT_HAS_CHOSEN(zephyr_display)
+#define SIGN_PANEL_AVAILABLE 1
+
+static const struct device *const sign_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+static struct sign_panel panel;
+static bool sign_ready;
+
 /**
- * @brief Retorna o código de cor baseado no status
+ * @brief Prepara o display do painel (RGB565, resolução mínima)
  */
-static const char* get_color_code(speed_status_t status)
+static void sign_init(void)
 {
-    switch (status) {
-    case SPEED_STATUS_NORMAL:
-        return ANSI_COLOR_GREEN;
-    case SPEED_STATUS_WARNING:
-        return ANSI_COLOR_YELLOW;
-    case SPEED_STATUS_VIOLATION:
-        return ANSI_COLOR_RED;
-    default:
-        return ANSI_COLOR_RESET;
+    struct display_capabilities caps;
+
+    if (!device_is_ready(sign_dev)) {
+        LOG_ERR("Display do painel nao esta pronto");
+        return;
     }
-}
 
-/**
- * @brief Retorna o texto do status
- */
-static const char* get_status_text(speed_status_t status)
-{
-    switch (status) {
-    case SPEED_STATUS_NORMAL:
-        return "NORMAL";
-    case SPEED_STATUS_WARNING:
-        return "ALERTA";
-    case SPEED_STATUS_VIOLATION:
-        return "INFRACAO";
-    default:
-        return "DESCONHECIDO";
+    display_get_capabilities(sign_dev, &caps);
+    if (caps.x_resolution < SIGN_WIDTH || caps.y_resolution < SIGN_HEIGHT) {
+        LOG_ERR("Display %ux%u menor que o painel %ux%u", caps.x_resolution,
+                caps.y_resolution, SIGN_WIDTH, SIGN_HEIGHT);
+        return;
     }
+
+    if (caps.current_pixel_format != PIXEL_FORMAT_RGB_565 &&
+        display_set_pixel_format(sign_dev, PIXEL_FORMAT_RGB_565) != 0) {
+        LOG_ERR("Display nao suporta RGB565");
+        return;
+    }
+
+    sign_panel_init(&panel);
+    display_blanking_off(sign_dev);
+    sign_ready = true;
+    LOG_INF("Painel %ux%u em %s", SIGN_WIDTH, SIGN_HEIGHT, sign_dev->name);
 }
 
 /**
- * @brief Retorna o tipo do veículo como texto
+ * @brief Envia ao display apenas as regiões sujas do framebuffer
  */
-static const char* get_vehicle_type_text(vehicle_type_t type)
+static void sign_flush(void)
 {
-    return (type == VEHICLE_TYPE_LIGHT) ? "LEVE" : "PESADO";
+    uint32_t dirty = sign_panel_take_dirty(&panel);
+
+    for (int r = 0; r < SIGN_REGION_COUNT; r++) {
+        if (!(dirty & BIT(r))) {
+            continue;
+        }
+
+        const sign_rect_t *rect = &sign_regions[r];
+        /* Escreve direto do framebuffer: pitch = largura do painel */
+        struct display_buffer_descriptor desc = {
+            .buf_size = SIGN_WIDTH * rect->h * sizeof(uint16_t),
+            .width = rect->w,
+            .height = rect->h,
+            .pitch = SIGN_WIDTH,
+        };
+        int ret = display_write(sign_dev, rect->x, rect->y, &desc,
+                                &panel.fb[rect->y][rect->x]);
+
+        if (ret != 0) {
+            LOG_ERR("Falha ao atualizar regiao %d do painel: %d", r, ret);
+        }
+    }
 }
+#else
+#define SIGN_PANEL_AVAILABLE 0
+#endif
 
 /**
  * @brief Formata e exibe os dados no display
  */
 static void display_data(const display_data_msg_t *data)
 {
-    const char *color = get_color_code(data->status);
-    const char *status_text = get_status_text(data->status);
-    const char *vehicle_text = get_vehicle_type_text(data->vehicle_type);
+#if SIGN_PANEL_AVAILABLE
+    if (sign_ready) {
+        sign_panel_update(&panel, data);
+        sign_flush();
+    }
+#endif
     
-    /* Monta a mensagem formatada */
-    char display_buffer[700];
+
+#ifdef CONFIG_RADAR_DISPLAY_INCREMENTAL
+    char update_buffer[DISPLAY_UPDATE_MAX_LEN];
     
-    /* Se tem placa, mostra quadro com placa; senão, sem placa */
-    if (data->plate[0] != '\0') {
-        /* Verifica se é código de erro */
-        const char *plate_color = ANSI_BOLD;
-        if (strncmp(data->plate, "ERR", 3) == 0) {
-            plate_color = ANSI_COLOR_RED;  /* Erros em vermelho */
-        }
-        
-        /* Monta strings com largura fixa ANTES de adicionar cores */
-        char vel_str[40], status_str[40], limit_str[40];
-        snprintf(vel_str, sizeof(vel_str), "%3u km/h", data->speed_kmh);
-        snprintf(status_str, sizeof(status_str), "%-10s", status_text);
-        snprintf(limit_str, sizeof(limit_str), "%3u km/h", data->speed_limit);
-        
-        snprintf(display_buffer, sizeof(display_buffer),
-                 "\n"
-                 "+========================================+\n"
-                 "|        RADAR ELETRONICO                |\n"
-                 "+========================================+\n"
-                 "| Tipo:       %-27s|\n"
-                 "| Velocidade: %s%s%-27s%s|\n"
-                 "| Limite:     %-27s|\n"
-                 "| Status:     %s%s%-27s%s|\n"
-                 "| Placa:      %s%-27s%s|\n"
-                 "+========================================+\n",
-                 vehicle_text,
-                 ANSI_BOLD, color, vel_str, ANSI_COLOR_RESET,
-                 limit_str,
-                 ANSI_BOLD, color, status_str, ANSI_COLOR_RESET,
-                 plate_color, data->plate, ANSI_COLOR_RESET);
-    } else {
-        /* Monta strings com largura fixa ANTES de adicionar cores */
-        char vel_str[40], status_str[40], limit_str[40];
-        snprintf(vel_str, sizeof(vel_str), "%3u km/h", data->speed_kmh);
-        snprintf(status_str, sizeof(status_str), "%-10s", status_text);
-        snprintf(limit_str, sizeof(limit_str), "%3u km/h", data->speed_limit);
-        
-        snprintf(display_buffer, sizeof(display_buffer),
-                 "\n"
-                 "+========================================+\n"
-                 "|        RADAR ELETRONICO                |\n"
-                 "+========================================+\n"
-                 "| Tipo:       %-27s|\n"
-                 "| Velocidade: %s%s%-27s%s|\n"
-                 "| Limite:     %-27s|\n"
-                 "| Status:     %s%s%-27s%s|\n"
-                 "+========================================+\n",
-                 vehicle_text,
-                 ANSI_BOLD, color, vel_str, ANSI_COLOR_RESET,
-                 limit_str,
-                 ANSI_BOLD, color, status_str, ANSI_COLOR_RESET);
+    /* Apenas os campos alterados, com endereçamento de cursor */
+    if (display_render_update(&renderer, data, update_buffer, sizeof(update_buffer)) > 0) {
+        printk("%s", update_buffer);
     }
+#else
+    char display_buffer[DISPLAY_FRAME_MAX_LEN];
+    
+    format_display_frame(display_buffer, sizeof(display_buffer), data);
     
     /* Exibe no console (Display Dummy mostra via LOG) */
     printk("%s", display_buffer);
-    
-    /* Pequeno delay para separar visualmente do próximo processamento */
-    k_msleep(20);
+#endif
+}
+
+#ifdef CONFIG_RADAR_DISPLAY_REFRESH_MS
+#define DISPLAY_REFRESH_MS CONFIG_RADAR_DISPLAY_REFRESH_MS
+#else
+#define DISPLAY_REFRESH_MS 200
+#endif
+
+/* Último veículo exibido */
+static uint32_t shown_seq;
+
+/* Último estado de cada faixa, ainda não desenhado */
+static struct display_coalescer coalescer;
+
+/**
+ * @brief Aplica uma atualização respeitando a ordem dos veículos
+ *
+ * A atualização de velocidade de um veículo novo abre um quadro; a de
+ * placa do mesmo veículo (mesmo seq) é fundida ao quadro atual. Placas
+ * de um veículo já substituído no display não voltam a ser exibidas.
+ *
+ * A latência até o painel é registrada no primeiro quadro de cada
+ * veículo; o quadro da placa mede a câmera, não o display.
+ */
+static void display_update(const display_data_msg_t *data)
+{
+    /* Comparação com sinal tolera o wrap-around do contador */
+    int32_t age = (int32_t)(shown_seq - data->seq);
+
+    if (shown_seq != 0 && age > 0) {
+        LOG_INF("Atualizacao do veiculo %u ignorada (display no veiculo %u)",
+                data->seq, shown_seq);
+        return;
+    }
+
+    bool new_vehicle = (shown_seq != data->seq);
+
+    shown_seq = data->seq;
+    display_data(data);
+
+    if (new_vehicle) {
+        uint32_t render_cyc = latency_stamp();
+
+        latency_record_cycles(&latency, LATENCY_SPAN_COMPUTE_DISPLAY, data->compute_cyc,
+                              render_cyc);
+        latency_record_cycles(&latency, LATENCY_SPAN_ISR_DISPLAY, data->isr_cyc, render_cyc);
+    }
 }
 
 /**
@@ -148,10 +200,27 @@ void display_thread_entry(void *p1, void *p2, void *p3)
     ARG_UNUSED(p2);
     ARG_UNUSED(p3);
     
+    vehicle_record_t *vehicle;
     display_data_msg_t msg;
+    int64_t next_refresh_ms = 0;
+    uint32_t skipped_logged = 0;
     
     LOG_INF("Thread de display iniciada");
     
+    display_coalescer_init(&coalescer);
+    
+#if SIGN_PANEL_AVAILABLE
+    sign_init();
+#endif
+    
+#ifdef CONFIG_RADAR_DISPLAY_INCREMENTAL
+    /* Quadro fixo no topo; os campos são preenchidos a cada veículo */
+    static char template_buffer[DISPLAY_TEMPLATE_MAX_LEN];
+    
+    display_renderer_init(&renderer);
+    display_render_template(template_buffer, sizeof(template_buffer));
+    printk("%s", template_buffer);
+#else
     /* Mensagem de boas-vindas */
     printk("\n");
     printk("+========================================+\n");
@@ -159,11 +228,38 @@ void display_thread_entry(void *p1, void *p2, void *p3)
     printk("|         Aguardando veiculos...        |\n");
     printk("+========================================+\n");
     printk("\n");
+#endif
     
     while (1) {
-        /* Aguarda mensagem da fila */
-        if (k_msgq_get(&display_msgq, &msg, K_FOREVER) == 0) {
-            display_data(&msg);
+        /* Sem quadro pendente dorme até a próxima mensagem; com quadro
+         * pendente, só até o próximo período de atualização */
+        k_timeout_t wait = K_FOREVER;
+        
+        if (display_coalescer_pending(&coalescer)) {
+            wait = K_MSEC(MAX(next_refresh_ms - k_uptime_get(), 0));
+        }
+        
+        /* Funde tudo o que já está na fila */
+        while (k_msgq_get(&display_msgq, &vehicle, wait) == 0) {
+            vehicle_record_to_display(vehicle, &msg);
+            vehicle_record_unref(vehicle);
+            display_coalescer_offer(&coalescer, &msg);
+            wait = K_NO_WAIT;
+        }
+        
+        int64_t now = k_uptime_get();
+        
+        if (now < next_refresh_ms || !display_coalescer_take(&coalescer, &msg)) {
+            continue;
+        }
+        
+        display_update(&msg);
+        next_refresh_ms = now + DISPLAY_REFRESH_MS;
+        
+        if (coalescer.skipped != skipped_logged) {
+            LOG_DBG("%u quadros pulados (total %u)", coalescer.skipped - skipped_logged,
+                    coalescer.skipped);
+            skipped_logged = coalescer.skipped;
         }
     }
 }
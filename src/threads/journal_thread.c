@@ -0,0 +1,137 @@
+/**
+ * @file journal_thread.c
+ * @brief Thread do journal de infrações em flash
+ *
+ * Recebe as infrações registradas pelo estágio de captura e as grava
+ * em lotes na partição "storage_partition" (NVS). Roda com a menor
+ * prioridade do sistema: apagamentos de setor nunca atrasam a
+ * detecção, que só faz k_msgq_put sem espera.
+ *
+ * Se a gravação de um lote cheio falha, a thread para de drenar a
+ * journal_msgq até conseguir gravá-lo: as infrações seguintes esperam
+ * na fila e, com ela cheia, são contadas em radar_stats.journal_drops,
+ * em vez de sumirem do lote sem registro.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/fs/nvs.h>
+#include <zephyr/logging/log.h>
+#include "../types.h"
+#include "../utils/violation_journal.h"
+#include "../utils/vehicle_pool.h"
+
+LOG_MODULE_REGISTER(journal_thread, LOG_LEVEL_INF);
+
+/* Fila de infrações a gravar */
+extern struct k_msgq journal_msgq;
+
+static struct nvs_fs journal_fs;
+static struct violation_journal journal;
+
+/**
+ * @brief Monta o NVS na partição de storage e recupera o journal
+ */
+static int journal_mount(void)
+{
+    struct flash_pages_info info;
+    int ret;
+
+    journal_fs.flash_device = FIXED_PARTITION_DEVICE(storage_partition);
+    if (!device_is_ready(journal_fs.flash_device)) {
+        LOG_ERR("Flash do journal nao esta pronta");
+        return -ENODEV;
+    }
+
+    journal_fs.offset = FIXED_PARTITION_OFFSET(storage_partition);
+    ret = flash_get_page_info_by_offs(journal_fs.flash_device, journal_fs.offset, &info);
+    if (ret != 0) {
+        LOG_ERR("Erro ao ler pagina da flash: %d", ret);
+        return ret;
+    }
+
+    journal_fs.sector_size = info.size;
+    journal_fs.sector_count = FIXED_PARTITION_SIZE(storage_partition) / info.size;
+
+    ret = nvs_mount(&journal_fs);
+    if (ret != 0) {
+        LOG_ERR("Erro ao montar NVS: %d", ret);
+        return ret;
+    }
+
+    return violation_journal_init(&journal, &journal_fs);
+}
+
+/**
+ * @brief Grava o lote em formação, registrando falhas
+ */
+static void journal_flush(void)
+{
+    uint32_t count = violation_journal_pending(&journal);
+    int ret = violation_journal_flush(&journal);
+
+    if (ret != 0) {
+        LOG_ERR("Falha ao gravar lote do journal: %d (%u infracoes retidas)", ret, count);
+    } else if (count > 0) {
+        LOG_DBG("Lote de %u infracoes gravado", count);
+    }
+}
+
+/**
+ * @brief Thread do journal
+ */
+void journal_thread_entry(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    vehicle_record_t *vehicle;
+    violation_record_t record;
+    int64_t start = k_uptime_get();
+
+    if (journal_mount() != 0) {
+        LOG_ERR("Journal desabilitado - infracoes nao serao persistidas");
+        return;
+    }
+
+    LOG_INF("Journal recuperado em %lld ms (boot %u, %u lotes gravados)",
+            k_uptime_get() - start, journal.header.boot_count,
+            violation_journal_batches(&journal));
+
+    while (1) {
+        /* Lote cheio retido (gravação falhou): só tenta de novo, sem drenar a fila */
+        if (violation_journal_full(&journal)) {
+            k_sleep(K_MSEC(CONFIG_RADAR_JOURNAL_FLUSH_MS));
+            journal_flush();
+            continue;
+        }
+
+        /* Lote parcial é gravado depois de CONFIG_RADAR_JOURNAL_FLUSH_MS sem infrações */
+        k_timeout_t timeout = (violation_journal_pending(&journal) > 0)
+                              ? K_MSEC(CONFIG_RADAR_JOURNAL_FLUSH_MS)
+                              : K_FOREVER;
+
+        if (k_msgq_get(&journal_msgq, &vehicle, timeout) != 0) {
+            journal_flush();
+            continue;
+        }
+
+        vehicle_record_to_violation(vehicle, &record);
+        vehicle_record_unref(vehicle);
+
+        if (violation_journal_add(&journal, &record)) {
+            journal_flush();
+        }
+    }
+}
+
+/* Definição da thread (menor prioridade do sistema) */
+#define JOURNAL_THREAD_STACK_SIZE 2048
+#define JOURNAL_THREAD_PRIORITY 10
+
+K_THREAD_DEFINE(journal_thread, JOURNAL_THREAD_STACK_SIZE,
+                journal_thread_entry, NULL, NULL, NULL,
+                JOURNAL_THREAD_PRIORITY, 0, 0);
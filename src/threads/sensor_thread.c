@@ -6,29 +6,55 @@
  * - Detectar passagem de veículos
  * - Contar eixos (classificação)
  * - Medir tempo entre sensores (velocidade)
+ * 
+ * As ISRs dos sensores apenas registram a borda na edge_ring; a máquina
+ * de estados roda inteira na thread de sensores.
+ * 
+ * Cada faixa mantém uma FIFO de veículos entre os sensores
+ * (lane_tracker.h): um veículo conta eixos no sensor 1 enquanto os
+ * anteriores ainda estão sendo medidos, e cada borda do sensor 2 é
+ * casada com o eixo mais antigo pendente (com ressincronização quando
+ * uma borda se perde).
  */
 
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/logging/log.h>
+#include <string.h>
 #include "../types.h"
+#include "../utils/edge_ring.h"
+#include "../utils/lane_tracker.h"
+#include "../utils/axle_class.h"
+#include "../utils/vehicle_pool.h"
+#include "../utils/latency_hist.h"
+#include "../utils/radar_stats.h"
+#include "../utils/traffic_stats.h"
+#include "../radar_settings.h"
 
 LOG_MODULE_REGISTER(sensor_thread, LOG_LEVEL_DBG);
 
-/* Configuração dos GPIOs - QEMU mps2/an385 */
-/* Nota: Como a placa emulada pode não ter GPIO configurado,
- * vamos usar uma abordagem de simulação para demonstração */
-#if DT_NODE_EXISTS(DT_NODELABEL(gpio0))
-#define GPIO_NODE DT_NODELABEL(gpio0)
+/*
+ * Faixas monitoradas: uma instância de "radar,sensor-pair" no devicetree
+ * por faixa (ver dts/bindings/radar,sensor-pair.yaml). Sem nenhuma
+ * instância, o sistema roda em modo simulação com uma faixa.
+ */
+#define DT_DRV_COMPAT radar_sensor_pair
+
+#if DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
 #define GPIO_AVAILABLE 1
+#define NUM_LANES DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT)
 #else
 #define GPIO_AVAILABLE 0
-#warning "GPIO0 não disponível - usando modo simulação"
+#define NUM_LANES 1
+#warning "Nenhum radar,sensor-pair no devicetree - usando modo simulação"
 #endif
 
-#define SENSOR1_PIN 5  /* Sensor magnético 1 (conta eixos) */
-#define SENSOR2_PIN 6  /* Sensor magnético 2 (marca fim) */
+/* Toda faixa detectada precisa de estatísticas próprias no main */
+BUILD_ASSERT(NUM_LANES <= TRAFFIC_MAX_LANES,
+             "CONFIG_RADAR_TRAFFIC_MAX_LANES menor que as faixas do devicetree");
+BUILD_ASSERT(NUM_LANES <= RADAR_STATS_MAX_LANES,
+             "radar_stats sem contadores para todas as faixas do devicetree");
 
 /* Timeouts dinâmicos */
 #define MIN_SPEED_KMH 60          /* Velocidade mínima esperada: 60 km/h */
@@ -36,8 +62,16 @@ LOG_MODULE_REGISTER(sensor_thread, LOG_LEVEL_DBG);
 #define TYPICAL_AXLE_DISTANCE_MM 2700  /* Distância típica entre eixos: 2.7m */
 #define SAFETY_MARGIN_MS 500      /* Margem de segurança: 500ms */
 
+/* Agrupamento pela velocidade do próprio veículo */
+#define AXLE_GROUP_MAX_SPACING_MM AXLE_CLASS_MAX_SPACING_MM /* Maior da tabela de classes */
+#define AXLE_GROUP_MIN_MS 100
+#define AXLE_GROUP_MAX_MS 3000
+
+/* Abaixo disto um eixo que não chegou ao sensor 2 é dado como perdido */
+#define MIN_MEASURABLE_SPEED_KMH 5
+
 /**
- * @brief Calcula timeout dinâmico baseado na velocidade esperada
+ * @brief Timeout estático, para veículos de velocidade ainda desconhecida
  * 
  * Para separar veículos próximos, precisamos de um timeout que considere
  * a velocidade. Um veículo a 100 km/h percorre ~27.8 m/s. Com eixos a
@@ -56,196 +90,488 @@ static inline uint32_t calculate_axle_timeout_ms(void)
     return timeout + SAFETY_MARGIN_MS;
 }
 
-/* Variáveis da máquina de estados */
-static sensor_state_t current_state = SENSOR_STATE_IDLE;
-static uint8_t axle_count = 0;
-static int64_t last_axle_time = 0;
-static int64_t sensor1_last_trigger = 0;
-static int64_t sensor2_trigger_time = 0;
+/**
+ * @brief Timestamp de borda em ciclos de hardware
+ * 
+ * k_uptime_get() tem resolução de 1 ms, o que a 1000 mm de distância e
+ * 120 km/h (~30 ms) já representa vários km/h de erro. O contador de
+ * ciclos tem resolução de ns (25 MHz no mps2/an385).
+ */
+static inline uint64_t edge_timestamp(void)
+{
+#if defined(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER)
+    return k_cycle_get_64();
+#else
+    return k_cycle_get_32();
+#endif
+}
+
+/**
+ * @brief Estende um timestamp de edge_timestamp() para 64 bits monotônicos
+ * 
+ * Chamado só pela thread de sensores. Com contador de 32 bits, acumula
+ * as diferenças modulares (bordas até ~171 s uma da outra a 25 MHz); os
+ * 32 bits baixos continuam iguais aos do contador. Um timestamp anterior
+ * ao último visto (borda registrada antes do "agora" de um timeout) é
+ * devolvido no passado, sem recuar a referência.
+ */
+static uint64_t monotonic_cycles(uint64_t raw)
+{
+#if defined(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER)
+    return raw;
+#else
+    static uint32_t last_raw;
+    static uint64_t mono;
+    static bool started;
+    
+    if (!started) {
+        started = true;
+        last_raw = (uint32_t)raw;
+        mono = (uint32_t)raw;
+        return mono;
+    }
+    
+    int32_t delta = (int32_t)((uint32_t)raw - last_raw);
+    
+    if (delta < 0) {
+        return mono - (uint32_t)(-delta);
+    }
+    
+    last_raw = (uint32_t)raw;
+    mono += (uint32_t)delta;
+    return mono;
+#endif
+}
+
+/**
+ * @brief Pinos de uma faixa (do devicetree)
+ */
+typedef struct {
+    struct gpio_dt_spec sensor1; /**< Sensor magnético 1 (conta eixos) */
+    struct gpio_dt_spec sensor2; /**< Sensor magnético 2 (marca fim) */
+} lane_config_t;
+
+/**
+ * @brief Instância da máquina de estados de uma faixa
+ */
+typedef struct {
+    uint8_t lane_id;                 /**< Índice da faixa */
+    struct lane_tracker tracker;     /**< Veículos entre os sensores */
+    struct gpio_callback sensor1_cb; /**< Callback do sensor 1 */
+    struct gpio_callback sensor2_cb; /**< Callback do sensor 2 */
+    struct k_timer axle_timer;       /**< Fim do agrupamento de eixos / trânsito máximo */
+} lane_state_t;
 
-/* Dispositivo GPIO */
-static const struct device *gpio_dev;
+#if GPIO_AVAILABLE
+#define LANE_CONFIG_INIT(inst)                                      \
+    {                                                               \
+        .sensor1 = GPIO_DT_SPEC_INST_GET(inst, sensor1_gpios),      \
+        .sensor2 = GPIO_DT_SPEC_INST_GET(inst, sensor2_gpios),      \
+    },
 
-/* Fila de mensagens para thread principal */
+static const lane_config_t lane_configs[NUM_LANES] = {
+    DT_INST_FOREACH_STATUS_OKAY(LANE_CONFIG_INIT)
+};
+#endif
+
+/* Máquinas de estados, uma por faixa */
+static lane_state_t lanes[NUM_LANES];
+
+/* Fila de mensagens para thread principal e pool de registros de veículo */
 extern struct k_msgq sensor_msgq;
+extern struct k_mem_slab vehicle_pool;
+
+/* Contadores do pipeline (main.c) */
+extern struct radar_stats radar_stats;
+
+/* Bordas registradas pelas ISRs, consumidas pela thread de sensores */
+static struct edge_ring edge_ring;
+K_SEM_DEFINE(edge_sem, 0, 1);
+
+/* Faixas cujo timer expirou (tratadas pela thread) */
+static ATOMIC_DEFINE(lane_timeouts, NUM_LANES);
 
 /**
- * @brief Callback de interrupção do Sensor 1 (conta eixos)
+ * @brief Aloca o registro do veículo e o envia à thread principal
+ *
+ * A referência do alocador passa para a fila (não-bloqueante). A
+ * classificação fica para a thread principal, que conhece a velocidade.
+ *
+ * @param axle_gap_us Intervalos entre eixos no sensor 1 (axle_count - 1
+ *                    valores, até VEHICLE_MAX_AXLES - 1)
+ * @param edge_cyc Carimbo de latência da última borda do sensor 2
+ *                 (32 bits baixos do contador de ciclos)
  */
-static void sensor1_callback(const struct device *dev, struct gpio_callback *cb, 
-                             uint32_t pins)
+static void send_vehicle(uint32_t time_delta_us, const uint32_t *axle_gap_us,
+                         uint8_t axle_count, uint8_t lane_id, uint32_t edge_cyc)
 {
-    int64_t now = k_uptime_get();
-    uint32_t timeout_ms = calculate_axle_timeout_ms();
-    
-    switch (current_state) {
-    case SENSOR_STATE_IDLE:
-        /* Primeiro eixo detectado - inicia contagem */
-        LOG_DBG("SENSOR1: Primeiro eixo detectado");
-        current_state = SENSOR_STATE_COUNTING_AXLES;
-        axle_count = 1;
-        last_axle_time = now;
-        sensor1_last_trigger = now;
-        break;
+    vehicle_record_t *vehicle = vehicle_record_alloc(&vehicle_pool);
+
+    if (vehicle == NULL) {
+        LOG_ERR("Pool de veiculos esgotado - deteccao descartada (faixa %u)", lane_id);
+        atomic_inc(&radar_stats.pool_drops);
+        return;
+    }
+
+    vehicle->time_delta_us = time_delta_us;
+    memcpy(vehicle->axle_gap_us, axle_gap_us,
+           MIN(axle_count - 1, VEHICLE_MAX_AXLES - 1) * sizeof(uint32_t));
+    vehicle->axle_count = axle_count;
+    vehicle->lane_id = lane_id;
+    vehicle->isr_cyc = edge_cyc;
+
+    if (k_msgq_put(&sensor_msgq, &vehicle, K_NO_WAIT) != 0) {
+        LOG_ERR("Fila de sensores cheia!");
+        atomic_inc(&radar_stats.sensor_drops);
+        vehicle_record_unref(vehicle);
+        return;
+    }
+
+    radar_stats_raise(&radar_stats.sensor_msgq_hwm, k_msgq_num_used_get(&sensor_msgq));
+}
+
+/**
+ * @brief Intervalo máximo entre eixos do veículo aberto da faixa (ciclos)
+ * 
+ * lane_tracker_group_gap() com o maior espaçamento da tabela de classes
+ * (~527 ms a 100 km/h, ~878 ms a 60 km/h); calculate_axle_timeout_ms()
+ * enquanto a velocidade do veículo é desconhecida.
+ */
+static uint64_t axle_group_gap_cyc(struct lane_tracker *tr)
+{
+    const lane_group_params_t params = {
+        .fallback = k_ms_to_cyc_ceil64(calculate_axle_timeout_ms()),
+        .min_gap = k_ms_to_cyc_ceil64(AXLE_GROUP_MIN_MS),
+        .max_gap = k_ms_to_cyc_ceil64(AXLE_GROUP_MAX_MS),
+        .max_spacing_mm = AXLE_GROUP_MAX_SPACING_MM,
+        .distance_mm = radar_config_get(&radar_config)->sensor_distance_mm,
+    };
+    
+    return lane_tracker_group_gap(tr, &params);
+}
+
+/**
+ * @brief Tempo máximo de um eixo entre os sensores (ciclos)
+ */
+static inline uint64_t max_transit_cyc(void)
+{
+    uint32_t distance_mm = radar_config_get(&radar_config)->sensor_distance_mm;
+    
+    return k_ms_to_cyc_ceil64((distance_mm * 3600U) / (MIN_MEASURABLE_SPEED_KMH * 1000U));
+}
+
+/**
+ * @brief Expiração do timer da faixa (contexto de ISR)
+ * 
+ * Apenas sinaliza a faixa; o tratamento é feito pela thread de
+ * sensores, única dona do estado das faixas.
+ */
+static void axle_timer_expiry(struct k_timer *timer)
+{
+    lane_state_t *lane = CONTAINER_OF(timer, lane_state_t, axle_timer);
+    
+    atomic_set_bit(lane_timeouts, lane->lane_id);
+    k_sem_give(&edge_sem);
+}
+
+/**
+ * @brief Arma o timer para o próximo prazo da faixa
+ * 
+ * Com um veículo contando eixos, o prazo é o fim do agrupamento; senão,
+ * o trânsito máximo do veículo mais antigo. A decisão final é tomada
+ * com o contador de ciclos em process_lane_timeouts().
+ */
+static void lane_arm_timer(lane_state_t *lane, uint64_t now)
+{
+    struct lane_tracker *tr = &lane->tracker;
+    const lane_vehicle_t *open = lane_tracker_open(tr);
+    uint64_t deadline;
+    
+    if (open != NULL) {
+        deadline = open->last_s1 + axle_group_gap_cyc(tr);
+    } else if (tr->count > 0) {
+        deadline = lane_tracker_at(tr, 0)->last_s1 + max_transit_cyc();
+    } else {
+        k_timer_stop(&lane->axle_timer);
+        return;
+    }
+    
+    uint64_t remaining = (deadline > now) ? deadline - now : 0;
+    
+    k_timer_start(&lane->axle_timer, K_USEC(k_cyc_to_us_ceil64(remaining) + 1), K_NO_WAIT);
+}
+
+/**
+ * @brief Entrega à thread principal os veículos completos (em ordem)
+ */
+static void lane_emit_complete(lane_state_t *lane)
+{
+    lane_vehicle_t v;
+    uint32_t axle_gap_us[VEHICLE_MAX_AXLES - 1];
+    
+    while (lane_tracker_take_complete(&lane->tracker, &v)) {
+        uint64_t transit_us = k_cyc_to_us_near64(lane_vehicle_transit(&v));
+        uint32_t time_delta = (transit_us > UINT32_MAX) ? UINT32_MAX : (uint32_t)transit_us;
+        uint8_t timed = MIN(v.axles, (uint8_t)VEHICLE_MAX_AXLES);
         
-    case SENSOR_STATE_COUNTING_AXLES:
-        /* Verifica se não foi timeout */
-        if ((now - last_axle_time) > timeout_ms) {
-            /* Timeout - recomeça contagem (novo veículo) */
-            LOG_WRN("SENSOR1: Timeout (%u ms) entre eixos, novo veículo detectado", timeout_ms);
-            axle_count = 1;
-            sensor1_last_trigger = now;
-        } else {
-            /* Mais um eixo do mesmo veículo */
-            axle_count++;
-            LOG_DBG("SENSOR1: Eixo %d detectado (Δt=%lld ms)", axle_count, now - last_axle_time);
-            sensor1_last_trigger = now;
+        for (uint8_t i = 1; i < timed; i++) {
+            uint64_t gap_us = k_cyc_to_us_near64(v.axle_s1[i] - v.axle_s1[i - 1]);
+            
+            axle_gap_us[i - 1] = (gap_us > UINT32_MAX) ? UINT32_MAX : (uint32_t)gap_us;
         }
-        last_axle_time = now;
-        break;
         
-    case SENSOR_STATE_MEASURING_SPEED:
-        /* Ignora pulsos do sensor 1 enquanto aguarda sensor 2 */
-        LOG_DBG("SENSOR1: Ignorando pulso (aguardando sensor 2)");
-        break;
+        LOG_INF("=== Detecção Completa (faixa %u) ===", lane->lane_id);
+        LOG_INF("Eixos: %d", v.axles);
+        LOG_INF("Tempo: %u us", time_delta);
         
-    default:
-        break;
+        send_vehicle(time_delta, axle_gap_us, v.axles, lane->lane_id, (uint32_t)v.last_s2);
     }
 }
 
 /**
- * @brief Callback de interrupção do Sensor 2 (marca fim)
+ * @brief Pulso no Sensor 1 (conta eixos) de uma faixa
  */
-static void sensor2_callback(const struct device *dev, struct gpio_callback *cb, 
-                             uint32_t pins)
+static void lane_sensor1_event(lane_state_t *lane, uint64_t now)
 {
-    int64_t now = k_uptime_get();
+    struct lane_tracker *tr = &lane->tracker;
     
-    switch (current_state) {
-    case SENSOR_STATE_IDLE:
-        /* Sensor 2 disparou sem sensor 1 - ignora */
-        LOG_WRN("SENSOR2: Disparou sem passar pelo sensor 1 (ignorado)");
+    switch (lane_tracker_sensor1(tr, now, axle_group_gap_cyc(tr))) {
+    case LANE_S1_NEW_VEHICLE:
+        LOG_DBG("Faixa %u SENSOR1: Primeiro eixo detectado (%u veiculo(s) entre os sensores)",
+                lane->lane_id, tr->count);
         break;
         
-    case SENSOR_STATE_COUNTING_AXLES:
-        /* Veículo chegou ao sensor 2 - calcula velocidade */
-        LOG_DBG("SENSOR2: Veículo detectado, iniciando medição");
-        current_state = SENSOR_STATE_MEASURING_SPEED;
-        sensor2_trigger_time = now;
+    case LANE_S1_AXLE:
+        LOG_DBG("Faixa %u SENSOR1: Eixo %d detectado", lane->lane_id,
+                lane_tracker_open(tr)->axles);
         break;
         
-    case SENSOR_STATE_MEASURING_SPEED:
-        /* Segundo sensor disparou - finaliza medição */
-        uint32_t time_delta = (uint32_t)(now - sensor1_last_trigger);
+    case LANE_S1_FULL:
+        LOG_ERR("Faixa %u SENSOR1: %u veiculos entre os sensores - eixo descartado",
+                lane->lane_id, LANE_TRACKER_DEPTH);
+        atomic_inc(&radar_stats.tracker_drops);
+        break;
+    }
+    
+    /* Um novo veículo fecha o anterior, que pode já estar medido */
+    lane_emit_complete(lane);
+    lane_arm_timer(lane, now);
+}
+
+/**
+ * @brief Pulso no Sensor 2 (marca fim) de uma faixa
+ * 
+ * Pertence ao eixo mais antigo ainda não visto no sensor 2, de qualquer
+ * veículo em trânsito.
+ */
+static void lane_sensor2_event(lane_state_t *lane, uint64_t now)
+{
+    if (!lane_tracker_sensor2(&lane->tracker, now)) {
+        /* Sem eixo pendente, ou cedo demais para o eixo pendente - ignora */
+        LOG_WRN("Faixa %u SENSOR2: Borda sem eixo correspondente no sensor 1 (ignorada)",
+                lane->lane_id);
+        return;
+    }
+    
+    lane_emit_complete(lane);
+    
+    /* O primeiro eixo do veículo aberto dá a velocidade: novo prazo */
+    lane_arm_timer(lane, now);
+}
+
+/**
+ * @brief Aplica na máquina de estados as bordas registradas pelas ISRs
+ */
+static void process_edge_events(void)
+{
+    edge_event_t ev;
+    
+    while (edge_ring_pop(&edge_ring, &ev)) {
+        lane_state_t *lane = &lanes[ev.lane_id];
+        uint64_t now = monotonic_cycles(ev.timestamp);
+        
+        if (ev.sensor == 1) {
+            lane_sensor1_event(lane, now);
+        } else {
+            lane_sensor2_event(lane, now);
+        }
+    }
+    
+    uint32_t dropped = edge_ring_take_dropped(&edge_ring);
+    if (dropped != 0) {
+        atomic_add(&radar_stats.edge_drops, (atomic_val_t)dropped);
+        LOG_ERR("%u bordas descartadas (fila de bordas cheia)", dropped);
+    }
+}
+
+/**
+ * @brief Trata as faixas cujo timer expirou
+ * 
+ * Fecha o agrupamento de eixos do veículo aberto e descarta veículos
+ * cujos eixos não chegaram ao sensor 2 (borda perdida), que senão
+ * deslocariam o casamento das bordas seguintes.
+ */
+static void process_lane_timeouts(void)
+{
+    uint64_t now = monotonic_cycles(edge_timestamp());
+    
+    for (uint8_t i = 0; i < NUM_LANES; i++) {
+        lane_state_t *lane = &lanes[i];
+        struct lane_tracker *tr = &lane->tracker;
         
-        LOG_INF("=== Detecção Completa ===");
-        LOG_INF("Eixos: %d", axle_count);
-        LOG_INF("Tempo: %u ms", time_delta);
+        if (!atomic_test_and_clear_bit(lane_timeouts, i)) {
+            continue;
+        }
         
-        /* Prepara mensagem para thread principal */
-        sensor_data_msg_t msg = {
-            .time_delta_ms = time_delta,
-            .vehicle_type = (axle_count <= 2) ? VEHICLE_TYPE_LIGHT : VEHICLE_TYPE_HEAVY,
-            .axle_count = axle_count
-        };
+        uint64_t gap = axle_group_gap_cyc(tr);
         
-        /* Envia para fila (não-bloqueante) */
-        if (k_msgq_put(&sensor_msgq, &msg, K_NO_WAIT) != 0) {
-            LOG_ERR("Fila de sensores cheia!");
+        if (lane_tracker_close(tr, now, gap)) {
+            LOG_DBG("Faixa %u: fim do agrupamento de eixos (%llu ms)", lane->lane_id,
+                    k_cyc_to_ms_floor64(gap));
         }
         
-        /* Volta ao estado inicial */
-        current_state = SENSOR_STATE_IDLE;
-        axle_count = 0;
-        break;
+        while (lane_tracker_expire(tr, now, max_transit_cyc())) {
+            LOG_WRN("Faixa %u: eixos sem sensor 2 em %llu ms - veiculo descartado",
+                    lane->lane_id, k_cyc_to_ms_floor64(max_transit_cyc()));
+            atomic_inc(&radar_stats.tracker_drops);
+        }
         
-    default:
-        break;
+        lane_emit_complete(lane);
+        lane_arm_timer(lane, now);
+    }
+}
+
+#if GPIO_AVAILABLE
+/**
+ * @brief Registra a borda e acorda a thread (único trabalho feito na ISR)
+ */
+static inline void record_edge(const lane_state_t *lane, uint8_t sensor)
+{
+    edge_event_t ev = {
+        .timestamp = edge_timestamp(),
+        .lane_id = lane->lane_id,
+        .sensor = sensor
+    };
+    
+    if (edge_ring_push(&edge_ring, &ev)) {
+        k_sem_give(&edge_sem);
     }
 }
 
-/* Estruturas de callback */
-static struct gpio_callback sensor1_cb_data;
-static struct gpio_callback sensor2_cb_data;
+/**
+ * @brief Callback de interrupção do Sensor 1 (conta eixos)
+ */
+static void sensor1_callback(const struct device *dev, struct gpio_callback *cb, 
+                             uint32_t pins)
+{
+    record_edge(CONTAINER_OF(cb, lane_state_t, sensor1_cb), 1);
+}
 
 /**
- * @brief Inicializa os GPIOs e interrupções
+ * @brief Callback de interrupção do Sensor 2 (marca fim)
  */
-static int init_sensors(void)
+static void sensor2_callback(const struct device *dev, struct gpio_callback *cb, 
+                             uint32_t pins)
+{
+    record_edge(CONTAINER_OF(cb, lane_state_t, sensor2_cb), 2);
+}
+
+/**
+ * @brief Configura um sensor como entrada com interrupção na borda de subida
+ */
+static int init_sensor_pin(const struct gpio_dt_spec *spec, struct gpio_callback *cb,
+                           gpio_callback_handler_t handler)
 {
-#if GPIO_AVAILABLE
     int ret;
     
-    gpio_dev = DEVICE_DT_GET(GPIO_NODE);
-    if (!device_is_ready(gpio_dev)) {
-        LOG_WRN("GPIO device not ready - running in simulation mode");
+    if (!gpio_is_ready_dt(spec)) {
         return -ENODEV;
     }
     
-    /* Configura Sensor 1 (GPIO 5) como entrada com pull-down */
-    ret = gpio_pin_configure(gpio_dev, SENSOR1_PIN, GPIO_INPUT | GPIO_PULL_DOWN);
+    ret = gpio_pin_configure_dt(spec, GPIO_INPUT);
     if (ret != 0) {
-        LOG_WRN("Failed to configure SENSOR1_PIN - running in simulation mode");
         return ret;
     }
     
-    /* Configura Sensor 2 (GPIO 6) como entrada com pull-down */
-    ret = gpio_pin_configure(gpio_dev, SENSOR2_PIN, GPIO_INPUT | GPIO_PULL_DOWN);
+    ret = gpio_pin_interrupt_configure_dt(spec, GPIO_INT_EDGE_RISING);
     if (ret != 0) {
-        LOG_WRN("Failed to configure SENSOR2_PIN - running in simulation mode");
         return ret;
     }
     
-    /* Configura interrupção no Sensor 1 (borda de subida) */
-    ret = gpio_pin_interrupt_configure(gpio_dev, SENSOR1_PIN, GPIO_INT_EDGE_RISING);
-    if (ret != 0) {
-        LOG_WRN("Failed to configure interrupt for SENSOR1 - running in simulation mode");
-        return ret;
-    }
+    gpio_init_callback(cb, handler, BIT(spec->pin));
+    return gpio_add_callback_dt(spec, cb);
+}
+#endif
+
+/**
+ * @brief Inicializa os GPIOs e interrupções de todas as faixas
+ */
+static int init_sensors(void)
+{
+    edge_ring_init(&edge_ring);
     
-    /* Configura interrupção no Sensor 2 (borda de subida) */
-    ret = gpio_pin_interrupt_configure(gpio_dev, SENSOR2_PIN, GPIO_INT_EDGE_RISING);
-    if (ret != 0) {
-        LOG_WRN("Failed to configure interrupt for SENSOR2 - running in simulation mode");
-        return ret;
+    for (uint8_t i = 0; i < NUM_LANES; i++) {
+        lanes[i].lane_id = i;
+        lane_tracker_init(&lanes[i].tracker);
+        k_timer_init(&lanes[i].axle_timer, axle_timer_expiry, NULL);
     }
     
-    /* Inicializa e adiciona callback do Sensor 1 */
-    gpio_init_callback(&sensor1_cb_data, sensor1_callback, BIT(SENSOR1_PIN));
-    gpio_add_callback(gpio_dev, &sensor1_cb_data);
+#if GPIO_AVAILABLE
+    int ret;
     
-    /* Inicializa e adiciona callback do Sensor 2 */
-    gpio_init_callback(&sensor2_cb_data, sensor2_callback, BIT(SENSOR2_PIN));
-    gpio_add_callback(gpio_dev, &sensor2_cb_data);
+    for (uint8_t i = 0; i < NUM_LANES; i++) {
+        const lane_config_t *cfg = &lane_configs[i];
+        
+        ret = init_sensor_pin(&cfg->sensor1, &lanes[i].sensor1_cb, sensor1_callback);
+        if (ret != 0) {
+            LOG_WRN("Falha no sensor 1 da faixa %u (erro %d) - running in simulation mode",
+                    i, ret);
+            return ret;
+        }
+        
+        ret = init_sensor_pin(&cfg->sensor2, &lanes[i].sensor2_cb, sensor2_callback);
+        if (ret != 0) {
+            LOG_WRN("Falha no sensor 2 da faixa %u (erro %d) - running in simulation mode",
+                    i, ret);
+            return ret;
+        }
+        
+        LOG_INF("Faixa %u: sensores inicializados (GPIO %d e %d)",
+                i, cfg->sensor1.pin, cfg->sensor2.pin);
+    }
     
-    LOG_INF("Sensores inicializados (GPIO %d e %d)", SENSOR1_PIN, SENSOR2_PIN);
     return 0;
 #else
     LOG_INF("Modo simulação ativado (GPIO não disponível)");
-    return 0;
+    return -ENODEV;
 #endif
 }
 
 /**
  * @brief Simula detecção de veículo (para teste sem GPIO)
  */
-static void simulate_vehicle_detection(vehicle_type_t type, uint32_t speed_kmh)
+static void simulate_vehicle_detection(uint8_t lane_id, vehicle_type_t type, uint32_t speed_kmh)
 {
-    uint32_t time_delta = (CONFIG_RADAR_SENSOR_DISTANCE_MM * 3600) / (speed_kmh * 1000);
+    /* Automóvel (2,7 m) ou caminhão de 3 eixos (4,0 m + tandem de 1,3 m) */
+    static const uint32_t light_mm[] = { 2700 };
+    static const uint32_t heavy_mm[] = { 4000, 1300 };
+    const uint32_t *spacing = (type == VEHICLE_TYPE_LIGHT) ? light_mm : heavy_mm;
     uint8_t axles = (type == VEHICLE_TYPE_LIGHT) ? 2 : 3;
+    uint32_t axle_gap_us[2];
     
-    sensor_data_msg_t msg = {
-        .time_delta_ms = time_delta,
-        .vehicle_type = type,
-        .axle_count = axles
-    };
+    /* us = mm * 3600 / km/h */
+    uint32_t time_delta =
+        (radar_config_get(&radar_config)->sensor_distance_mm * 3600) / speed_kmh;
     
-    k_msgq_put(&sensor_msgq, &msg, K_NO_WAIT);
+    for (uint8_t i = 0; i < axles - 1; i++) {
+        axle_gap_us[i] = (spacing[i] * 3600) / speed_kmh;
+    }
+    
+    send_vehicle(time_delta, axle_gap_us, axles, lane_id, latency_stamp());
 }
 
 /**
- * @brief Thread de sensores (apenas monitora timeouts)
+ * @brief Thread de sensores (máquina de estados e timeouts)
  */
 void sensor_thread_entry(void *p1, void *p2, void *p3)
 {
@@ -265,39 +591,32 @@ void sensor_thread_entry(void *p1, void *p2, void *p3)
         while (1) {
             k_sleep(K_SECONDS(3));
             
+            uint8_t lane_id = demo_count % NUM_LANES;
+            
             switch (demo_count % 4) {
             case 0:
-                simulate_vehicle_detection(VEHICLE_TYPE_LIGHT, 50);
+                simulate_vehicle_detection(lane_id, VEHICLE_TYPE_LIGHT, 50);
                 break;
             case 1:
-                simulate_vehicle_detection(VEHICLE_TYPE_LIGHT, 56);
+                simulate_vehicle_detection(lane_id, VEHICLE_TYPE_LIGHT, 56);
                 break;
             case 2:
-                simulate_vehicle_detection(VEHICLE_TYPE_LIGHT, 70);
+                simulate_vehicle_detection(lane_id, VEHICLE_TYPE_LIGHT, 70);
                 break;
             case 3:
-                simulate_vehicle_detection(VEHICLE_TYPE_HEAVY, 50);
+                simulate_vehicle_detection(lane_id, VEHICLE_TYPE_HEAVY, 50);
                 break;
             }
             demo_count++;
         }
     }
     
-    /* Loop principal: verifica timeout de eixos (apenas se GPIO disponível) */
+    /* Loop principal: dorme até haver borda ou prazo de alguma faixa */
     while (1) {
-        k_sleep(K_MSEC(100));  /* Verifica a cada 100ms para melhor precisão */
+        k_sem_take(&edge_sem, K_FOREVER);
         
-        if (current_state == SENSOR_STATE_COUNTING_AXLES) {
-            int64_t now = k_uptime_get();
-            uint32_t timeout_ms = calculate_axle_timeout_ms();
-            
-            if ((now - last_axle_time) > timeout_ms) {
-                LOG_WRN("Timeout dinâmico (%u ms) na contagem de eixos, resetando estado", 
-                        timeout_ms);
-                current_state = SENSOR_STATE_IDLE;
-                axle_count = 0;
-            }
-        }
+        process_edge_events();
+        process_lane_timeouts();
     }
 }
 
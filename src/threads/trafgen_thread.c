@@ -0,0 +1,202 @@
+/**
+ * @file trafgen_thread.c
+ * @brief Thread do gerador de tráfego (bordas injetadas via gpio_emul)
+ *
+ * Gera veículos com traffic_gen.h e injeta as bordas dos sensores nos
+ * pinos das faixas do devicetree com gpio_emul_input_set(): as ISRs,
+ * a edge_ring e a máquina de estados trabalham como com sensores reais.
+ *
+ * No native_sim sem CONFIG_NATIVE_SIM_SLOWDOWN_TO_REAL_TIME o tempo é
+ * virtual e avança direto para a próxima borda quando todas as threads
+ * estão ociosas: um dia de tráfego roda em minutos.
+ *
+ * Com CONFIG_SYS_HEAP_RUNTIME_STATS e um heap do sistema, o gerador
+ * também confere o caminho de regime: os bytes alocados no heap não
+ * podem mudar enquanto o tráfego passa pelas threads reais (ZBUS,
+ * câmera, display, journal). Uma alocação em regime é erro fatal
+ * (k_oops), e o sample.yaml roda o gerador no twister esperando a
+ * mensagem de heap intacto no fim.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/sys/sys_heap.h>
+#include <stdlib.h>
+#include "../types.h"
+#include "../utils/traffic_gen.h"
+#include "../radar_settings.h"
+
+LOG_MODULE_REGISTER(trafgen_thread, LOG_LEVEL_INF);
+
+#define DT_DRV_COMPAT radar_sensor_pair
+
+#define NUM_LANES DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT)
+
+BUILD_ASSERT(NUM_LANES > 0, "Gerador de tráfego requer faixas radar,sensor-pair");
+
+/**
+ * @brief Pinos de uma faixa (do devicetree)
+ */
+typedef struct {
+    struct gpio_dt_spec sensor1;
+    struct gpio_dt_spec sensor2;
+} trafgen_lane_t;
+
+#define TRAFGEN_LANE_INIT(inst)                                     \
+    {                                                               \
+        .sensor1 = GPIO_DT_SPEC_INST_GET(inst, sensor1_gpios),      \
+        .sensor2 = GPIO_DT_SPEC_INST_GET(inst, sensor2_gpios),      \
+    },
+
+static const trafgen_lane_t trafgen_lanes[NUM_LANES] = {
+    DT_INST_FOREACH_STATUS_OKAY(TRAFGEN_LANE_INIT)
+};
+
+static struct traffic_gen gen;
+
+/**
+ * @brief Lê as taxas por faixa de CONFIG_RADAR_TRAFGEN_LANE_RATES ("1800,1200")
+ *
+ * Faixas sem valor na lista repetem o último.
+ */
+static void parse_lane_rates(struct traffic_gen_config *cfg)
+{
+    const char *p = CONFIG_RADAR_TRAFGEN_LANE_RATES;
+    uint32_t rate = 0;
+
+    for (uint8_t l = 0; l < cfg->lanes; l++) {
+        if (*p != '\0') {
+            char *end;
+
+            rate = strtoul(p, &end, 10);
+            p = (*end == ',') ? end + 1 : end;
+        }
+        cfg->rate_vph[l] = rate;
+    }
+}
+
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && (CONFIG_HEAP_MEM_POOL_SIZE > 0)
+#define TRAFGEN_HEAP_CHECK 1
+
+/* Heap do sistema (CONFIG_HEAP_MEM_POOL_SIZE) */
+extern struct k_heap _system_heap;
+
+static size_t heap_allocated_bytes(void)
+{
+    struct sys_memory_stats stats;
+
+    if (sys_heap_runtime_stats_get(&_system_heap.heap, &stats) != 0) {
+        return 0;
+    }
+    return stats.allocated_bytes;
+}
+#else
+#define TRAFGEN_HEAP_CHECK 0
+
+static size_t heap_allocated_bytes(void)
+{
+    return 0;
+}
+#endif
+
+/**
+ * @brief Confere que nada foi alocado no heap desde o início do tráfego
+ *
+ * Falha com k_oops(): o caminho de regime não pode alocar.
+ */
+static void heap_check(size_t baseline)
+{
+    if (!TRAFGEN_HEAP_CHECK) {
+        return;
+    }
+
+    size_t allocated = heap_allocated_bytes();
+
+    if (allocated != baseline) {
+        LOG_ERR("Heap: %zu bytes alocados em regime (esperado %zu)", allocated, baseline);
+        LOG_PANIC();
+        k_oops();
+    } else {
+        LOG_INF("Heap: nenhuma alocacao em regime");
+    }
+}
+
+/**
+ * @brief Pulso em um sensor (borda de subida e volta a 0)
+ */
+static void pulse(const struct gpio_dt_spec *spec)
+{
+    gpio_emul_input_set(spec->port, spec->pin, 1);
+    gpio_emul_input_set(spec->port, spec->pin, 0);
+}
+
+/**
+ * @brief Thread do gerador
+ */
+static void trafgen_thread_entry(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    struct traffic_gen_config cfg = {
+        .lanes = MIN(NUM_LANES, TRAFFIC_GEN_MAX_LANES),
+        .arrivals = IS_ENABLED(CONFIG_RADAR_TRAFGEN_BURSTY) ? TRAFFIC_GEN_BURSTY
+                                                            : TRAFFIC_GEN_POISSON,
+        .speed_mean_kmh = CONFIG_RADAR_TRAFGEN_SPEED_MEAN_KMH,
+        .speed_sd_kmh = CONFIG_RADAR_TRAFGEN_SPEED_SD_KMH,
+        .heavy_percent = CONFIG_RADAR_TRAFGEN_HEAVY_PERCENT,
+        .platoon_percent = CONFIG_RADAR_TRAFGEN_PLATOON_PERCENT,
+        /* Mesma geometria do cálculo (snapshot carregado no boot, antes do gerador) */
+        .sensor_distance_mm = radar_config_get(&radar_config)->sensor_distance_mm,
+    };
+    const uint64_t duration_us = (uint64_t)CONFIG_RADAR_TRAFGEN_DURATION_S * USEC_PER_SEC;
+    traffic_gen_edge_t edge;
+    uint32_t next_report_h = 1;
+
+    parse_lane_rates(&cfg);
+    traffic_gen_init(&gen, &cfg, CONFIG_RADAR_TRAFGEN_SEED);
+
+    for (uint8_t l = 0; l < cfg.lanes; l++) {
+        LOG_INF("Gerador: faixa %u a %u veic/h", l, cfg.rate_vph[l]);
+    }
+
+    /* Boot concluído: a partir daqui o heap não pode crescer */
+    const size_t heap_baseline = heap_allocated_bytes();
+    uint64_t start_us = k_ticks_to_us_floor64(k_uptime_ticks());
+
+    while (traffic_gen_next_edge(&gen, &edge)) {
+        if (duration_us != 0 && edge.time_us >= duration_us) {
+            break;
+        }
+
+        /* Tempo absoluto: atrasos da injeção não se acumulam */
+        k_sleep(K_TIMEOUT_ABS_US(start_us + edge.time_us));
+
+        const trafgen_lane_t *lane = &trafgen_lanes[edge.lane_id];
+
+        pulse((edge.sensor == 1) ? &lane->sensor1 : &lane->sensor2);
+
+        if (edge.time_us >= (uint64_t)next_report_h * 3600U * USEC_PER_SEC) {
+            LOG_INF("Gerador: %u h simuladas, %u veiculos", next_report_h, gen.vehicles);
+            heap_check(heap_baseline);
+            next_report_h++;
+        }
+    }
+
+    LOG_INF("Gerador concluido: %u veiculos (%u descartados)", gen.vehicles, gen.dropped);
+    heap_check(heap_baseline);
+}
+
+/* Prioridade abaixo da thread de sensores: bordas são consumidas antes da próxima */
+#define TRAFGEN_THREAD_STACK_SIZE 1024
+#define TRAFGEN_THREAD_PRIORITY 8
+#define TRAFGEN_START_DELAY_MS 500
+
+K_THREAD_DEFINE(trafgen_thread, TRAFGEN_THREAD_STACK_SIZE,
+                trafgen_thread_entry, NULL, NULL, NULL,
+                TRAFGEN_THREAD_PRIORITY, 0, TRAFGEN_START_DELAY_MS);
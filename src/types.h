@@ -18,8 +18,33 @@
 typedef enum {
     VEHICLE_TYPE_LIGHT = 0,  /**< Veículo leve (2 eixos) */
     VEHICLE_TYPE_HEAVY = 1,  /**< Veículo pesado (3+ eixos) */
+    VEHICLE_TYPE_COUNT       /**< Número de tipos (não é um tipo) */
 } vehicle_type_t;
 
+/** Eixos com tempo guardado por veículo (classificação por espaçamento) */
+#define VEHICLE_MAX_AXLES 10
+
+/**
+ * @brief Classes por espaçamento entre eixos (axle_class.h)
+ *
+ * Refinam vehicle_type_t: cada classe tem o seu limite (leve ou pesado).
+ */
+typedef enum {
+    VEHICLE_CLASS_UNKNOWN = 0,     /**< Sem correspondência: tipo pelo número de eixos */
+    VEHICLE_CLASS_CAR,             /**< Automóvel */
+    VEHICLE_CLASS_CAR_TRAILER,     /**< Automóvel com reboque */
+    VEHICLE_CLASS_BUS,             /**< Ônibus */
+    VEHICLE_CLASS_TRUCK_2,         /**< Caminhão de 2 eixos */
+    VEHICLE_CLASS_TRUCK_3,
+    VEHICLE_CLASS_TRUCK_4,
+    VEHICLE_CLASS_TRUCK_5,
+    VEHICLE_CLASS_TRUCK_6,
+    VEHICLE_CLASS_TRUCK_7,
+    VEHICLE_CLASS_TRUCK_8,
+    VEHICLE_CLASS_TRUCK_9,         /**< Caminhão de 9 eixos */
+    VEHICLE_CLASS_COUNT            /**< Número de classes (não é uma classe) */
+} vehicle_class_t;
+
 /**
  * @brief Status de velocidade para exibição
  */
@@ -39,39 +64,84 @@ typedef enum {
     SENSOR_STATE_COMPLETE = 3        /**< Detecção completa */
 } sensor_state_t;
 
+/** Placa gravada em vehicle_record_t.plate (bit de flags) */
+#define VEHICLE_FLAG_PLATE BIT(0)
+
 /**
- * @brief Mensagem de dados do sensor para thread principal
+ * @brief Registro de um veículo, compartilhado por todos os estágios
+ * 
+ * Alocado do pool (vehicle_pool.h) pela thread de sensores e passado
+ * por ponteiro: sensor_msgq, display_msgq, camera_trigger_chan e
+ * journal_msgq carregam só o ponteiro. Cada estágio que guarda o
+ * ponteiro tem uma referência; o último a soltar devolve o registro
+ * ao pool.
  * 
- * Enviada pela thread de sensores via fila quando uma
- * detecção completa é realizada.
+ * Campos de medição são escritos pelo sensor e os de cálculo pela
+ * thread principal antes do primeiro envio a outro estágio; depois
+ * disso são somente leitura. A placa é escrita uma única vez pelo
+ * estágio de captura e publicada por VEHICLE_FLAG_PLATE.
+ * 
+ * Os carimbos de latência (latency_hist.h) são escritos cada um por um
+ * único estágio, antes de passar o registro ao estágio que os lê.
  */
-typedef struct {
-    uint32_t time_delta_ms;      /**< Tempo entre sensores (ms) */
-    vehicle_type_t vehicle_type; /**< Tipo de veículo detectado */
-    uint8_t axle_count;          /**< Número de eixos contados */
-} sensor_data_msg_t;
+typedef struct vehicle_record {
+    atomic_t refs;                /**< Referências (estágios que guardam o ponteiro) */
+    atomic_t flags;               /**< VEHICLE_FLAG_* */
+    struct k_mem_slab *slab;      /**< Pool de origem */
+    /* Sensor */
+    uint32_t time_delta_us;       /**< Tempo entre sensores (us, do contador de ciclos) */
+    uint32_t axle_gap_us[VEHICLE_MAX_AXLES - 1]; /**< Eixo i+1 - eixo i no sensor 1 (us) */
+    uint8_t axle_count;           /**< Número de eixos contados */
+    uint8_t lane_id;              /**< Faixa em que o veículo passou */
+    /* Thread principal */
+    vehicle_type_t vehicle_type;  /**< Tipo (leve/pesado), da classe */
+    vehicle_class_t vehicle_class;/**< Classe por espaçamento entre eixos */
+    uint32_t seq;                 /**< Sequência do veículo (crescente) */
+    uint32_t store_seq;           /**< Registro em detection_store */
+    uint32_t speed_centi_kmh;     /**< Velocidade calculada (0,01 km/h) */
+    uint32_t speed_limit;         /**< Limite aplicável */
+    speed_status_t status;        /**< Status da velocidade */
+    /* Carimbos de latência (ciclos, latency_stamp()) */
+    uint32_t isr_cyc;             /**< Borda do sensor 2 */
+    uint32_t dequeue_cyc;         /**< Retirada da sensor_msgq */
+    uint32_t compute_cyc;         /**< Fim do cálculo */
+    uint32_t trigger_cyc;         /**< Trigger recebido pela câmera */
+    /* Estágio de captura */
+    uint32_t captured_ms;         /**< k_uptime_get_32() da captura da placa */
+    char plate[8];                /**< Placa capturada (válida com VEHICLE_FLAG_PLATE) */
+} vehicle_record_t;
 
 /**
- * @brief Mensagem para atualização do display
+ * @brief Dados de um quadro do display
  * 
- * Enviada pela thread principal para thread de display
+ * Cópia local, na thread de display, do vehicle_record_t recebido
+ * (vehicle_record_to_display). A thread principal (velocidade) e o
+ * estágio de captura (placa) enviam o mesmo registro; as duas
+ * atualizações têm o mesmo seq e o display as funde em um único quadro.
  */
 typedef struct {
-    uint32_t speed_kmh;           /**< Velocidade calculada (km/h) */
+    uint32_t seq;                 /**< Sequência do veículo (crescente) */
+    uint32_t speed_centi_kmh;     /**< Velocidade calculada (0,01 km/h) */
     vehicle_type_t vehicle_type;  /**< Tipo de veículo */
     speed_status_t status;        /**< Status da velocidade */
     uint32_t speed_limit;         /**< Limite aplicável */
     char plate[8];                /**< Placa capturada (vazio se não for infração) */
+    uint8_t lane_id;              /**< Faixa do veículo (fusão por faixa) */
+    uint32_t isr_cyc;             /**< Carimbo da borda do sensor 2 (latência) */
+    uint32_t compute_cyc;         /**< Carimbo do fim do cálculo (latência) */
 } display_data_msg_t;
 
+/** Prazo de uma captura: depois disso a requisição é dada como perdida */
+#define CAPTURE_TIMEOUT_MS 2000
+
 /**
  * @brief Evento ZBUS para trigger da câmera
  * 
  * Publicado quando há infração
  */
 typedef struct {
-    uint32_t speed_kmh;           /**< Velocidade da infração */
-    vehicle_type_t vehicle_type;  /**< Tipo de veículo */
+    uint32_t request_id;          /**< Identificador da requisição de captura */
+    vehicle_record_t *vehicle;    /**< Veículo (uma referência, solta pela câmera) */
 } camera_trigger_event_t;
 
 /**
@@ -80,9 +150,26 @@ typedef struct {
  * Publicado pela câmera simulada via ZBUS
  */
 typedef struct {
+    uint32_t request_id; /**< Requisição de captura a que o resultado pertence */
     char plate[8];      /**< Placa Mercosul (7 chars + \0) */
     bool valid;         /**< Se a captura foi bem-sucedida */
     uint64_t timestamp; /**< Timestamp da captura */
 } camera_result_event_t;
 
+/**
+ * @brief Infração registrada no journal em flash
+ * 
+ * Formato gravado em flash, montado pela thread do journal a partir do
+ * vehicle_record_t (vehicle_record_to_violation). Tamanho fixo de 20
+ * bytes, sem padding.
+ */
+typedef struct {
+    uint32_t uptime_ms;           /**< k_uptime_get_32() da captura */
+    uint32_t speed_centi_kmh;     /**< Velocidade da infração (0,01 km/h) */
+    uint16_t speed_limit;         /**< Limite aplicado (km/h) */
+    uint8_t vehicle_type;         /**< vehicle_type_t */
+    uint8_t lane_id;              /**< Faixa */
+    char plate[8];                /**< Placa capturada */
+} violation_record_t;
+
 #endif /* RADAR_TYPES_H */
@@ -0,0 +1,179 @@
+/**
+ * @file axle_class.h
+ * @brief Classificação pelo espaçamento entre eixos
+ *
+ * O sensor guarda o intervalo de tempo entre eixos consecutivos no
+ * sensor 1. Com a velocidade medida, cada intervalo vira distância
+ * (mm), independente de quão rápido o veículo passou, e o conjunto de
+ * distâncias é comparado com uma tabela compacta de classes.
+ *
+ * Cada linha da tabela aceita uma faixa de número de eixos, uma janela
+ * para o primeiro espaçamento (entre-eixos do cavalo/automóvel), uma para
+ * o segundo e uma comum aos demais. A primeira linha que aceita o veículo
+ * define a classe; sem correspondência, a classe é desconhecida e o tipo
+ * vem só do número de eixos (classify_vehicle). Tempo limitado (linhas x
+ * eixos), sem alocação.
+ *
+ * O primeiro espaçamento de automóvel com reboque (até 3400 mm) cruza o
+ * de caminhões (a partir de 2800 mm). O segundo separa os dois: no
+ * automóvel é o engate (eixo traseiro ao eixo do reboque, >= 2500 mm),
+ * no caminhão é o tandem (~1300 mm).
+ *
+ * A classe serve para estatística e para escolher entre os dois limites
+ * de velocidade existentes (leve ou pesado, vehicle_type_t); não há
+ * limite próprio por classe.
+ */
+
+#ifndef RADAR_AXLE_CLASS_H
+#define RADAR_AXLE_CLASS_H
+
+#include <zephyr/kernel.h>
+#include <stdint.h>
+#include "../types.h"
+#include "calculations.h"
+
+/**
+ * @brief Linha da tabela de classes
+ */
+typedef struct {
+    vehicle_class_t vehicle_class;
+    vehicle_type_t limit;    /**< Limite aplicável (leve ou pesado) */
+    uint8_t min_axles;
+    uint8_t max_axles;
+    uint16_t first_min_mm;   /**< Janela do espaçamento eixo 1 -> eixo 2 */
+    uint16_t first_max_mm;
+    uint16_t second_min_mm;  /**< Janela do espaçamento eixo 2 -> eixo 3 */
+    uint16_t second_max_mm;
+    uint16_t rest_min_mm;    /**< Janela dos espaçamentos seguintes */
+    uint16_t rest_max_mm;
+} axle_class_rule_t;
+
+/**
+ * Maior espaçamento entre eixos consecutivos da tabela (cavalo ao eixo
+ * do semirreboque). O agrupamento de eixos do sensor 1 precisa esperar
+ * pelo menos isso para não partir um veículo classificável.
+ */
+#define AXLE_CLASS_MAX_SPACING_MM 13000
+
+/* Caminhões: entre-eixos do cavalo e espaçamentos de tandem a reboque */
+#define AXLE_CLASS_TRUCK(n)                                                     \
+    { VEHICLE_CLASS_TRUCK_##n, VEHICLE_TYPE_HEAVY, n, n, 2800, 5500,           \
+      900, AXLE_CLASS_MAX_SPACING_MM, 900, AXLE_CLASS_MAX_SPACING_MM }
+
+/** Ordem importa: a primeira linha que aceita o veículo vence */
+static const axle_class_rule_t axle_class_rules[] = {
+    { VEHICLE_CLASS_CAR,         VEHICLE_TYPE_LIGHT, 2, 2, 1800, 3400, 0, 0, 0, 0 },
+    { VEHICLE_CLASS_CAR_TRAILER, VEHICLE_TYPE_HEAVY, 3, 4, 1800, 3400, 2500, 6000, 700, 1500 },
+    { VEHICLE_CLASS_BUS,         VEHICLE_TYPE_HEAVY, 2, 3, 5500, 7500, 1000, 2000, 1000, 2000 },
+    AXLE_CLASS_TRUCK(2),
+    AXLE_CLASS_TRUCK(3),
+    AXLE_CLASS_TRUCK(4),
+    AXLE_CLASS_TRUCK(5),
+    AXLE_CLASS_TRUCK(6),
+    AXLE_CLASS_TRUCK(7),
+    AXLE_CLASS_TRUCK(8),
+    AXLE_CLASS_TRUCK(9),
+};
+
+/**
+ * @brief Converte os intervalos entre eixos em espaçamentos (mm)
+ *
+ * mm = us * (km/h / 3,6) / 1000 = us * centi_kmh / 360000
+ *
+ * @param axle_gap_us Intervalos no sensor 1 (axle_count - 1 valores)
+ * @param axle_count Eixos do veículo
+ * @param speed_centi_kmh Velocidade medida (0,01 km/h)
+ * @param spacing_mm Saída (VEHICLE_MAX_AXLES - 1 posições)
+ * @return Espaçamentos escritos (0 se mais eixos que VEHICLE_MAX_AXLES)
+ */
+static inline uint8_t axle_spacings_mm(const uint32_t *axle_gap_us, uint8_t axle_count,
+                                       uint32_t speed_centi_kmh, uint16_t *spacing_mm)
+{
+    if (axle_count < 2 || axle_count > VEHICLE_MAX_AXLES) {
+        return 0;
+    }
+
+    for (uint8_t i = 0; i < axle_count - 1; i++) {
+        uint64_t mm = ((uint64_t)axle_gap_us[i] * speed_centi_kmh + 180000U) / 360000U;
+
+        spacing_mm[i] = (mm > UINT16_MAX) ? UINT16_MAX : (uint16_t)mm;
+    }
+    return axle_count - 1;
+}
+
+/**
+ * @brief Verifica se os espaçamentos cabem nas janelas da linha
+ */
+static inline bool axle_class_rule_match(const axle_class_rule_t *rule,
+                                         const uint16_t *spacing_mm, uint8_t axle_count)
+{
+    if (axle_count < rule->min_axles || axle_count > rule->max_axles) {
+        return false;
+    }
+    if (spacing_mm[0] < rule->first_min_mm || spacing_mm[0] > rule->first_max_mm) {
+        return false;
+    }
+    if (axle_count > 2 &&
+        (spacing_mm[1] < rule->second_min_mm || spacing_mm[1] > rule->second_max_mm)) {
+        return false;
+    }
+    for (uint8_t i = 2; i < axle_count - 1; i++) {
+        if (spacing_mm[i] < rule->rest_min_mm || spacing_mm[i] > rule->rest_max_mm) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Classe do veículo pelos espaçamentos entre eixos
+ *
+ * @param spacing_mm Espaçamentos (axle_spacings_mm)
+ * @param axle_count Eixos do veículo
+ * @return Classe, ou VEHICLE_CLASS_UNKNOWN
+ */
+static inline vehicle_class_t classify_axles(const uint16_t *spacing_mm, uint8_t axle_count)
+{
+    if (axle_count < 2 || axle_count > VEHICLE_MAX_AXLES) {
+        return VEHICLE_CLASS_UNKNOWN;
+    }
+
+    for (size_t i = 0; i < ARRAY_SIZE(axle_class_rules); i++) {
+        if (axle_class_rule_match(&axle_class_rules[i], spacing_mm, axle_count)) {
+            return axle_class_rules[i].vehicle_class;
+        }
+    }
+    return VEHICLE_CLASS_UNKNOWN;
+}
+
+/**
+ * @brief Tipo (limite aplicável) da classe
+ *
+ * Classe desconhecida cai na regra por número de eixos.
+ */
+static inline vehicle_type_t vehicle_class_type(vehicle_class_t vehicle_class,
+                                                uint8_t axle_count)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(axle_class_rules); i++) {
+        if (axle_class_rules[i].vehicle_class == vehicle_class) {
+            return axle_class_rules[i].limit;
+        }
+    }
+    return classify_vehicle(axle_count);
+}
+
+/**
+ * @brief Nome curto da classe (logs e shell)
+ */
+static inline const char *vehicle_class_name(vehicle_class_t vehicle_class)
+{
+    static const char *const names[VEHICLE_CLASS_COUNT] = {
+        "DESCONHECIDA", "CARRO", "CARRO+REBOQUE", "ONIBUS",
+        "CAMINHAO 2E", "CAMINHAO 3E", "CAMINHAO 4E", "CAMINHAO 5E",
+        "CAMINHAO 6E", "CAMINHAO 7E", "CAMINHAO 8E", "CAMINHAO 9E",
+    };
+
+    return (vehicle_class < VEHICLE_CLASS_COUNT) ? names[vehicle_class] : "?";
+}
+
+#endif /* RADAR_AXLE_CLASS_H */
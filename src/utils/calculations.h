@@ -11,6 +11,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <zephyr/sys/util.h>
 #include "../types.h"
 
 /**
@@ -37,6 +38,107 @@ static inline uint32_t calculate_speed_kmh(uint32_t time_delta_ms, uint32_t dist
     return (uint32_t)speed;
 }
 
+/**
+ * @brief Calcula velocidade em centésimos de km/h (ponto fixo)
+ * 
+ * Versão de alta resolução usada no caminho de detecção: o tempo vem
+ * do contador de ciclos convertido para microssegundos, e o resultado
+ * tem resolução de 0,01 km/h (ex: 12034 = 120,34 km/h).
+ * 
+ * Fórmula: km/h = (mm / us) * 3600  →  centésimos = (mm * 360000) / us
+ * 
+ * @param time_delta_us Tempo entre sensores em microssegundos
+ * @param distance_mm Distância entre sensores em milímetros
+ * @return Velocidade em centésimos de km/h (truncada)
+ */
+static inline uint32_t calculate_speed_centi_kmh(uint32_t time_delta_us, uint32_t distance_mm)
+{
+    if (time_delta_us == 0) {
+        return 0; /* Evita divisão por zero */
+    }
+    
+    uint64_t speed = ((uint64_t)distance_mm * 360000U) / time_delta_us;
+    return (speed > UINT32_MAX) ? UINT32_MAX : (uint32_t)speed;
+}
+
+/*
+ * Tabela de recíprocos para calculate_speed_centi_kmh_fast()
+ *
+ * Entrada i ≈ 2^63 / x, com x no meio do intervalo [(128 + i) * 2^24,
+ * (129 + i) * 2^24) dos divisores normalizados (bit 31 em 1). Gerada
+ * pelo compilador: 2^63 / ((257 + 2i) * 2^23) = 2^40 / (257 + 2i).
+ */
+#define SPEED_RECIP_TABLE_BITS 7
+#define SPEED_RECIP_ENTRY(i, _) (uint32_t)((UINT64_C(1) << 40) / (257U + 2U * (i)))
+
+/**
+ * @brief Recíproco de um divisor normalizado, sem divisão
+ * 
+ * Estimativa inicial da tabela (erro < 2^-8) refinada por duas
+ * iterações de Newton-Raphson (erro < 2^-28).
+ * 
+ * @param x Divisor normalizado (bit 31 em 1)
+ * @return Aproximação de 2^63 / x
+ */
+static inline uint64_t speed_reciprocal(uint32_t x)
+{
+    static const uint32_t recip_table[1U << SPEED_RECIP_TABLE_BITS] = {
+        LISTIFY(128, SPEED_RECIP_ENTRY, (,))
+    };
+    int64_t y = recip_table[(x >> (31 - SPEED_RECIP_TABLE_BITS)) - (1U << SPEED_RECIP_TABLE_BITS)];
+    
+    for (int i = 0; i < 2; i++) {
+        /* y += y * (2^63 - x*y) / 2^63; x*y < 2^64 pois y < 2^32 */
+        uint64_t p = (uint64_t)x * (uint64_t)MIN(y, (int64_t)UINT32_MAX);
+        int64_t d = (int64_t)((UINT64_C(1) << 63) - p);
+        
+        y += ((d >> 31) * y) >> 32;
+    }
+    
+    return (uint64_t)MIN(y, (int64_t)UINT32_MAX);
+}
+
+/**
+ * @brief Calcula velocidade em centésimos de km/h sem divisão
+ * 
+ * Idêntica bit a bit a calculate_speed_centi_kmh(), mas usa
+ * multiplicação pelo recíproco do tempo: o Cortex-M3 não tem divisão
+ * de 64 bits em hardware e a de calculate_speed_centi_kmh() vira uma
+ * chamada à libgcc. distance_mm vem do snapshot de configuração em
+ * tempo de execução, então o numerador é calculado a cada chamada (uma
+ * multiplicação de 32x32 bits).
+ * 
+ * Faixa válida: numerador (distance_mm * 360000) < 2^32, ou seja,
+ * distâncias até 11930 mm; fora dela usa calculate_speed_centi_kmh().
+ * 
+ * @param time_delta_us Tempo entre sensores em microssegundos
+ * @param distance_mm Distância entre sensores em milímetros
+ * @return Velocidade em centésimos de km/h (truncada)
+ */
+static inline uint32_t calculate_speed_centi_kmh_fast(uint32_t time_delta_us, uint32_t distance_mm)
+{
+    uint64_t numerator = (uint64_t)distance_mm * 360000U;
+    
+    if (time_delta_us == 0 || numerator > UINT32_MAX) {
+        return calculate_speed_centi_kmh(time_delta_us, distance_mm);
+    }
+    
+    /* N / t = N * 2^n / x, com x = t << n normalizado */
+    uint32_t n = (uint32_t)__builtin_clz(time_delta_us);
+    uint32_t x = time_delta_us << n;
+    uint64_t q = (numerator * speed_reciprocal(x)) >> (63 - n);
+    
+    /* Corrige o erro residual do recíproco (no máximo uma unidade) */
+    while (q * time_delta_us > numerator) {
+        q--;
+    }
+    while ((q + 1) * time_delta_us <= numerator) {
+        q++;
+    }
+    
+    return (uint32_t)q;
+}
+
 /**
  * @brief Classifica o veículo baseado no número de eixos
  * 
@@ -74,12 +176,39 @@ static inline speed_status_t determine_speed_status(uint32_t speed_kmh,
     return SPEED_STATUS_NORMAL;
 }
 
+/**
+ * @brief Determina o status a partir da velocidade em centésimos de km/h
+ * 
+ * Equivalente a determine_speed_status(), mas sem truncar a velocidade
+ * medida nem o limiar de alerta para km/h inteiros.
+ * 
+ * @param speed_centi_kmh Velocidade medida (centésimos de km/h)
+ * @param speed_limit Limite de velocidade aplicável (km/h)
+ * @param warning_threshold_percent Percentual do limite para alerta (ex: 90)
+ * @return Status da velocidade
+ */
+static inline speed_status_t determine_speed_status_centi(uint32_t speed_centi_kmh,
+                                                           uint32_t speed_limit,
+                                                           uint32_t warning_threshold_percent)
+{
+    if ((uint64_t)speed_centi_kmh >= (uint64_t)speed_limit * 100U) {
+        return SPEED_STATUS_VIOLATION;
+    }
+    
+    /* limite * threshold% em centésimos = limite * threshold */
+    if ((uint64_t)speed_centi_kmh >= (uint64_t)speed_limit * warning_threshold_percent) {
+        return SPEED_STATUS_WARNING;
+    }
+    
+    return SPEED_STATUS_NORMAL;
+}
+
 /**
  * @brief Obtém o limite de velocidade baseado no tipo de veículo
  * 
  * @param vehicle_type Tipo do veículo
- * @param light_limit Limite para veículos leves (do Kconfig)
- * @param heavy_limit Limite para veículos pesados (do Kconfig)
+ * @param light_limit Limite para veículos leves (snapshot de radar_config)
+ * @param heavy_limit Limite para veículos pesados (snapshot de radar_config)
  * @return Limite de velocidade aplicável
  */
 static inline uint32_t get_speed_limit(vehicle_type_t vehicle_type,
@@ -0,0 +1,106 @@
+/**
+ * @file capture_inflight.h
+ * @brief Requisições de captura em andamento no camera_service
+ *
+ * Os eventos de chan_camera_evt não carregam identificador; como o
+ * camera_service atende as capturas em ordem, cada evento pertence à
+ * requisição mais antiga ainda em andamento (FIFO).
+ *
+ * Cada entrada guarda o seu prazo (o mesmo timeout passado ao
+ * camera_service). Uma requisição vencida pode ter sido perdida ou
+ * pode ainda receber o evento atrasado; os dois casos são
+ * indistinguíveis. Por isso, se a retirada encontra entradas vencidas
+ * na frente, elas são descartadas e o evento é tratado como atrasado:
+ * nenhuma requisição recebe o resultado, em vez de arriscar a placa de
+ * um veículo em outro. A requisição seguinte continua na fila.
+ *
+ * Não é thread-safe: o chamador serializa o acesso (camera_thread.c
+ * usa um spinlock, pois push e pop rodam em threads diferentes).
+ */
+
+#ifndef RADAR_CAPTURE_INFLIGHT_H
+#define RADAR_CAPTURE_INFLIGHT_H
+
+#include <zephyr/kernel.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Capturas simultâneas aguardando evento do camera_service */
+#define CAPTURE_INFLIGHT_MAX 8
+
+struct capture_inflight {
+    uint32_t ids[CAPTURE_INFLIGHT_MAX];     /**< request_id da captura */
+    int64_t deadline[CAPTURE_INFLIGHT_MAX]; /**< k_uptime_get() limite do evento */
+    uint8_t head;                           /**< Entrada mais antiga */
+    uint8_t count;                          /**< Entradas em andamento */
+};
+
+/**
+ * @brief Inicializa a fila vazia
+ */
+static inline void capture_inflight_init(struct capture_inflight *q)
+{
+    q->head = 0;
+    q->count = 0;
+}
+
+/**
+ * @brief Enfileira a requisição antes de acionar o camera_service
+ *
+ * @return false se a fila está cheia
+ */
+static inline bool capture_inflight_push(struct capture_inflight *q, uint32_t request_id,
+                                         int64_t deadline)
+{
+    if (q->count >= CAPTURE_INFLIGHT_MAX) {
+        return false;
+    }
+
+    uint8_t tail = (q->head + q->count) % CAPTURE_INFLIGHT_MAX;
+
+    q->ids[tail] = request_id;
+    q->deadline[tail] = deadline;
+    q->count++;
+    return true;
+}
+
+/**
+ * @brief Desfaz o último push (captura não foi aceita pelo camera_service)
+ */
+static inline void capture_inflight_drop_last(struct capture_inflight *q)
+{
+    if (q->count > 0) {
+        q->count--;
+    }
+}
+
+/**
+ * @brief Casa um evento com a requisição mais antiga em andamento
+ *
+ * @param now k_uptime_get() da chegada do evento
+ * @param expired Saída: requisições vencidas descartadas
+ * @return Identificador da requisição, ou 0 se não há requisição em
+ *         andamento ou se o evento é atrasado (*expired > 0)
+ */
+static inline uint32_t capture_inflight_pop(struct capture_inflight *q, int64_t now,
+                                            uint32_t *expired)
+{
+    *expired = 0;
+    while (q->count > 0 && q->deadline[q->head] < now) {
+        q->head = (q->head + 1) % CAPTURE_INFLIGHT_MAX;
+        q->count--;
+        (*expired)++;
+    }
+
+    if (*expired != 0 || q->count == 0) {
+        return 0;
+    }
+
+    uint32_t request_id = q->ids[q->head];
+
+    q->head = (q->head + 1) % CAPTURE_INFLIGHT_MAX;
+    q->count--;
+    return request_id;
+}
+
+#endif /* RADAR_CAPTURE_INFLIGHT_H */
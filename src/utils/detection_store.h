@@ -0,0 +1,273 @@
+/**
+ * @file detection_store.h
+ * @brief Armazenamento colunar das detecções recentes
+ *
+ * Buffer circular de capacidade fixa em formato structure-of-arrays:
+ * cada campo (timestamp, velocidade, limite, classe, faixa, placa) é
+ * uma coluna separada, então as consultas varrem só as colunas que
+ * usam. A inserção é O(1) e não aloca memória.
+ *
+ * Concorrência: um único escritor (thread principal) insere e também
+ * preenche a placa; o estágio de captura envia a placa à thread
+ * principal em vez de escrever aqui. Leitores não travam nada: cada
+ * posição tem um número de sequência, que identifica o registro, e uma
+ * geração, que o escritor incrementa antes (fica ímpar) e depois (volta
+ * a par) de cada escrita, inclusive a da placa. A placa tem 64 bits e
+ * não é gravada atomicamente no Cortex-M3; como a sequência não muda
+ * quando ela é preenchida, é a geração que denuncia a leitura cortada.
+ */
+
+#ifndef RADAR_DETECTION_STORE_H
+#define RADAR_DETECTION_STORE_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../types.h"
+
+#ifdef CONFIG_RADAR_DETECTION_STORE_SIZE
+#define DETECTION_STORE_CAPACITY CONFIG_RADAR_DETECTION_STORE_SIZE
+#else
+#define DETECTION_STORE_CAPACITY 256
+#endif
+
+BUILD_ASSERT(IS_POWER_OF_TWO(DETECTION_STORE_CAPACITY),
+             "DETECTION_STORE_CAPACITY deve ser potência de 2");
+
+/** Sequência de uma posição em escrita (ou nunca escrita) */
+#define DETECTION_SEQ_INVALID 0U
+
+/**
+ * @brief Colunas das detecções recentes
+ *
+ * Sequências começam em 1; a posição de uma sequência é
+ * seq % DETECTION_STORE_CAPACITY.
+ */
+struct detection_store {
+    atomic_t seq[DETECTION_STORE_CAPACITY];          /**< Sequência gravada na posição */
+    atomic_t gen[DETECTION_STORE_CAPACITY];          /**< Geração (ímpar durante escrita) */
+    uint32_t timestamp_ms[DETECTION_STORE_CAPACITY]; /**< k_uptime_get_32() da detecção */
+    uint16_t speed_centi_kmh[DETECTION_STORE_CAPACITY]; /**< Velocidade (0,01 km/h, saturada) */
+    uint8_t limit_kmh[DETECTION_STORE_CAPACITY];     /**< Limite aplicado */
+    uint8_t vehicle_type[DETECTION_STORE_CAPACITY];  /**< vehicle_type_t */
+    uint8_t lane_id[DETECTION_STORE_CAPACITY];       /**< Faixa */
+    uint64_t plate_key[DETECTION_STORE_CAPACITY];    /**< plate_pack_key(), 0 = sem placa */
+    atomic_t head;                                   /**< Última sequência publicada */
+};
+
+/**
+ * @brief Inicializa o armazenamento vazio
+ */
+static inline void detection_store_init(struct detection_store *store)
+{
+    for (uint32_t i = 0; i < DETECTION_STORE_CAPACITY; i++) {
+        atomic_set(&store->seq[i], DETECTION_SEQ_INVALID);
+        atomic_set(&store->gen[i], 0);
+    }
+    atomic_set(&store->head, 0);
+}
+
+/**
+ * @brief Insere uma detecção (apenas o escritor)
+ *
+ * @return Sequência do registro (para detection_store_set_plate)
+ */
+static inline uint32_t detection_store_append(struct detection_store *store,
+                                              uint32_t timestamp_ms,
+                                              uint32_t speed_centi_kmh,
+                                              uint32_t limit_kmh,
+                                              vehicle_type_t vehicle_type,
+                                              uint8_t lane_id)
+{
+    uint32_t seq = (uint32_t)atomic_get(&store->head) + 1;
+
+    if (seq == DETECTION_SEQ_INVALID) {
+        seq++;
+    }
+
+    uint32_t slot = seq & (DETECTION_STORE_CAPACITY - 1);
+
+    /* Invalida a posição antes de sobrescrever (leitores descartam) */
+    atomic_inc(&store->gen[slot]);
+    atomic_set(&store->seq[slot], DETECTION_SEQ_INVALID);
+
+    store->timestamp_ms[slot] = timestamp_ms;
+    store->speed_centi_kmh[slot] = (uint16_t)MIN(speed_centi_kmh, UINT16_MAX);
+    store->limit_kmh[slot] = (uint8_t)MIN(limit_kmh, UINT8_MAX);
+    store->vehicle_type[slot] = (uint8_t)vehicle_type;
+    store->lane_id[slot] = lane_id;
+    store->plate_key[slot] = 0;
+
+    atomic_set(&store->seq[slot], (atomic_val_t)seq);
+    atomic_inc(&store->gen[slot]);
+    atomic_set(&store->head, (atomic_val_t)seq);
+
+    return seq;
+}
+
+/**
+ * @brief Registra a placa capturada de uma detecção (apenas o escritor)
+ *
+ * @return false se o registro já foi sobrescrito
+ */
+static inline bool detection_store_set_plate(struct detection_store *store,
+                                             uint32_t seq, uint64_t plate_key)
+{
+    uint32_t slot = seq & (DETECTION_STORE_CAPACITY - 1);
+
+    if ((uint32_t)atomic_get(&store->seq[slot]) != seq) {
+        return false;
+    }
+
+    atomic_inc(&store->gen[slot]);
+    store->plate_key[slot] = plate_key;
+    atomic_inc(&store->gen[slot]);
+    return true;
+}
+
+/**
+ * @brief Inicia a leitura de um registro (qualquer thread)
+ *
+ * @param gen Saída: geração a conferir em detection_store_read_retry()
+ * @return false se o registro foi sobrescrito ou está sendo escrito
+ */
+static inline bool detection_store_read_begin(const struct detection_store *store,
+                                              uint32_t seq, atomic_val_t *gen)
+{
+    uint32_t slot = seq & (DETECTION_STORE_CAPACITY - 1);
+
+    *gen = atomic_get(&store->gen[slot]);
+
+    return (*gen & 1) == 0 && (uint32_t)atomic_get(&store->seq[slot]) == seq;
+}
+
+/**
+ * @brief Confere se o registro mudou desde detection_store_read_begin()
+ *
+ * @return true se houve escrita no meio (os dados lidos não valem)
+ */
+static inline bool detection_store_read_retry(const struct detection_store *store,
+                                              uint32_t seq, atomic_val_t gen)
+{
+    uint32_t slot = seq & (DETECTION_STORE_CAPACITY - 1);
+
+    return atomic_get(&store->gen[slot]) != gen ||
+           (uint32_t)atomic_get(&store->seq[slot]) != seq;
+}
+
+/**
+ * @brief Lê a placa de uma detecção (qualquer thread)
+ *
+ * @param plate_key Saída: plate_pack_key(), 0 = sem placa
+ * @return false se o registro foi sobrescrito ou estava sendo escrito
+ */
+static inline bool detection_store_get_plate(const struct detection_store *store,
+                                             uint32_t seq, uint64_t *plate_key)
+{
+    atomic_val_t gen;
+
+    if (!detection_store_read_begin(store, seq, &gen)) {
+        return false;
+    }
+
+    *plate_key = store->plate_key[seq & (DETECTION_STORE_CAPACITY - 1)];
+
+    return !detection_store_read_retry(store, seq, gen);
+}
+
+/** Sequência atualmente publicada em uma posição */
+#define DETECTION_STORE_SEQ(store, slot) ((uint32_t)atomic_get(&(store)->seq[(slot)]))
+
+/*
+ * As consultas abaixo varrem da detecção mais recente para a mais
+ * antiga, lendo as colunas no lugar. A sequência da posição é conferida
+ * antes e depois da leitura; se mudou, o escritor alcançou a varredura
+ * e os registros restantes já foram (ou estão sendo) sobrescritos.
+ */
+
+/**
+ * @brief Conta infrações nos últimos window_ms milissegundos
+ *
+ * @param now_ms k_uptime_get_32() atual
+ * @param lane_id Faixa (ou -1 para todas)
+ */
+static inline uint32_t detection_store_count_violations(const struct detection_store *store,
+                                                        uint32_t now_ms, uint32_t window_ms,
+                                                        int lane_id)
+{
+    uint32_t head = (uint32_t)atomic_get(&store->head);
+    uint32_t count = 0;
+
+    for (uint32_t n = 0; n < DETECTION_STORE_CAPACITY && head - n != DETECTION_SEQ_INVALID; n++) {
+        uint32_t seq = head - n;
+        uint32_t slot = seq & (DETECTION_STORE_CAPACITY - 1);
+
+        if (DETECTION_STORE_SEQ(store, slot) != seq) {
+            break; /* Sobrescrito pelo escritor: registros mais antigos também */
+        }
+
+        uint32_t age = now_ms - store->timestamp_ms[slot];
+        bool violation = (uint32_t)store->speed_centi_kmh[slot] >=
+                         (uint32_t)store->limit_kmh[slot] * 100U;
+        bool lane_ok = (lane_id < 0) || (store->lane_id[slot] == (uint8_t)lane_id);
+
+        if (DETECTION_STORE_SEQ(store, slot) != seq) {
+            break;
+        }
+
+        /* Registros estão em ordem de tempo: fora da janela, para */
+        if (age > window_ms) {
+            break;
+        }
+
+        if (violation && lane_ok) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Velocidade máxima por classe de veículo
+ *
+ * @param max_centi_kmh Saída, indexada por vehicle_type_t
+ *        (VEHICLE_TYPE_COUNT posições; 0 se não houve veículo da classe)
+ * @return Número de registros varridos
+ */
+static inline uint32_t detection_store_max_speed_by_class(const struct detection_store *store,
+                                                          uint32_t max_centi_kmh[])
+{
+    uint32_t head = (uint32_t)atomic_get(&store->head);
+    uint32_t scanned = 0;
+
+    for (int t = 0; t < VEHICLE_TYPE_COUNT; t++) {
+        max_centi_kmh[t] = 0;
+    }
+
+    for (uint32_t n = 0; n < DETECTION_STORE_CAPACITY && head - n != DETECTION_SEQ_INVALID; n++) {
+        uint32_t seq = head - n;
+        uint32_t slot = seq & (DETECTION_STORE_CAPACITY - 1);
+
+        if (DETECTION_STORE_SEQ(store, slot) != seq) {
+            break;
+        }
+
+        uint8_t type = store->vehicle_type[slot];
+        uint32_t speed = store->speed_centi_kmh[slot];
+
+        if (DETECTION_STORE_SEQ(store, slot) != seq) {
+            break;
+        }
+
+        if (type < VEHICLE_TYPE_COUNT && speed > max_centi_kmh[type]) {
+            max_centi_kmh[type] = speed;
+        }
+        scanned++;
+    }
+
+    return scanned;
+}
+
+#endif /* RADAR_DETECTION_STORE_H */
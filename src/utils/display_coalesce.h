@@ -0,0 +1,127 @@
+/**
+ * @file display_coalesce.h
+ * @brief Fusão de quadros do display por faixa (o mais recente vence)
+ *
+ * Com tráfego intenso, a fila do display acumula quadros que já estão
+ * velhos quando chegam à tela. Cada faixa guarda apenas seu último
+ * estado; a thread de display drena a fila, funde as mensagens aqui e
+ * desenha somente o veículo mais recente, no máximo uma vez por período
+ * de atualização. Quadros substituídos antes de serem desenhados são
+ * contados como pulados.
+ */
+
+#ifndef RADAR_DISPLAY_COALESCE_H
+#define RADAR_DISPLAY_COALESCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../types.h"
+
+/** Faixas com estado próprio; faixas acima compartilham posições */
+#define DISPLAY_COALESCE_LANES 8
+
+/**
+ * @brief Resultado de display_coalescer_offer
+ */
+typedef enum {
+    DISPLAY_OFFER_NEW = 0,   /**< Novo veículo na faixa */
+    DISPLAY_OFFER_MERGED,    /**< Atualização do veículo já pendente/exibido (placa) */
+    DISPLAY_OFFER_STALE,     /**< Veículo já substituído na faixa: descartada */
+} display_offer_t;
+
+struct display_coalescer {
+    display_data_msg_t latest[DISPLAY_COALESCE_LANES]; /**< Último estado de cada faixa */
+    uint32_t valid;      /**< Faixas com algum estado (bit por faixa) */
+    uint32_t pending;    /**< Faixas com estado ainda não desenhado */
+    uint32_t skipped;    /**< Quadros substituídos sem serem desenhados */
+};
+
+static inline void display_coalescer_init(struct display_coalescer *c)
+{
+    c->valid = 0;
+    c->pending = 0;
+    c->skipped = 0;
+}
+
+/**
+ * @brief Veículo a é anterior a b? (tolera o wrap-around do seq)
+ */
+static inline bool display_seq_before(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) < 0;
+}
+
+/**
+ * @brief Funde uma mensagem no estado da sua faixa
+ *
+ * A mensagem de um veículo novo substitui o estado da faixa (se o
+ * anterior ainda não foi desenhado, conta um quadro pulado); a de placa
+ * do mesmo veículo (mesmo seq) atualiza o estado sem contar.
+ */
+static inline display_offer_t display_coalescer_offer(struct display_coalescer *c,
+                                                      const display_data_msg_t *msg)
+{
+    uint32_t slot = msg->lane_id % DISPLAY_COALESCE_LANES;
+    uint32_t bit = 1U << slot;
+    display_data_msg_t *latest = &c->latest[slot];
+    display_offer_t result = DISPLAY_OFFER_NEW;
+
+    if (c->valid & bit) {
+        if (display_seq_before(msg->seq, latest->seq)) {
+            return DISPLAY_OFFER_STALE;
+        }
+        if (msg->seq == latest->seq) {
+            result = DISPLAY_OFFER_MERGED;
+        } else if (c->pending & bit) {
+            c->skipped++;
+        }
+    }
+
+    *latest = *msg;
+    c->valid |= bit;
+    c->pending |= bit;
+    return result;
+}
+
+static inline bool display_coalescer_pending(const struct display_coalescer *c)
+{
+    return c->pending != 0;
+}
+
+/**
+ * @brief Retira o quadro a desenhar: o veículo mais recente entre as faixas
+ *
+ * Estados pendentes de outras faixas, mais antigos, seriam
+ * imediatamente cobertos no display: são descartados e contados como
+ * pulados (o estado continua disponível em latest).
+ *
+ * @return false se não há nada pendente
+ */
+static inline bool display_coalescer_take(struct display_coalescer *c,
+                                          display_data_msg_t *out)
+{
+    int newest = -1;
+
+    for (int l = 0; l < DISPLAY_COALESCE_LANES; l++) {
+        if ((c->pending & (1U << l)) &&
+            (newest < 0 || display_seq_before(c->latest[newest].seq, c->latest[l].seq))) {
+            newest = l;
+        }
+    }
+
+    if (newest < 0) {
+        return false;
+    }
+
+    for (int l = 0; l < DISPLAY_COALESCE_LANES; l++) {
+        if (l != newest && (c->pending & (1U << l))) {
+            c->skipped++;
+        }
+    }
+
+    *out = c->latest[newest];
+    c->pending = 0;
+    return true;
+}
+
+#endif /* RADAR_DISPLAY_COALESCE_H */
@@ -0,0 +1,139 @@
+/**
+ * @file display_format.h
+ * @brief Formatação do quadro do display
+ * 
+ * Monta o quadro exibido pela thread de display, com cores ANSI
+ * (verde/amarelo/vermelho) e campos de largura fixa.
+ */
+
+#ifndef RADAR_DISPLAY_FORMAT_H
+#define RADAR_DISPLAY_FORMAT_H
+
+#include <stdio.h>
+#include <string.h>
+#include "../types.h"
+
+/* Códigos de cores ANSI para o console */
+#define ANSI_COLOR_GREEN   "\x1b[32m"
+#define ANSI_COLOR_YELLOW  "\x1b[33m"
+#define ANSI_COLOR_RED     "\x1b[31m"
+#define ANSI_COLOR_RESET   "\x1b[0m"
+#define ANSI_BOLD          "\x1b[1m"
+
+/** Tamanho suficiente para qualquer quadro */
+#define DISPLAY_FRAME_MAX_LEN 700
+
+/**
+ * @brief Retorna o código de cor baseado no status
+ */
+static inline const char* get_color_code(speed_status_t status)
+{
+    switch (status) {
+    case SPEED_STATUS_NORMAL:
+        return ANSI_COLOR_GREEN;
+    case SPEED_STATUS_WARNING:
+        return ANSI_COLOR_YELLOW;
+    case SPEED_STATUS_VIOLATION:
+        return ANSI_COLOR_RED;
+    default:
+        return ANSI_COLOR_RESET;
+    }
+}
+
+/**
+ * @brief Retorna o texto do status
+ */
+static inline const char* get_status_text(speed_status_t status)
+{
+    switch (status) {
+    case SPEED_STATUS_NORMAL:
+        return "NORMAL";
+    case SPEED_STATUS_WARNING:
+        return "ALERTA";
+    case SPEED_STATUS_VIOLATION:
+        return "INFRACAO";
+    default:
+        return "DESCONHECIDO";
+    }
+}
+
+/**
+ * @brief Retorna o tipo do veículo como texto
+ */
+static inline const char* get_vehicle_type_text(vehicle_type_t type)
+{
+    return (type == VEHICLE_TYPE_LIGHT) ? "LEVE" : "PESADO";
+}
+
+/**
+ * @brief Formata o quadro do display (com cores ANSI)
+ * 
+ * @param display_buffer Destino do quadro
+ * @param size Tamanho do destino (DISPLAY_FRAME_MAX_LEN é suficiente)
+ * @param data Dados do veículo
+ * @return Comprimento do quadro (como snprintf)
+ */
+static inline int format_display_frame(char *display_buffer, size_t size,
+                                       const display_data_msg_t *data)
+{
+    const char *color = get_color_code(data->status);
+    const char *status_text = get_status_text(data->status);
+    const char *vehicle_text = get_vehicle_type_text(data->vehicle_type);
+    
+    /* Se tem placa, mostra quadro com placa; senão, sem placa */
+    if (data->plate[0] != '\0') {
+        /* Verifica se é código de erro */
+        const char *plate_color = ANSI_BOLD;
+        if (strncmp(data->plate, "ERR", 3) == 0) {
+            plate_color = ANSI_COLOR_RED;  /* Erros em vermelho */
+        }
+        
+        /* Monta strings com largura fixa ANTES de adicionar cores */
+        char vel_str[40], status_str[40], limit_str[40];
+        snprintf(vel_str, sizeof(vel_str), "%3u.%02u km/h",
+                 data->speed_centi_kmh / 100, data->speed_centi_kmh % 100);
+        snprintf(status_str, sizeof(status_str), "%-10s", status_text);
+        snprintf(limit_str, sizeof(limit_str), "%3u km/h", data->speed_limit);
+        
+        return snprintf(display_buffer, size,
+                        "\n"
+                        "+========================================+\n"
+                        "|        RADAR ELETRONICO                |\n"
+                        "+========================================+\n"
+                        "| Tipo:       %-27s|\n"
+                        "| Velocidade: %s%s%-27s%s|\n"
+                        "| Limite:     %-27s|\n"
+                        "| Status:     %s%s%-27s%s|\n"
+                        "| Placa:      %s%-27s%s|\n"
+                        "+========================================+\n",
+                        vehicle_text,
+                        ANSI_BOLD, color, vel_str, ANSI_COLOR_RESET,
+                        limit_str,
+                        ANSI_BOLD, color, status_str, ANSI_COLOR_RESET,
+                        plate_color, data->plate, ANSI_COLOR_RESET);
+    } else {
+        /* Monta strings com largura fixa ANTES de adicionar cores */
+        char vel_str[40], status_str[40], limit_str[40];
+        snprintf(vel_str, sizeof(vel_str), "%3u.%02u km/h",
+                 data->speed_centi_kmh / 100, data->speed_centi_kmh % 100);
+        snprintf(status_str, sizeof(status_str), "%-10s", status_text);
+        snprintf(limit_str, sizeof(limit_str), "%3u km/h", data->speed_limit);
+        
+        return snprintf(display_buffer, size,
+                        "\n"
+                        "+========================================+\n"
+                        "|        RADAR ELETRONICO                |\n"
+                        "+========================================+\n"
+                        "| Tipo:       %-27s|\n"
+                        "| Velocidade: %s%s%-27s%s|\n"
+                        "| Limite:     %-27s|\n"
+                        "| Status:     %s%s%-27s%s|\n"
+                        "+========================================+\n",
+                        vehicle_text,
+                        ANSI_BOLD, color, vel_str, ANSI_COLOR_RESET,
+                        limit_str,
+                        ANSI_BOLD, color, status_str, ANSI_COLOR_RESET);
+    }
+}
+
+#endif /* RADAR_DISPLAY_FORMAT_H */
@@ -0,0 +1,280 @@
+/**
+ * @file display_render.h
+ * @brief Renderização incremental do display no console ANSI
+ *
+ * O quadro é desenhado uma única vez (display_render_template) no topo
+ * do terminal, com a área de rolagem restrita às linhas abaixo dele:
+ * os logs rolam sem deslocar o quadro. Cada campo tem posição e
+ * largura fixas; display_render_update compara com o que já está na
+ * tela e emite, com endereçamento de cursor, apenas os campos que
+ * mudaram (uma placa capturada reescreve só a linha da placa).
+ *
+ * A atualização não usa snprintf: números e textos são copiados
+ * direto para o buffer de saída.
+ */
+
+#ifndef RADAR_DISPLAY_RENDER_H
+#define RADAR_DISPLAY_RENDER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "../types.h"
+#include "display_format.h"
+
+/** Sequências ANSI de controle */
+#define ANSI_CLEAR_SCREEN  "\x1b[2J"
+#define ANSI_SAVE_CURSOR   "\x1b" "7"
+#define ANSI_RESTORE_CURSOR "\x1b" "8"
+
+/** Largura dos campos do quadro */
+#define DISPLAY_FIELD_WIDTH 27
+
+/** Coluna (1-based) onde os campos começam: "| Velocidade: " */
+#define DISPLAY_FIELD_COL 15
+
+/** Linhas ocupadas pelo quadro; os logs rolam a partir da seguinte (10) */
+#define DISPLAY_FRAME_ROWS 9
+
+/** Tamanho suficiente para o template e para qualquer atualização */
+#define DISPLAY_TEMPLATE_MAX_LEN 512
+#define DISPLAY_UPDATE_MAX_LEN 320
+
+/**
+ * @brief Campos atualizáveis do quadro
+ */
+typedef enum {
+    DISPLAY_FIELD_TYPE = 0,
+    DISPLAY_FIELD_SPEED,
+    DISPLAY_FIELD_LIMIT,
+    DISPLAY_FIELD_STATUS,
+    DISPLAY_FIELD_PLATE,
+    DISPLAY_FIELD_COUNT
+} display_field_t;
+
+/** Linha (1-based) de cada campo */
+static const uint8_t display_field_row[DISPLAY_FIELD_COUNT] = {
+    [DISPLAY_FIELD_TYPE] = 4,
+    [DISPLAY_FIELD_SPEED] = 5,
+    [DISPLAY_FIELD_LIMIT] = 6,
+    [DISPLAY_FIELD_STATUS] = 7,
+    [DISPLAY_FIELD_PLATE] = 8,
+};
+
+/**
+ * @brief Conteúdo atualmente na tela
+ */
+struct display_renderer {
+    bool drawn;                /**< Algum veículo já foi exibido */
+    display_data_msg_t shown;  /**< Dados exibidos */
+};
+
+/**
+ * @brief Escreve o quadro vazio e fixa a área de rolagem abaixo dele
+ *
+ * @return Comprimento escrito (sem o \0), ou 0 se não couber
+ */
+static inline size_t display_render_template(char *buf, size_t size)
+{
+    static const char template_text[] =
+        ANSI_CLEAR_SCREEN "\x1b[H"
+        "+========================================+\n"
+        "|        RADAR ELETRONICO                |\n"
+        "+========================================+\n"
+        "| Tipo:                                  |\n"
+        "| Velocidade:                            |\n"
+        "| Limite:                                |\n"
+        "| Status:                                |\n"
+        "| Placa:                                 |\n"
+        "+========================================+\n"
+        /* Rolagem só abaixo do quadro; cursor na primeira linha livre */
+        "\x1b[10r" "\x1b[10;1H";
+
+    if (size < sizeof(template_text)) {
+        return 0;
+    }
+
+    memcpy(buf, template_text, sizeof(template_text));
+    return sizeof(template_text) - 1;
+}
+
+static inline void display_renderer_init(struct display_renderer *renderer)
+{
+    renderer->drawn = false;
+}
+
+/**
+ * @brief Escreve um inteiro em decimal, alinhado à direita
+ *
+ * @return Ponteiro após o último caractere escrito
+ */
+static inline char *display_put_uint(char *p, uint32_t value, int min_width, char pad)
+{
+    char digits[10];
+    int n = 0;
+
+    do {
+        digits[n++] = (char)('0' + value % 10U);
+        value /= 10U;
+    } while (value != 0);
+
+    for (int i = n; i < min_width; i++) {
+        *p++ = pad;
+    }
+    while (n > 0) {
+        *p++ = digits[--n];
+    }
+    return p;
+}
+
+static inline char *display_put_str(char *p, const char *s)
+{
+    size_t len = strlen(s);
+
+    memcpy(p, s, len);
+    return p + len;
+}
+
+/**
+ * @brief Negrito + cor do status (campos de velocidade e status)
+ */
+static inline const char *display_status_style(speed_status_t status)
+{
+    switch (status) {
+    case SPEED_STATUS_NORMAL:
+        return ANSI_BOLD ANSI_COLOR_GREEN;
+    case SPEED_STATUS_WARNING:
+        return ANSI_BOLD ANSI_COLOR_YELLOW;
+    case SPEED_STATUS_VIOLATION:
+        return ANSI_BOLD ANSI_COLOR_RED;
+    default:
+        return ANSI_BOLD;
+    }
+}
+
+/**
+ * @brief Escreve o texto de um campo com exatamente DISPLAY_FIELD_WIDTH colunas
+ *
+ * @return Estilo ANSI do campo (cor/negrito, "" se nenhum)
+ */
+static inline const char *display_field_text(display_field_t field,
+                                             const display_data_msg_t *data,
+                                             char text[DISPLAY_FIELD_WIDTH])
+{
+    char *p = text;
+    const char *style = "";
+
+    switch (field) {
+    case DISPLAY_FIELD_TYPE:
+        p = display_put_str(p, get_vehicle_type_text(data->vehicle_type));
+        break;
+    case DISPLAY_FIELD_SPEED:
+        p = display_put_uint(p, data->speed_centi_kmh / 100U, 3, ' ');
+        *p++ = '.';
+        p = display_put_uint(p, data->speed_centi_kmh % 100U, 2, '0');
+        p = display_put_str(p, " km/h");
+        style = display_status_style(data->status);
+        break;
+    case DISPLAY_FIELD_LIMIT:
+        p = display_put_uint(p, data->speed_limit, 3, ' ');
+        p = display_put_str(p, " km/h");
+        break;
+    case DISPLAY_FIELD_STATUS:
+        p = display_put_str(p, get_status_text(data->status));
+        style = display_status_style(data->status);
+        break;
+    case DISPLAY_FIELD_PLATE:
+        for (size_t i = 0; i < sizeof(data->plate) && data->plate[i] != '\0'; i++) {
+            *p++ = data->plate[i];
+        }
+        style = (strncmp(data->plate, "ERR", 3) == 0) ? ANSI_COLOR_RED : ANSI_BOLD;
+        break;
+    default:
+        break;
+    }
+
+    memset(p, ' ', DISPLAY_FIELD_WIDTH - (size_t)(p - text));
+    return style;
+}
+
+/**
+ * @brief Campo precisa ser reescrito?
+ */
+static inline bool display_field_dirty(display_field_t field, const display_data_msg_t *old,
+                                       const display_data_msg_t *data)
+{
+    switch (field) {
+    case DISPLAY_FIELD_TYPE:
+        return old->vehicle_type != data->vehicle_type;
+    case DISPLAY_FIELD_SPEED:
+        /* A cor da velocidade depende do status */
+        return old->speed_centi_kmh != data->speed_centi_kmh || old->status != data->status;
+    case DISPLAY_FIELD_LIMIT:
+        return old->speed_limit != data->speed_limit;
+    case DISPLAY_FIELD_STATUS:
+        return old->status != data->status;
+    case DISPLAY_FIELD_PLATE:
+        return strncmp(old->plate, data->plate, sizeof(data->plate)) != 0;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Gera a atualização do quadro para novos dados
+ *
+ * Emite só os campos alterados desde a última chamada, cada um com
+ * posicionamento absoluto do cursor, preservando a posição de escrita
+ * dos logs (salva/restaura o cursor).
+ *
+ * @param buf Destino (DISPLAY_UPDATE_MAX_LEN é suficiente)
+ * @return Comprimento escrito (0 se nada mudou)
+ */
+static inline size_t display_render_update(struct display_renderer *renderer,
+                                           const display_data_msg_t *data,
+                                           char *buf, size_t size)
+{
+    char *p = buf;
+
+    if (size < DISPLAY_UPDATE_MAX_LEN) {
+        return 0;
+    }
+
+    p = display_put_str(p, ANSI_SAVE_CURSOR);
+
+    for (int f = 0; f < DISPLAY_FIELD_COUNT; f++) {
+        if (renderer->drawn && !display_field_dirty(f, &renderer->shown, data)) {
+            continue;
+        }
+
+        char text[DISPLAY_FIELD_WIDTH];
+        const char *style = display_field_text(f, data, text);
+
+        /* ESC[linha;colunaH, estilo, texto de largura fixa */
+        p = display_put_str(p, "\x1b[");
+        p = display_put_uint(p, display_field_row[f], 1, ' ');
+        *p++ = ';';
+        p = display_put_uint(p, DISPLAY_FIELD_COL, 1, ' ');
+        *p++ = 'H';
+        p = display_put_str(p, style);
+        memcpy(p, text, DISPLAY_FIELD_WIDTH);
+        p += DISPLAY_FIELD_WIDTH;
+        if (style[0] != '\0') {
+            p = display_put_str(p, ANSI_COLOR_RESET);
+        }
+    }
+
+    renderer->shown = *data;
+
+    if (renderer->drawn && p == buf + strlen(ANSI_SAVE_CURSOR)) {
+        return 0;
+    }
+
+    renderer->drawn = true;
+    p = display_put_str(p, ANSI_RESTORE_CURSOR);
+    *p = '\0';
+
+    return (size_t)(p - buf);
+}
+
+#endif /* RADAR_DISPLAY_RENDER_H */
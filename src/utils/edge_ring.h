@@ -0,0 +1,110 @@
+/**
+ * @file edge_ring.h
+ * @brief Fila circular lock-free de bordas dos sensores
+ *
+ * Fila single-producer/single-consumer: as ISRs dos sensores apenas
+ * registram {faixa, sensor, timestamp} e a thread de sensores consome
+ * os eventos e roda a máquina de estados. Nenhum lado bloqueia ou
+ * desabilita interrupções.
+ *
+ * Produtor único: todos os sensores devem ser atendidos por ISRs de
+ * mesma prioridade (que não se aninham entre si).
+ */
+
+#ifndef RADAR_EDGE_RING_H
+#define RADAR_EDGE_RING_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Capacidade da fila (potência de 2) */
+#define EDGE_RING_SIZE 32
+
+BUILD_ASSERT(IS_POWER_OF_TWO(EDGE_RING_SIZE), "EDGE_RING_SIZE deve ser potência de 2");
+
+/**
+ * @brief Borda detectada em um sensor
+ */
+typedef struct {
+    uint64_t timestamp; /**< Instante da borda (ciclos) */
+    uint8_t lane_id;    /**< Faixa do sensor */
+    uint8_t sensor;     /**< 1 = conta eixos, 2 = marca fim */
+} edge_event_t;
+
+/**
+ * @brief Fila SPSC de bordas
+ *
+ * head e tail são contadores livres (nunca voltam); o índice no buffer
+ * é o contador módulo EDGE_RING_SIZE.
+ */
+struct edge_ring {
+    edge_event_t events[EDGE_RING_SIZE];
+    atomic_t head;    /**< Próxima escrita (apenas o produtor altera) */
+    atomic_t tail;    /**< Próxima leitura (apenas o consumidor altera) */
+    atomic_t dropped; /**< Bordas descartadas por fila cheia */
+};
+
+/**
+ * @brief Inicializa a fila vazia
+ */
+static inline void edge_ring_init(struct edge_ring *ring)
+{
+    atomic_set(&ring->head, 0);
+    atomic_set(&ring->tail, 0);
+    atomic_set(&ring->dropped, 0);
+}
+
+/**
+ * @brief Registra uma borda (lado produtor, seguro em ISR)
+ *
+ * @return true se registrada, false se a fila estava cheia
+ */
+static inline bool edge_ring_push(struct edge_ring *ring, const edge_event_t *event)
+{
+    uint32_t head = (uint32_t)atomic_get(&ring->head);
+    uint32_t tail = (uint32_t)atomic_get(&ring->tail);
+
+    if ((uint32_t)(head - tail) >= EDGE_RING_SIZE) {
+        atomic_inc(&ring->dropped);
+        return false;
+    }
+
+    ring->events[head & (EDGE_RING_SIZE - 1)] = *event;
+
+    /* Publica o evento só depois de escrito (atomic_set é uma barreira) */
+    atomic_set(&ring->head, (atomic_val_t)(head + 1));
+    return true;
+}
+
+/**
+ * @brief Retira a borda mais antiga (lado consumidor)
+ *
+ * @return true se havia evento, false se a fila estava vazia
+ */
+static inline bool edge_ring_pop(struct edge_ring *ring, edge_event_t *event)
+{
+    uint32_t tail = (uint32_t)atomic_get(&ring->tail);
+    uint32_t head = (uint32_t)atomic_get(&ring->head);
+
+    if (head == tail) {
+        return false;
+    }
+
+    *event = ring->events[tail & (EDGE_RING_SIZE - 1)];
+
+    /* Libera a posição só depois de copiada */
+    atomic_set(&ring->tail, (atomic_val_t)(tail + 1));
+    return true;
+}
+
+/**
+ * @brief Lê e zera o contador de bordas descartadas
+ */
+static inline uint32_t edge_ring_take_dropped(struct edge_ring *ring)
+{
+    return (uint32_t)atomic_clear(&ring->dropped);
+}
+
+#endif /* RADAR_EDGE_RING_H */
@@ -0,0 +1,398 @@
+/**
+ * @file lane_tracker.h
+ * @brief Veículos em trânsito entre os sensores de uma faixa (FIFO)
+ *
+ * Cada eixo passa pelo sensor 1 e, depois do tempo de percorrer a
+ * distância entre sensores, pelo sensor 2. Os eixos chegam ao sensor 2
+ * na mesma ordem em que passaram pelo sensor 1, então cada borda do
+ * sensor 2 pertence ao eixo mais antigo ainda não casado, mesmo que ele
+ * seja de um veículo anterior ao que está sendo contado no sensor 1.
+ *
+ * O rastreador mantém uma FIFO de veículos: o último está aberto
+ * (contando eixos no sensor 1) enquanto os anteriores aguardam seus
+ * eixos no sensor 2. Um novo veículo começa a contar eixos sem esperar
+ * o anterior ser medido, e a capacidade da faixa fica limitada pela
+ * distância entre sensores, não pela serialização de um veículo por vez.
+ *
+ * O casamento por ordem depende de toda borda do sensor 1 ter a sua no
+ * sensor 2. Por isso:
+ * - com a FIFO cheia, os eixos de um novo veículo vão para uma entrada
+ *   de descarte no fim da FIFO, que absorve as bordas deles no sensor 2
+ *   e sai sem ser medida;
+ * - cada eixo deve levar quase o mesmo tempo entre os sensores que o
+ *   primeiro eixo do veículo. Uma borda que chega tarde demais para o
+ *   eixo pendente é de um eixo seguinte (a borda do pendente se perdeu)
+ *   e uma que chega cedo demais é espúria e é ignorada.
+ *
+ * Tempos em ciclos de um contador monotônico de 64 bits; tempo e
+ * memória limitados, sem alocação.
+ */
+
+#ifndef RADAR_LANE_TRACKER_H
+#define RADAR_LANE_TRACKER_H
+
+#include <zephyr/kernel.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../types.h"
+
+/** Eixos com timestamp guardado por veículo (os excedentes só são contados) */
+#define LANE_TRACKER_MAX_AXLES VEHICLE_MAX_AXLES
+
+/** Veículos em trânsito por faixa (mais uma entrada de descarte) */
+#define LANE_TRACKER_DEPTH 4
+
+/** Desvio aceito no trânsito de um eixo frente ao primeiro: 1/2^N */
+#define LANE_TRACKER_TRANSIT_TOL_SHIFT 1
+
+/** Folga do intervalo de agrupamento sobre o tempo do maior espaçamento: 1/2^N */
+#define LANE_TRACKER_GROUP_MARGIN_SHIFT 3
+
+/**
+ * @brief Veículo em trânsito
+ */
+typedef struct {
+    uint64_t axle_s1[LANE_TRACKER_MAX_AXLES]; /**< Eixo i no sensor 1 */
+    uint64_t last_s1;        /**< Último eixo no sensor 1 */
+    uint64_t last_s2;        /**< Último eixo casado no sensor 2 */
+    uint64_t transit_sum;    /**< Soma dos tempos sensor 1 -> sensor 2 dos eixos casados */
+    uint64_t first_transit;  /**< Tempo sensor 1 -> sensor 2 do primeiro eixo */
+    uint8_t axles;           /**< Eixos contados no sensor 1 */
+    uint8_t matched;         /**< Eixos já vistos (ou perdidos) no sensor 2 */
+    uint8_t timed;           /**< Eixos em transit_sum */
+    bool discard;            /**< Eixos descartados com a FIFO cheia */
+    sensor_state_t state;    /**< COUNTING_AXLES (aberto) ou MEASURING_SPEED */
+} lane_vehicle_t;
+
+/**
+ * @brief FIFO de veículos de uma faixa
+ */
+struct lane_tracker {
+    lane_vehicle_t fifo[LANE_TRACKER_DEPTH + 1];
+    uint8_t head;            /**< Veículo mais antigo */
+    uint8_t count;           /**< Veículos em trânsito */
+};
+
+/**
+ * @brief Parâmetros do intervalo de agrupamento (unidade dos timestamps)
+ */
+typedef struct {
+    uint64_t fallback;          /**< Sem veículo aberto ou velocidade desconhecida */
+    uint64_t min_gap;           /**< Limites do intervalo pela velocidade */
+    uint64_t max_gap;
+    uint32_t max_spacing_mm;    /**< Maior espaçamento entre eixos esperado */
+    uint32_t distance_mm;       /**< Distância entre sensores */
+} lane_group_params_t;
+
+/**
+ * @brief Resultado de uma borda do sensor 1
+ */
+typedef enum {
+    LANE_S1_NEW_VEHICLE = 0, /**< Primeiro eixo de um novo veículo */
+    LANE_S1_AXLE,            /**< Mais um eixo do veículo aberto */
+    LANE_S1_FULL             /**< FIFO cheia: eixo na entrada de descarte */
+} lane_s1_result_t;
+
+static inline void lane_tracker_init(struct lane_tracker *tr)
+{
+    tr->head = 0;
+    tr->count = 0;
+}
+
+static inline lane_vehicle_t *lane_tracker_at(struct lane_tracker *tr, uint8_t i)
+{
+    return &tr->fifo[(tr->head + i) % ARRAY_SIZE(tr->fifo)];
+}
+
+static inline void lane_tracker_pop(struct lane_tracker *tr)
+{
+    tr->head = (tr->head + 1) % ARRAY_SIZE(tr->fifo);
+    tr->count--;
+}
+
+/**
+ * @brief Veículo aberto (contando eixos), ou NULL
+ */
+static inline lane_vehicle_t *lane_tracker_open(struct lane_tracker *tr)
+{
+    if (tr->count == 0) {
+        return NULL;
+    }
+
+    lane_vehicle_t *tail = lane_tracker_at(tr, tr->count - 1);
+
+    return (tail->state == SENSOR_STATE_COUNTING_AXLES) ? tail : NULL;
+}
+
+/**
+ * @brief Borda no sensor 1
+ *
+ * Um eixo até group_gap depois do anterior pertence ao veículo aberto;
+ * depois disso, o veículo aberto é fechado e um novo começa. Com
+ * LANE_TRACKER_DEPTH veículos em trânsito, o novo vai para a entrada de
+ * descarte (um descarte já no fim da FIFO recebe os eixos seguintes).
+ */
+static inline lane_s1_result_t lane_tracker_sensor1(struct lane_tracker *tr, uint64_t now,
+                                                    uint64_t group_gap)
+{
+    lane_vehicle_t *open = lane_tracker_open(tr);
+
+    if (open != NULL && now - open->last_s1 <= group_gap) {
+        if (open->axles < LANE_TRACKER_MAX_AXLES) {
+            open->axle_s1[open->axles] = now;
+        }
+        if (open->axles < UINT8_MAX) {
+            open->axles++;
+        }
+        open->last_s1 = now;
+        return open->discard ? LANE_S1_FULL : LANE_S1_AXLE;
+    }
+
+    if (open != NULL) {
+        open->state = SENSOR_STATE_MEASURING_SPEED;
+    }
+
+    bool discard = (tr->count >= LANE_TRACKER_DEPTH);
+
+    if (discard) {
+        lane_vehicle_t *tail = lane_tracker_at(tr, tr->count - 1);
+
+        if (tail->discard) {
+            if (tail->axles < UINT8_MAX) {
+                tail->axles++;
+            }
+            tail->last_s1 = now;
+            tail->state = SENSOR_STATE_COUNTING_AXLES;
+            return LANE_S1_FULL;
+        }
+    }
+
+    lane_vehicle_t *v = lane_tracker_at(tr, tr->count++);
+
+    v->axle_s1[0] = now;
+    v->last_s1 = now;
+    v->last_s2 = 0;
+    v->transit_sum = 0;
+    v->first_transit = 0;
+    v->axles = 1;
+    v->matched = 0;
+    v->timed = 0;
+    v->discard = discard;
+    v->state = SENSOR_STATE_COUNTING_AXLES;
+    return discard ? LANE_S1_FULL : LANE_S1_NEW_VEHICLE;
+}
+
+/**
+ * @brief Compara o trânsito de um eixo com o do primeiro eixo
+ *
+ * @return < 0 cedo demais, 0 dentro da tolerância, > 0 tarde demais
+ */
+static inline int lane_vehicle_transit_fit(const lane_vehicle_t *v, uint8_t axle,
+                                           uint64_t now)
+{
+    uint64_t transit = now - v->axle_s1[axle];
+    uint64_t tol = v->first_transit >> LANE_TRACKER_TRANSIT_TOL_SHIFT;
+
+    if (transit + tol < v->first_transit) {
+        return -1;
+    }
+    return (transit > v->first_transit + tol) ? 1 : 0;
+}
+
+/**
+ * @brief Pula eixos cujas bordas no sensor 2 se perderam
+ *
+ * @return false se a borda é cedo demais para o eixo pendente (espúria)
+ */
+static inline bool lane_vehicle_resync(lane_vehicle_t *v, uint64_t now)
+{
+    uint8_t stored = MIN(v->axles, (uint8_t)LANE_TRACKER_MAX_AXLES);
+    int fit = lane_vehicle_transit_fit(v, v->matched, now);
+
+    if (fit < 0) {
+        return false;
+    }
+
+    while (fit > 0 && v->matched + 1 < stored &&
+           lane_vehicle_transit_fit(v, v->matched + 1, now) >= 0) {
+        v->matched++;
+        fit = lane_vehicle_transit_fit(v, v->matched, now);
+    }
+
+    /* Nem o último eixo guardado explica a borda: os restantes se perderam */
+    if (fit > 0 && v->state == SENSOR_STATE_MEASURING_SPEED) {
+        v->matched = v->axles;
+    }
+    return true;
+}
+
+/**
+ * @brief Borda no sensor 2: casa com o eixo mais antigo pendente
+ *
+ * A partir do segundo eixo de um veículo, a borda precisa caber no
+ * trânsito do primeiro (lane_vehicle_resync): eixos cuja borda se perdeu
+ * ficam sem tempo e, se nenhum eixo do veículo fechado a explica, ela
+ * passa ao veículo seguinte. Entradas de descarte absorvem as bordas sem
+ * essa verificação (seus eixos podem ser de veículos diferentes).
+ *
+ * @return false se nenhum eixo aguardava o sensor 2 ou se a borda é
+ *         cedo demais para o eixo pendente (borda ignorada)
+ */
+static inline bool lane_tracker_sensor2(struct lane_tracker *tr, uint64_t now)
+{
+    for (uint8_t i = 0; i < tr->count; i++) {
+        lane_vehicle_t *v = lane_tracker_at(tr, i);
+
+        if (v->matched >= v->axles) {
+            continue;
+        }
+
+        if (!v->discard && v->matched > 0 && v->matched < LANE_TRACKER_MAX_AXLES) {
+            if (!lane_vehicle_resync(v, now)) {
+                return false;
+            }
+            if (v->matched >= v->axles) {
+                continue;
+            }
+        }
+
+        if (v->matched == 0) {
+            v->first_transit = now - v->axle_s1[0];
+        }
+        if (v->matched < LANE_TRACKER_MAX_AXLES) {
+            v->transit_sum += now - v->axle_s1[v->matched];
+            v->timed++;
+        }
+        v->matched++;
+        v->last_s2 = now;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Fecha o veículo aberto se o último eixo foi há mais de group_gap
+ *
+ * @return true se um veículo foi fechado
+ */
+static inline bool lane_tracker_close(struct lane_tracker *tr, uint64_t now, uint64_t group_gap)
+{
+    lane_vehicle_t *open = lane_tracker_open(tr);
+
+    if (open == NULL || now - open->last_s1 <= group_gap) {
+        return false;
+    }
+
+    open->state = SENSOR_STATE_MEASURING_SPEED;
+    return true;
+}
+
+/**
+ * @brief Retira o veículo mais antigo se fechado e com todos os eixos casados
+ *
+ * Entradas de descarte completas saem sem ser entregues.
+ */
+static inline bool lane_tracker_take_complete(struct lane_tracker *tr, lane_vehicle_t *out)
+{
+    while (tr->count > 0) {
+        lane_vehicle_t *head = lane_tracker_at(tr, 0);
+
+        if (head->state != SENSOR_STATE_MEASURING_SPEED || head->matched < head->axles) {
+            return false;
+        }
+
+        bool discard = head->discard;
+
+        if (!discard) {
+            *out = *head;
+        }
+        lane_tracker_pop(tr);
+        if (!discard) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Descarta o veículo mais antigo se seus eixos não chegaram ao
+ *        sensor 2 em max_transit (borda perdida ou veículo parado)
+ *
+ * Sem isso, um eixo nunca casado deslocaria todas as bordas seguintes.
+ *
+ * @return true se um veículo foi descartado
+ */
+static inline bool lane_tracker_expire(struct lane_tracker *tr, uint64_t now,
+                                       uint64_t max_transit)
+{
+    if (tr->count == 0) {
+        return false;
+    }
+
+    lane_vehicle_t *head = lane_tracker_at(tr, 0);
+
+    if (head->matched >= head->axles || now - head->last_s1 <= max_transit) {
+        return false;
+    }
+
+    lane_tracker_pop(tr);
+    return true;
+}
+
+/**
+ * @brief Tempo médio (ciclos) sensor 1 -> sensor 2 dos eixos do veículo
+ *
+ * Só eixos com borda no sensor 2 entram na média.
+ */
+static inline uint64_t lane_vehicle_transit(const lane_vehicle_t *v)
+{
+    return (v->timed == 0) ? 0 : v->transit_sum / v->timed;
+}
+
+/**
+ * @brief Tempo para o veículo percorrer length_mm na velocidade do
+ *        primeiro eixo (que percorreu distance_mm em first_transit)
+ *
+ * @return Tempo na unidade dos timestamps, ou 0 se o primeiro eixo
+ *         ainda não chegou ao sensor 2
+ */
+static inline uint64_t lane_vehicle_travel(const lane_vehicle_t *v, uint32_t length_mm,
+                                           uint32_t distance_mm)
+{
+    if (v->matched == 0 || distance_mm == 0) {
+        return 0;
+    }
+    return v->first_transit * length_mm / distance_mm;
+}
+
+/**
+ * @brief Intervalo máximo entre eixos do veículo aberto
+ *
+ * Quando o primeiro eixo chega ao sensor 2, a velocidade do veículo é
+ * conhecida: o intervalo passa a ser o tempo para percorrer
+ * max_spacing_mm, mais 1/2^LANE_TRACKER_GROUP_MARGIN_SHIFT de folga,
+ * limitado a [min_gap, max_gap]. Até lá, e sem veículo aberto, vale
+ * fallback. Como o valor muda com a borda do sensor 2, o prazo de
+ * fechamento deve ser recalculado a cada uma.
+ */
+static inline uint64_t lane_tracker_group_gap(struct lane_tracker *tr,
+                                              const lane_group_params_t *params)
+{
+    const lane_vehicle_t *open = lane_tracker_open(tr);
+
+    if (open == NULL) {
+        return params->fallback;
+    }
+
+    uint64_t gap = lane_vehicle_travel(open, params->max_spacing_mm, params->distance_mm);
+
+    if (gap == 0) {
+        return params->fallback;
+    }
+
+    gap += gap >> LANE_TRACKER_GROUP_MARGIN_SHIFT;
+    return CLAMP(gap, params->min_gap, params->max_gap);
+}
+
+#endif /* RADAR_LANE_TRACKER_H */
@@ -0,0 +1,254 @@
+/**
+ * @file latency_hist.h
+ * @brief Histogramas de latência por estágio do pipeline
+ *
+ * Cada veículo é carimbado (contador de ciclos, 32 bits) na borda do
+ * sensor 2 (ISR), na retirada da sensor_msgq, ao fim do cálculo, no
+ * desenho do display, no trigger da câmera e no resultado da captura.
+ * Cada transição entre carimbos alimenta um histograma de buckets fixos
+ * em microssegundos, do qual se leem p50, p99 e máximo em tempo de
+ * execução.
+ *
+ * Buckets log-lineares: valores abaixo de 4 us têm bucket próprio; cada
+ * potência de 2 acima disso é dividida em 4 buckets (erro relativo de
+ * no máximo 25%). O último bucket (a partir de ~59 s) acumula o excesso;
+ * o máximo é sempre exato.
+ *
+ * Os contadores são atômicos: qualquer thread registra ou lê sem trava,
+ * e a leitura nunca bloqueia o caminho de detecção.
+ */
+
+#ifndef RADAR_LATENCY_HIST_H
+#define RADAR_LATENCY_HIST_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <stdint.h>
+
+/** Sub-buckets por potência de 2 (2^LATENCY_HIST_SUB_BITS) */
+#define LATENCY_HIST_SUB_BITS 2
+#define LATENCY_HIST_SUB_COUNT (1U << LATENCY_HIST_SUB_BITS)
+
+/** Número de buckets (o último cobre de ~59 s em diante) */
+#define LATENCY_HIST_BUCKETS 100
+
+/**
+ * @brief Transições medidas
+ *
+ * As cinco primeiras são estágios consecutivos; as duas últimas são as
+ * latências fim a fim (borda do sensor 2 até o painel e até a placa).
+ */
+typedef enum {
+    LATENCY_SPAN_ISR_DEQUEUE = 0,    /**< Borda do sensor 2 -> retirada da sensor_msgq */
+    LATENCY_SPAN_DEQUEUE_COMPUTE,    /**< Retirada -> fim do cálculo */
+    LATENCY_SPAN_COMPUTE_DISPLAY,    /**< Fim do cálculo -> quadro desenhado */
+    LATENCY_SPAN_COMPUTE_TRIGGER,    /**< Fim do cálculo -> trigger recebido pela câmera */
+    LATENCY_SPAN_TRIGGER_RESULT,     /**< Trigger -> resultado da captura */
+    LATENCY_SPAN_ISR_DISPLAY,        /**< Fim a fim: borda do sensor 2 -> painel */
+    LATENCY_SPAN_ISR_RESULT,         /**< Fim a fim: borda do sensor 2 -> placa */
+    LATENCY_SPAN_COUNT
+} latency_span_t;
+
+/**
+ * @brief Histograma de uma transição
+ */
+struct latency_hist {
+    atomic_t buckets[LATENCY_HIST_BUCKETS];
+    atomic_t count;   /**< Amostras registradas */
+    atomic_t max_us;  /**< Maior amostra (us) */
+};
+
+/**
+ * @brief Histogramas de todas as transições
+ */
+struct latency_stats {
+    struct latency_hist span[LATENCY_SPAN_COUNT];
+};
+
+/**
+ * @brief Resumo de um histograma
+ */
+typedef struct {
+    uint32_t count;   /**< Amostras */
+    uint32_t p50_us;  /**< Mediana (limite superior do bucket) */
+    uint32_t p99_us;  /**< Percentil 99 (limite superior do bucket) */
+    uint32_t max_us;  /**< Máximo exato */
+} latency_summary_t;
+
+/**
+ * @brief Nome curto da transição (logs)
+ */
+static inline const char *latency_span_name(latency_span_t span)
+{
+    switch (span) {
+    case LATENCY_SPAN_ISR_DEQUEUE:
+        return "isr>fila";
+    case LATENCY_SPAN_DEQUEUE_COMPUTE:
+        return "fila>calculo";
+    case LATENCY_SPAN_COMPUTE_DISPLAY:
+        return "calculo>display";
+    case LATENCY_SPAN_COMPUTE_TRIGGER:
+        return "calculo>trigger";
+    case LATENCY_SPAN_TRIGGER_RESULT:
+        return "trigger>resultado";
+    case LATENCY_SPAN_ISR_DISPLAY:
+        return "isr>display";
+    case LATENCY_SPAN_ISR_RESULT:
+        return "isr>placa";
+    default:
+        return "?";
+    }
+}
+
+/**
+ * @brief Carimbo de tempo de um estágio (ciclos)
+ *
+ * 32 bits bastam para latências: a diferença modular tolera um
+ * wrap-around (171 s a 25 MHz).
+ */
+static inline uint32_t latency_stamp(void)
+{
+    return k_cycle_get_32();
+}
+
+/**
+ * @brief Bucket de uma latência em microssegundos
+ */
+static inline uint32_t latency_bucket_index(uint32_t us)
+{
+    if (us < LATENCY_HIST_SUB_COUNT) {
+        return us;
+    }
+
+    uint32_t msb = 31U - (uint32_t)__builtin_clz(us);
+    uint32_t sub = (us >> (msb - LATENCY_HIST_SUB_BITS)) & (LATENCY_HIST_SUB_COUNT - 1);
+    uint32_t index = (msb - LATENCY_HIST_SUB_BITS + 1) * LATENCY_HIST_SUB_COUNT + sub;
+
+    return MIN(index, LATENCY_HIST_BUCKETS - 1);
+}
+
+/**
+ * @brief Menor latência (us) que cai no bucket
+ */
+static inline uint32_t latency_bucket_lower_us(uint32_t index)
+{
+    if (index < LATENCY_HIST_SUB_COUNT) {
+        return index;
+    }
+
+    uint32_t shift = index / LATENCY_HIST_SUB_COUNT - 1;
+    uint32_t sub = index % LATENCY_HIST_SUB_COUNT;
+
+    return (LATENCY_HIST_SUB_COUNT + sub) << shift;
+}
+
+/**
+ * @brief Maior latência (us) que cai no bucket (UINT32_MAX no último)
+ */
+static inline uint32_t latency_bucket_upper_us(uint32_t index)
+{
+    if (index >= LATENCY_HIST_BUCKETS - 1) {
+        return UINT32_MAX;
+    }
+    return latency_bucket_lower_us(index + 1) - 1;
+}
+
+/**
+ * @brief Zera o histograma
+ *
+ * Amostras registradas durante o reset podem sobreviver a ele; nada se
+ * corrompe, já que cada contador é atômico.
+ */
+static inline void latency_hist_reset(struct latency_hist *hist)
+{
+    for (uint32_t i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+        atomic_clear(&hist->buckets[i]);
+    }
+    atomic_clear(&hist->count);
+    atomic_clear(&hist->max_us);
+}
+
+/**
+ * @brief Registra uma amostra (seguro de qualquer thread)
+ */
+static inline void latency_hist_record(struct latency_hist *hist, uint32_t us)
+{
+    atomic_inc(&hist->buckets[latency_bucket_index(us)]);
+    atomic_inc(&hist->count);
+
+    atomic_val_t max = atomic_get(&hist->max_us);
+
+    while ((uint32_t)max < us && !atomic_cas(&hist->max_us, max, (atomic_val_t)us)) {
+        max = atomic_get(&hist->max_us);
+    }
+}
+
+/**
+ * @brief Percentil, como limite superior do bucket que o contém
+ *
+ * Limitado ao máximo observado, que é exato.
+ *
+ * @param percent Percentil (1-100)
+ * @return Latência (us), ou 0 sem amostras
+ */
+static inline uint32_t latency_hist_percentile(const struct latency_hist *hist,
+                                               uint32_t percent)
+{
+    uint32_t total = 0;
+
+    for (uint32_t i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+        total += (uint32_t)atomic_get(&hist->buckets[i]);
+    }
+
+    if (total == 0) {
+        return 0;
+    }
+
+    /* Posição da amostra no percentil (arredondada para cima) */
+    uint32_t rank = (uint32_t)(((uint64_t)total * percent + 99) / 100);
+    uint32_t seen = 0;
+    uint32_t max = (uint32_t)atomic_get(&hist->max_us);
+
+    for (uint32_t i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+        seen += (uint32_t)atomic_get(&hist->buckets[i]);
+        if (seen >= rank) {
+            return MIN(latency_bucket_upper_us(i), max);
+        }
+    }
+
+    /* Histograma zerado entre as duas passagens */
+    return max;
+}
+
+/**
+ * @brief Lê contagem, p50, p99 e máximo
+ */
+static inline void latency_hist_summary(const struct latency_hist *hist,
+                                        latency_summary_t *out)
+{
+    out->count = (uint32_t)atomic_get(&hist->count);
+    out->p50_us = latency_hist_percentile(hist, 50);
+    out->p99_us = latency_hist_percentile(hist, 99);
+    out->max_us = (uint32_t)atomic_get(&hist->max_us);
+}
+
+/**
+ * @brief Zera todos os histogramas
+ */
+static inline void latency_stats_reset(struct latency_stats *stats)
+{
+    for (int i = 0; i < LATENCY_SPAN_COUNT; i++) {
+        latency_hist_reset(&stats->span[i]);
+    }
+}
+
+/**
+ * @brief Registra a transição entre dois carimbos de latency_stamp()
+ */
+static inline void latency_record_cycles(struct latency_stats *stats, latency_span_t span,
+                                         uint32_t from_cyc, uint32_t to_cyc)
+{
+    latency_hist_record(&stats->span[span], k_cyc_to_us_floor32(to_cyc - from_cyc));
+}
+
+#endif /* RADAR_LATENCY_HIST_H */
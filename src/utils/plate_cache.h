@@ -0,0 +1,179 @@
+/**
+ * @file plate_cache.h
+ * @brief Cache de placas recentes (reincidência e duplicatas)
+ *
+ * Tabela hash de tamanho fixo, endereçamento aberto com sondagem
+ * linear limitada a PLATE_CACHE_MAX_PROBE posições: consulta e registro
+ * são O(1) e não alocam memória. Entradas não vistas há mais de ttl_ms
+ * expiram e são reaproveitadas; se a janela de sondagem está cheia, a
+ * entrada vista há mais tempo é substituída. Uma placa ocupa no máximo
+ * uma posição: a entrada expirada da própria placa é reaproveitada
+ * antes de qualquer outra, para não deixar uma duplicata velha na
+ * janela de sondagem.
+ *
+ * Chave: plate_pack_key() da placa (0 é reservado para "vazio").
+ * Não é thread-safe: use a partir de uma única thread.
+ */
+
+#ifndef RADAR_PLATE_CACHE_H
+#define RADAR_PLATE_CACHE_H
+
+#include <zephyr/kernel.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef CONFIG_RADAR_PLATE_CACHE_SIZE
+#define PLATE_CACHE_SIZE CONFIG_RADAR_PLATE_CACHE_SIZE
+#else
+#define PLATE_CACHE_SIZE 64
+#endif
+
+BUILD_ASSERT(IS_POWER_OF_TWO(PLATE_CACHE_SIZE), "PLATE_CACHE_SIZE deve ser potência de 2");
+
+/** Posições examinadas por consulta */
+#define PLATE_CACHE_MAX_PROBE 8
+
+BUILD_ASSERT(PLATE_CACHE_MAX_PROBE <= PLATE_CACHE_SIZE, "Sondagem maior que a tabela");
+
+/**
+ * @brief Histórico de uma placa
+ */
+typedef struct {
+    uint64_t key;                 /**< plate_pack_key(), 0 = posição livre */
+    uint32_t first_seen_ms;       /**< Primeira captura (k_uptime_get_32) */
+    uint32_t last_seen_ms;        /**< Última captura */
+    uint32_t max_speed_centi_kmh; /**< Maior velocidade registrada */
+    uint16_t count;               /**< Capturas (sem contar duplicatas) */
+} plate_cache_entry_t;
+
+/**
+ * @brief Resultado do registro de uma captura
+ */
+typedef enum {
+    PLATE_CACHE_NEW = 0,       /**< Placa sem histórico no cache */
+    PLATE_CACHE_REPEAT = 1,    /**< Placa já capturada antes (count incrementado) */
+    PLATE_CACHE_DUPLICATE = 2, /**< Mesma placa dentro da janela de duplicata */
+} plate_cache_result_t;
+
+struct plate_cache {
+    plate_cache_entry_t entries[PLATE_CACHE_SIZE];
+    uint32_t ttl_ms;           /**< Entradas mais antigas expiram */
+    uint32_t dup_window_ms;    /**< Recaptura dentro deste tempo é duplicata */
+};
+
+/**
+ * @brief Inicializa o cache vazio
+ */
+static inline void plate_cache_init(struct plate_cache *cache, uint32_t ttl_ms,
+                                    uint32_t dup_window_ms)
+{
+    for (uint32_t i = 0; i < PLATE_CACHE_SIZE; i++) {
+        cache->entries[i].key = 0;
+    }
+    cache->ttl_ms = ttl_ms;
+    cache->dup_window_ms = dup_window_ms;
+}
+
+/**
+ * @brief Posição inicial da sondagem (hash multiplicativo de Fibonacci)
+ */
+static inline uint32_t plate_cache_slot(uint64_t key)
+{
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ULL) >> 32) & (PLATE_CACHE_SIZE - 1);
+}
+
+static inline bool plate_cache_expired(const struct plate_cache *cache,
+                                       const plate_cache_entry_t *entry, uint32_t now_ms)
+{
+    return (now_ms - entry->last_seen_ms) > cache->ttl_ms;
+}
+
+/**
+ * @brief Consulta o histórico de uma placa
+ *
+ * @return Entrada, ou NULL se a placa não está no cache (ou expirou)
+ */
+static inline const plate_cache_entry_t *plate_cache_lookup(const struct plate_cache *cache,
+                                                            uint64_t key, uint32_t now_ms)
+{
+    uint32_t slot = plate_cache_slot(key);
+
+    for (uint32_t i = 0; i < PLATE_CACHE_MAX_PROBE; i++) {
+        const plate_cache_entry_t *entry =
+            &cache->entries[(slot + i) & (PLATE_CACHE_SIZE - 1)];
+
+        if (entry->key == key) {
+            return plate_cache_expired(cache, entry, now_ms) ? NULL : entry;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Registra uma captura de placa
+ *
+ * @param speed_centi_kmh Velocidade da captura
+ * @param entry Saída opcional: histórico atualizado da placa
+ * @return Se a placa é nova, reincidente ou duplicata
+ */
+static inline plate_cache_result_t plate_cache_record(struct plate_cache *cache, uint64_t key,
+                                                      uint32_t now_ms, uint32_t speed_centi_kmh,
+                                                      const plate_cache_entry_t **entry)
+{
+    uint32_t slot = plate_cache_slot(key);
+    plate_cache_entry_t *victim = NULL;
+    plate_cache_result_t result;
+
+    for (uint32_t i = 0; i < PLATE_CACHE_MAX_PROBE; i++) {
+        plate_cache_entry_t *candidate = &cache->entries[(slot + i) & (PLATE_CACHE_SIZE - 1)];
+
+        if (candidate->key == key && !plate_cache_expired(cache, candidate, now_ms)) {
+            if ((now_ms - candidate->last_seen_ms) <= cache->dup_window_ms) {
+                result = PLATE_CACHE_DUPLICATE;
+            } else {
+                candidate->count++;
+                result = PLATE_CACHE_REPEAT;
+            }
+            candidate->last_seen_ms = now_ms;
+            candidate->max_speed_centi_kmh = MAX(candidate->max_speed_centi_kmh,
+                                                 speed_centi_kmh);
+            if (entry != NULL) {
+                *entry = candidate;
+            }
+            return result;
+        }
+
+        /* Entrada expirada da mesma placa: reaproveita, sem criar outra */
+        if (candidate->key == key) {
+            victim = candidate;
+            break;
+        }
+
+        /* Prefere posição livre ou expirada; senão, a vista há mais tempo */
+        bool reusable = (candidate->key == 0) ||
+                        plate_cache_expired(cache, candidate, now_ms);
+        bool victim_reusable = (victim != NULL) &&
+                               ((victim->key == 0) || plate_cache_expired(cache, victim, now_ms));
+
+        if (victim == NULL ||
+            (reusable && !victim_reusable) ||
+            (!reusable && !victim_reusable &&
+             (now_ms - candidate->last_seen_ms) > (now_ms - victim->last_seen_ms))) {
+            victim = candidate;
+        }
+    }
+
+    victim->key = key;
+    victim->first_seen_ms = now_ms;
+    victim->last_seen_ms = now_ms;
+    victim->max_speed_centi_kmh = speed_centi_kmh;
+    victim->count = 1;
+
+    if (entry != NULL) {
+        *entry = victim;
+    }
+    return PLATE_CACHE_NEW;
+}
+
+#endif /* RADAR_PLATE_CACHE_H */
@@ -7,13 +7,23 @@
  * - Argentina: AB123CD (2L-3N-2L)
  * - Paraguai: ABCD123 (4L-3N)
  * - Uruguai: ABC1234 (3L-4N)
+ * 
+ * E também os formatos regionais:
+ * - Brasil (antigo): ABC1234 (3L-4N, igual ao Uruguai)
+ * - Chile: BCDF12 (4L-2N)
+ * - Bolívia: 1234ABC (4N-3L)
+ * 
+ * Os formatos são dados (PLATE_FORMATS): cada um é um padrão de 'L'
+ * (letra) e 'N' (dígito). Em tempo de compilação os padrões viram uma
+ * máscara por posição e classe de caractere, e a validação é uma única
+ * passada pela placa que intersecta as máscaras.
  */
 
 #ifndef RADAR_PLATE_VALIDATOR_H
 #define RADAR_PLATE_VALIDATOR_H
 
 #include <stdbool.h>
-#include <ctype.h>
+#include <stdint.h>
 #include <string.h>
 
 /**
@@ -24,209 +34,206 @@ typedef enum {
     COUNTRY_BRAZIL,     /**< Brasil: ABC1D23 */
     COUNTRY_ARGENTINA,  /**< Argentina: AB123CD */
     COUNTRY_PARAGUAY,   /**< Paraguai: ABCD123 */
-    COUNTRY_URUGUAY     /**< Uruguai: ABC1234 */
+    COUNTRY_URUGUAY,    /**< Uruguai: ABC1234 */
+    COUNTRY_CHILE,      /**< Chile: BCDF12 */
+    COUNTRY_BOLIVIA     /**< Bolívia: 1234ABC */
 } mercosul_country_t;
 
 /**
- * @brief Valida se uma placa segue o formato Mercosul BRASILEIRO
+ * @brief Formatos de placa reconhecidos: X(id, país, padrão)
+ * 
+ * A ordem define a prioridade quando mais de um formato casa (ex:
+ * ABC1234 é Uruguai e também Brasil antigo; vale o primeiro).
+ * Para um novo formato basta acrescentar uma linha.
+ */
+#define PLATE_FORMATS(X, ...)                                                \
+    X(PLATE_FMT_BRAZIL,        COUNTRY_BRAZIL,    "LLLNLNN", __VA_ARGS__)    \
+    X(PLATE_FMT_ARGENTINA,     COUNTRY_ARGENTINA, "LLNNNLL", __VA_ARGS__)    \
+    X(PLATE_FMT_PARAGUAY,      COUNTRY_PARAGUAY,  "LLLLNNN", __VA_ARGS__)    \
+    X(PLATE_FMT_URUGUAY,       COUNTRY_URUGUAY,   "LLLNNNN", __VA_ARGS__)    \
+    X(PLATE_FMT_BRAZIL_LEGACY, COUNTRY_BRAZIL,    "LLLNNNN", __VA_ARGS__)    \
+    X(PLATE_FMT_CHILE,         COUNTRY_CHILE,     "LLLLNN",  __VA_ARGS__)    \
+    X(PLATE_FMT_BOLIVIA,       COUNTRY_BOLIVIA,   "NNNNLLL", __VA_ARGS__)
+
+/**
+ * Comprimento máximo tratado: um a mais que o maior padrão (7), para
+ * rejeitar pelo comprimento antes de sair da tabela, e o que cabe na
+ * chave de 64 bits de plate_pack_key()
+ */
+#define PLATE_MAX_LEN 8
+
+#define PLATE_FMT_ENUM(id, country, pattern, ...) id,
+
+/**
+ * @brief Identificador de cada formato (bit na máscara de candidatos)
+ */
+typedef enum {
+    PLATE_FORMATS(PLATE_FMT_ENUM, _)
+    PLATE_FMT_COUNT
+} plate_format_t;
+
+_Static_assert(PLATE_FMT_COUNT <= 32, "Máscara de formatos tem 32 bits");
+
+/* Máscaras geradas em tempo de compilação a partir dos padrões */
+#define PLATE_POS_BIT(id, country, pattern, pos, cls)                        \
+    ((sizeof(pattern) > (pos) + 1 && (pattern)[pos] == (cls)) ? (1UL << (id)) : 0UL) |
+#define PLATE_LEN_BIT(id, country, pattern, len)                             \
+    ((sizeof(pattern) - 1 == (len)) ? (1UL << (id)) : 0UL) |
+#define PLATE_FMT_COUNTRY(id, country, pattern, ...) [id] = country,
+
+#define PLATE_CLASS_MASKS(pos)                                               \
+    { PLATE_FORMATS(PLATE_POS_BIT, pos, 'L') 0UL,                            \
+      PLATE_FORMATS(PLATE_POS_BIT, pos, 'N') 0UL }
+#define PLATE_LEN_MASK(len) (PLATE_FORMATS(PLATE_LEN_BIT, len) 0UL)
+
+/**
+ * @brief Encontra todos os formatos que uma placa satisfaz
  * 
- * Formato Brasil: ABC1D23
- * - 3 letras (A-Z)
- * - 1 dígito (0-9)
- * - 1 letra (A-Z)
- * - 2 dígitos (0-9)
+ * Uma única passada: cada caractere é classificado (letra/dígito) e
+ * a máscara de candidatos é intersectada com a da posição. Letras
+ * minúsculas são aceitas, como em isalpha().
  * 
- * @param plate String com a placa (deve ter 7 caracteres + \0)
- * @return true se válida, false caso contrário
+ * @param plate String com a placa
+ * @return Máscara de bits de plate_format_t (0 se nenhum formato casa)
  */
-static inline bool validate_brazil_plate(const char *plate)
+static inline uint32_t plate_match_formats(const char *plate)
 {
-    if (plate == NULL || strlen(plate) != 7) {
-        return false;
-    }
+    static const uint32_t class_masks[PLATE_MAX_LEN][2] = {
+        PLATE_CLASS_MASKS(0), PLATE_CLASS_MASKS(1), PLATE_CLASS_MASKS(2),
+        PLATE_CLASS_MASKS(3), PLATE_CLASS_MASKS(4), PLATE_CLASS_MASKS(5),
+        PLATE_CLASS_MASKS(6), PLATE_CLASS_MASKS(7),
+    };
+    static const uint32_t len_masks[PLATE_MAX_LEN + 1] = {
+        PLATE_LEN_MASK(0), PLATE_LEN_MASK(1), PLATE_LEN_MASK(2),
+        PLATE_LEN_MASK(3), PLATE_LEN_MASK(4), PLATE_LEN_MASK(5),
+        PLATE_LEN_MASK(6), PLATE_LEN_MASK(7), PLATE_LEN_MASK(8),
+    };
+    uint32_t candidates = (1UL << PLATE_FMT_COUNT) - 1;
+    size_t len;
     
-    /* Posições 0, 1, 2: letras */
-    if (!isalpha((unsigned char)plate[0]) || 
-        !isalpha((unsigned char)plate[1]) || 
-        !isalpha((unsigned char)plate[2])) {
-        return false;
+    if (plate == NULL) {
+        return 0;
     }
     
-    /* Posição 3: dígito */
-    if (!isdigit((unsigned char)plate[3])) {
-        return false;
-    }
-    
-    /* Posição 4: letra */
-    if (!isalpha((unsigned char)plate[4])) {
-        return false;
+    for (len = 0; plate[len] != '\0'; len++) {
+        unsigned char c = (unsigned char)plate[len];
+        
+        if (len >= PLATE_MAX_LEN) {
+            return 0;
+        }
+        
+        if ((unsigned char)((c | 0x20) - 'a') < 26) {
+            candidates &= class_masks[len][0];
+        } else if ((unsigned char)(c - '0') < 10) {
+            candidates &= class_masks[len][1];
+        } else {
+            return 0;
+        }
+        
+        if (candidates == 0) {
+            return 0;
+        }
     }
     
-    /* Posições 5, 6: dígitos */
-    if (!isdigit((unsigned char)plate[5]) || 
-        !isdigit((unsigned char)plate[6])) {
-        return false;
-    }
+    return candidates & len_masks[len];
+}
+
+/**
+ * @brief País de um formato de placa
+ */
+static inline mercosul_country_t plate_format_country(plate_format_t format)
+{
+    static const mercosul_country_t countries[PLATE_FMT_COUNT] = {
+        PLATE_FORMATS(PLATE_FMT_COUNTRY, _)
+    };
     
-    return true;
+    return (format < PLATE_FMT_COUNT) ? countries[format] : COUNTRY_UNKNOWN;
 }
 
 /**
- * @brief Valida se uma placa segue o formato Mercosul ARGENTINO
- * 
- * Formato Argentina: AB123CD
- * - 2 letras (A-Z)
- * - 3 dígitos (0-9)
- * - 2 letras (A-Z)
+ * @brief Identifica o país de origem da placa e valida
  * 
- * @param plate String com a placa (deve ter 7 caracteres + \0)
- * @return true se válida, false caso contrário
+ * @param plate String com a placa
+ * @param country Ponteiro para receber o país identificado (pode ser NULL)
+ * @return true se a placa é válida em algum formato conhecido, false caso contrário
  */
-static inline bool validate_argentina_plate(const char *plate)
+static inline bool validate_mercosul_plate(const char *plate, mercosul_country_t *country)
 {
-    if (plate == NULL || strlen(plate) != 7) {
-        return false;
-    }
+    uint32_t formats = plate_match_formats(plate);
     
-    /* Posições 0, 1: letras */
-    if (!isalpha((unsigned char)plate[0]) || 
-        !isalpha((unsigned char)plate[1])) {
-        return false;
-    }
-    
-    /* Posições 2, 3, 4: dígitos */
-    if (!isdigit((unsigned char)plate[2]) || 
-        !isdigit((unsigned char)plate[3]) ||
-        !isdigit((unsigned char)plate[4])) {
-        return false;
-    }
-    
-    /* Posições 5, 6: letras */
-    if (!isalpha((unsigned char)plate[5]) || 
-        !isalpha((unsigned char)plate[6])) {
-        return false;
+    if (country != NULL) {
+        /* Menor bit = formato de maior prioridade */
+        *country = (formats != 0)
+            ? plate_format_country((plate_format_t)__builtin_ctz(formats))
+            : COUNTRY_UNKNOWN;
     }
     
-    return true;
+    return formats != 0;
 }
 
 /**
- * @brief Valida se uma placa segue o formato Mercosul PARAGUAIO
+ * @brief Copia a placa sem espaços (o camera_service insere espaços)
  * 
- * Formato Paraguai: ABCD123
- * - 4 letras (A-Z)
- * - 3 dígitos (0-9)
+ * Como strlcpy(), o retorno é o comprimento que a placa limpa teria:
+ * se for >= dst_size, a cópia foi truncada.
  * 
- * @param plate String com a placa (deve ter 7 caracteres + \0)
- * @return true se válida, false caso contrário
+ * @param dst Destino (sempre terminado em \0 se dst_size > 0)
+ * @param dst_size Tamanho do destino
+ * @param src Placa recebida
+ * @return Número de caracteres não-espaço em src
  */
-static inline bool validate_paraguay_plate(const char *plate)
+static inline size_t plate_strip_spaces(char *dst, size_t dst_size, const char *src)
 {
-    if (plate == NULL || strlen(plate) != 7) {
-        return false;
-    }
+    size_t out = 0;
     
-    /* Posições 0, 1, 2, 3: letras */
-    if (!isalpha((unsigned char)plate[0]) || 
-        !isalpha((unsigned char)plate[1]) ||
-        !isalpha((unsigned char)plate[2]) || 
-        !isalpha((unsigned char)plate[3])) {
-        return false;
+    for (; *src != '\0'; src++) {
+        if (*src == ' ') {
+            continue;
+        }
+        if (out + 1 < dst_size) {
+            dst[out] = *src;
+        }
+        out++;
     }
     
-    /* Posições 4, 5, 6: dígitos */
-    if (!isdigit((unsigned char)plate[4]) || 
-        !isdigit((unsigned char)plate[5]) ||
-        !isdigit((unsigned char)plate[6])) {
-        return false;
+    if (dst_size > 0) {
+        dst[(out < dst_size) ? out : dst_size - 1] = '\0';
     }
     
-    return true;
+    return out;
 }
 
 /**
- * @brief Valida se uma placa segue o formato Mercosul URUGUAIO
- * 
- * Formato Uruguai: ABC1234
- * - 3 letras (A-Z)
- * - 4 dígitos (0-9)
+ * @brief Compacta uma placa (até 8 caracteres) em uma chave de 64 bits
  * 
- * @param plate String com a placa (deve ter 7 caracteres + \0)
- * @return true se válida, false caso contrário
+ * Um byte por caractere, o primeiro no byte menos significativo. A
+ * chave é reversível (plate_unpack_key) e 0 representa "sem placa".
  */
-static inline bool validate_uruguay_plate(const char *plate)
+static inline uint64_t plate_pack_key(const char *plate)
 {
-    if (plate == NULL || strlen(plate) != 7) {
-        return false;
-    }
-    
-    /* Posições 0, 1, 2: letras */
-    if (!isalpha((unsigned char)plate[0]) || 
-        !isalpha((unsigned char)plate[1]) ||
-        !isalpha((unsigned char)plate[2])) {
-        return false;
-    }
+    uint64_t key = 0;
     
-    /* Posições 3, 4, 5, 6: dígitos */
-    if (!isdigit((unsigned char)plate[3]) || 
-        !isdigit((unsigned char)plate[4]) ||
-        !isdigit((unsigned char)plate[5]) ||
-        !isdigit((unsigned char)plate[6])) {
-        return false;
+    for (int i = 0; i < PLATE_MAX_LEN && plate[i] != '\0'; i++) {
+        key |= (uint64_t)(uint8_t)plate[i] << (8 * i);
     }
     
-    return true;
+    return key;
 }
 
 /**
- * @brief Identifica o país de origem da placa e valida
+ * @brief Reconstrói a placa a partir da chave
  * 
- * @param plate String com a placa
- * @param country Ponteiro para receber o país identificado (pode ser NULL)
- * @return true se a placa é válida em algum formato Mercosul, false caso contrário
+ * @param key Chave de plate_pack_key
+ * @param dst Destino com pelo menos PLATE_MAX_LEN + 1 bytes
  */
-static inline bool validate_mercosul_plate(const char *plate, mercosul_country_t *country)
+static inline void plate_unpack_key(uint64_t key, char *dst)
 {
-    if (plate == NULL || strlen(plate) != 7) {
-        if (country != NULL) {
-            *country = COUNTRY_UNKNOWN;
-        }
-        return false;
-    }
-    
-    /* Tenta validar em cada formato */
-    if (validate_brazil_plate(plate)) {
-        if (country != NULL) {
-            *country = COUNTRY_BRAZIL;
-        }
-        return true;
-    }
-    
-    if (validate_argentina_plate(plate)) {
-        if (country != NULL) {
-            *country = COUNTRY_ARGENTINA;
-        }
-        return true;
-    }
-    
-    if (validate_paraguay_plate(plate)) {
-        if (country != NULL) {
-            *country = COUNTRY_PARAGUAY;
-        }
-        return true;
-    }
+    int i = 0;
     
-    if (validate_uruguay_plate(plate)) {
-        if (country != NULL) {
-            *country = COUNTRY_URUGUAY;
-        }
-        return true;
-    }
-    
-    if (country != NULL) {
-        *country = COUNTRY_UNKNOWN;
+    for (; i < PLATE_MAX_LEN && (key >> (8 * i)) != 0; i++) {
+        dst[i] = (char)(key >> (8 * i));
     }
-    return false;
+    dst[i] = '\0';
 }
 
 /**
@@ -246,6 +253,10 @@ static inline const char* get_country_name(mercosul_country_t country)
             return "Paraguai";
         case COUNTRY_URUGUAY:
             return "Uruguai";
+        case COUNTRY_CHILE:
+            return "Chile";
+        case COUNTRY_BOLIVIA:
+            return "Bolivia";
         default:
             return "Desconhecido";
     }
@@ -0,0 +1,200 @@
+/**
+ * @file radar_config.h
+ * @brief Configuração ajustável em tempo de execução (snapshot versionado)
+ *
+ * Limites, limiar de alerta e distância entre sensores ficam em um
+ * snapshot imutável. O leitor (thread principal, uma vez por veículo)
+ * carrega o ponteiro atual com atomic_ptr_get(): sem trava e sem
+ * consulta ao subsistema de settings no caminho de detecção.
+ *
+ * O escritor monta o próximo snapshot em outro slot do anel, com versão
+ * incrementada, e o publica trocando o ponteiro. Um slot só é reescrito
+ * depois de RADAR_CONFIG_SLOTS - 1 publicações posteriores; o leitor não
+ * deve guardar o ponteiro além do processamento de um veículo.
+ * Escritores devem ser serializados por quem chama.
+ */
+
+#ifndef RADAR_CONFIG_H
+#define RADAR_CONFIG_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Valores iniciais (Kconfig) */
+#ifdef CONFIG_RADAR_SENSOR_DISTANCE_MM
+#define RADAR_CONFIG_DEFAULT_DISTANCE_MM CONFIG_RADAR_SENSOR_DISTANCE_MM
+#else
+#define RADAR_CONFIG_DEFAULT_DISTANCE_MM 1000
+#endif
+
+#ifdef CONFIG_RADAR_SPEED_LIMIT_LIGHT_KMH
+#define RADAR_CONFIG_DEFAULT_LIMIT_LIGHT CONFIG_RADAR_SPEED_LIMIT_LIGHT_KMH
+#else
+#define RADAR_CONFIG_DEFAULT_LIMIT_LIGHT 60
+#endif
+
+#ifdef CONFIG_RADAR_SPEED_LIMIT_HEAVY_KMH
+#define RADAR_CONFIG_DEFAULT_LIMIT_HEAVY CONFIG_RADAR_SPEED_LIMIT_HEAVY_KMH
+#else
+#define RADAR_CONFIG_DEFAULT_LIMIT_HEAVY 40
+#endif
+
+#ifdef CONFIG_RADAR_WARNING_THRESHOLD_PERCENT
+#define RADAR_CONFIG_DEFAULT_WARNING_PERCENT CONFIG_RADAR_WARNING_THRESHOLD_PERCENT
+#else
+#define RADAR_CONFIG_DEFAULT_WARNING_PERCENT 90
+#endif
+
+/** Slots do anel de snapshots */
+#define RADAR_CONFIG_SLOTS 4
+
+/* Faixas aceitas na atualização */
+#define RADAR_CONFIG_DISTANCE_MIN_MM 100
+#define RADAR_CONFIG_DISTANCE_MAX_MM 10000
+#define RADAR_CONFIG_LIMIT_MIN_KMH 10
+#define RADAR_CONFIG_LIMIT_MAX_KMH 200
+#define RADAR_CONFIG_WARNING_MIN_PERCENT 50
+#define RADAR_CONFIG_WARNING_MAX_PERCENT 99
+
+/**
+ * @brief Snapshot da configuração (imutável depois de publicado)
+ */
+typedef struct {
+    uint32_t version;                   /**< Incrementada a cada publicação */
+    uint32_t sensor_distance_mm;        /**< Distância entre sensores (mm) */
+    uint32_t speed_limit_light_kmh;     /**< Limite de veículos leves (km/h) */
+    uint32_t speed_limit_heavy_kmh;     /**< Limite de veículos pesados (km/h) */
+    uint32_t warning_threshold_percent; /**< % do limite para alerta amarelo */
+} radar_config_t;
+
+/**
+ * @brief Anel de snapshots e ponteiro publicado
+ */
+struct radar_config_store {
+    radar_config_t slots[RADAR_CONFIG_SLOTS];
+    atomic_ptr_t current;   /**< Snapshot publicado (const radar_config_t *) */
+    uint32_t next_slot;     /**< Próximo slot a escrever (apenas o escritor) */
+};
+
+/** Snapshot com os valores do Kconfig (versão 0) */
+#define RADAR_CONFIG_DEFAULTS                                           \
+    {                                                                   \
+        .version = 0,                                                   \
+        .sensor_distance_mm = RADAR_CONFIG_DEFAULT_DISTANCE_MM,         \
+        .speed_limit_light_kmh = RADAR_CONFIG_DEFAULT_LIMIT_LIGHT,      \
+        .speed_limit_heavy_kmh = RADAR_CONFIG_DEFAULT_LIMIT_HEAVY,      \
+        .warning_threshold_percent = RADAR_CONFIG_DEFAULT_WARNING_PERCENT, \
+    }
+
+/**
+ * @brief Inicializador estático: o snapshot padrão já está publicado
+ *
+ * Leitores que rodam antes do carregamento dos settings veem os valores
+ * do Kconfig.
+ */
+#define RADAR_CONFIG_STORE_INITIALIZER(store)                   \
+    {                                                           \
+        .slots = { [0] = RADAR_CONFIG_DEFAULTS },               \
+        .current = ATOMIC_PTR_INIT(&(store).slots[0]),          \
+        .next_slot = 1,                                         \
+    }
+
+/**
+ * @brief Snapshot atual (caminho de detecção: sem trava)
+ */
+static inline const radar_config_t *radar_config_get(struct radar_config_store *store)
+{
+    return (const radar_config_t *)atomic_ptr_get(&store->current);
+}
+
+/**
+ * @brief Verifica se os valores estão nas faixas aceitas
+ *
+ * @return 0 ou -EINVAL
+ */
+static inline int radar_config_validate(const radar_config_t *cfg)
+{
+    if (cfg->sensor_distance_mm < RADAR_CONFIG_DISTANCE_MIN_MM ||
+        cfg->sensor_distance_mm > RADAR_CONFIG_DISTANCE_MAX_MM) {
+        return -EINVAL;
+    }
+    if (cfg->speed_limit_light_kmh < RADAR_CONFIG_LIMIT_MIN_KMH ||
+        cfg->speed_limit_light_kmh > RADAR_CONFIG_LIMIT_MAX_KMH ||
+        cfg->speed_limit_heavy_kmh < RADAR_CONFIG_LIMIT_MIN_KMH ||
+        cfg->speed_limit_heavy_kmh > RADAR_CONFIG_LIMIT_MAX_KMH) {
+        return -EINVAL;
+    }
+    if (cfg->warning_threshold_percent < RADAR_CONFIG_WARNING_MIN_PERCENT ||
+        cfg->warning_threshold_percent > RADAR_CONFIG_WARNING_MAX_PERCENT) {
+        return -EINVAL;
+    }
+    return 0;
+}
+
+/**
+ * @brief Publica um novo snapshot (escritores serializados)
+ *
+ * A versão do snapshot é a do atual mais um; a de next é ignorada.
+ *
+ * @return Snapshot publicado, ou NULL se os valores são inválidos
+ */
+static inline const radar_config_t *radar_config_publish(struct radar_config_store *store,
+                                                         const radar_config_t *next)
+{
+    if (radar_config_validate(next) != 0) {
+        return NULL;
+    }
+
+    const radar_config_t *current = radar_config_get(store);
+    radar_config_t *slot = &store->slots[store->next_slot];
+
+    *slot = *next;
+    slot->version = current->version + 1;
+    store->next_slot = (store->next_slot + 1) % RADAR_CONFIG_SLOTS;
+
+    /* Só publica depois de escrito (atomic_ptr_set é uma barreira) */
+    atomic_ptr_set(&store->current, slot);
+    return slot;
+}
+
+/** Chaves dos campos ajustáveis (settings "radar/<chave>" e shell) */
+#define RADAR_CONFIG_KEY_COUNT 4
+
+/**
+ * @brief Nome da i-ésima chave (NULL fora da faixa)
+ */
+static inline const char *radar_config_key(int index)
+{
+    static const char *const keys[RADAR_CONFIG_KEY_COUNT] = {
+        "distance_mm", "limit_light", "limit_heavy", "warning_pct"
+    };
+
+    return (index >= 0 && index < RADAR_CONFIG_KEY_COUNT) ? keys[index] : NULL;
+}
+
+/**
+ * @brief Campo de cfg correspondente à chave
+ *
+ * @return Ponteiro para o campo, ou NULL se a chave não existe
+ */
+static inline uint32_t *radar_config_field(radar_config_t *cfg, const char *key)
+{
+    uint32_t *fields[RADAR_CONFIG_KEY_COUNT] = {
+        &cfg->sensor_distance_mm,
+        &cfg->speed_limit_light_kmh,
+        &cfg->speed_limit_heavy_kmh,
+        &cfg->warning_threshold_percent,
+    };
+
+    for (int i = 0; i < RADAR_CONFIG_KEY_COUNT; i++) {
+        if (strcmp(key, radar_config_key(i)) == 0) {
+            return fields[i];
+        }
+    }
+    return NULL;
+}
+
+#endif /* RADAR_CONFIG_H */
@@ -0,0 +1,132 @@
+/**
+ * @file radar_stats.h
+ * @brief Contadores do pipeline para inspeção em tempo de execução
+ *
+ * Detecções por tipo, por classe de eixos e por faixa, infrações,
+ * resultados da câmera, descartes em cada fila e o nível máximo
+ * (high-water mark) das filas.
+ * Todos os contadores são atômicos: os estágios incrementam sem trava e
+ * o shell (radar_shell.c) lê a qualquer momento sem bloquear o caminho
+ * de detecção.
+ */
+
+#ifndef RADAR_STATS_H
+#define RADAR_STATS_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <stdint.h>
+#include "../types.h"
+
+/** Faixas com contadores próprios (as mesmas das estatísticas de tráfego) */
+#ifdef CONFIG_RADAR_TRAFFIC_MAX_LANES
+#define RADAR_STATS_MAX_LANES CONFIG_RADAR_TRAFFIC_MAX_LANES
+#else
+#define RADAR_STATS_MAX_LANES 2
+#endif
+
+/**
+ * @brief Contadores de uma faixa
+ */
+struct radar_lane_stats {
+    atomic_t detections;  /**< Veículos detectados */
+    atomic_t violations;  /**< Infrações */
+};
+
+/**
+ * @brief Contadores do pipeline
+ */
+struct radar_stats {
+    atomic_t detections[VEHICLE_TYPE_COUNT]; /**< Veículos por tipo (leve/pesado) */
+    atomic_t classes[VEHICLE_CLASS_COUNT];   /**< Veículos por classe de eixos */
+    atomic_t violations;         /**< Infrações detectadas */
+    atomic_t camera_ok;          /**< Placas válidas capturadas */
+    atomic_t camera_error;       /**< Erros da câmera (ERRxxx) */
+    atomic_t camera_invalid;     /**< Placas em formato inválido */
+    atomic_t camera_timeout;     /**< Capturas sem resultado no prazo */
+    atomic_t capture_drops;      /**< Infrações sem captura (pendentes esgotadas ou trigger falhou) */
+    atomic_t edge_drops;         /**< Bordas perdidas (edge_ring cheia) */
+    atomic_t tracker_drops;      /**< Veículos perdidos na faixa (FIFO cheia ou sem sensor 2) */
+    atomic_t pool_drops;         /**< Detecções perdidas (pool de veículos esgotado) */
+    atomic_t sensor_drops;       /**< Detecções perdidas (sensor_msgq cheia) */
+    atomic_t display_drops;      /**< Quadros perdidos (display_msgq cheia) */
+    atomic_t journal_drops;      /**< Infrações não persistidas (journal_msgq cheia, inclusive com lote retido) */
+    atomic_t sensor_msgq_hwm;    /**< Maior ocupação da sensor_msgq */
+    atomic_t display_msgq_hwm;   /**< Maior ocupação da display_msgq */
+    struct radar_lane_stats lanes[RADAR_STATS_MAX_LANES];
+};
+
+/**
+ * @brief Eleva o contador a value, se maior (seguro de qualquer thread)
+ */
+static inline void radar_stats_raise(atomic_t *target, uint32_t value)
+{
+    atomic_val_t current = atomic_get(target);
+
+    while ((uint32_t)current < value && !atomic_cas(target, current, (atomic_val_t)value)) {
+        current = atomic_get(target);
+    }
+}
+
+/**
+ * @brief Registra uma detecção (classe, faixa e infração)
+ */
+static inline void radar_stats_detection(struct radar_stats *stats, vehicle_type_t type,
+                                         uint8_t lane_id, bool violation)
+{
+    if (type < VEHICLE_TYPE_COUNT) {
+        atomic_inc(&stats->detections[type]);
+    }
+    if (violation) {
+        atomic_inc(&stats->violations);
+    }
+    if (lane_id < RADAR_STATS_MAX_LANES) {
+        atomic_inc(&stats->lanes[lane_id].detections);
+        if (violation) {
+            atomic_inc(&stats->lanes[lane_id].violations);
+        }
+    }
+}
+
+/**
+ * @brief Registra a classe de eixos de uma detecção
+ */
+static inline void radar_stats_class(struct radar_stats *stats, vehicle_class_t vehicle_class)
+{
+    if (vehicle_class < VEHICLE_CLASS_COUNT) {
+        atomic_inc(&stats->classes[vehicle_class]);
+    }
+}
+
+/**
+ * @brief Total de detecções (todos os tipos)
+ */
+static inline uint32_t radar_stats_total_detections(const struct radar_stats *stats)
+{
+    uint32_t total = 0;
+
+    for (int i = 0; i < VEHICLE_TYPE_COUNT; i++) {
+        total += (uint32_t)atomic_get(&stats->detections[i]);
+    }
+    return total;
+}
+
+/**
+ * @brief Zera todos os contadores
+ *
+ * Cada contador é zerado atomicamente; incrementos concorrentes podem
+ * cair antes ou depois do reset, sem corromper nada.
+ */
+static inline void radar_stats_reset(struct radar_stats *stats)
+{
+    atomic_t *counters = (atomic_t *)stats;
+
+    for (size_t i = 0; i < sizeof(*stats) / sizeof(atomic_t); i++) {
+        atomic_clear(&counters[i]);
+    }
+}
+
+BUILD_ASSERT(sizeof(struct radar_stats) % sizeof(atomic_t) == 0,
+             "struct radar_stats deve conter apenas atomic_t");
+
+#endif /* RADAR_STATS_H */
@@ -0,0 +1,324 @@
+/**
+ * @file sign_render.h
+ * @brief Renderização do painel de velocidade em framebuffer
+ *
+ * Framebuffer RGB565 de SIGN_WIDTH x SIGN_HEIGHT dividido em regiões
+ * fixas (status, velocidade, limite, placa). Uma atualização só
+ * redesenha as regiões cujo conteúdo mudou e as marca como sujas; o
+ * backend envia ao display apenas esses retângulos.
+ *
+ *   +--------------------------------------+
+ *   | STATUS                        TIPO   |  status (cor do status)
+ *   +----------------------------+---------+
+ *   |  888                       | LIM     |
+ *   |  888  (velocidade, km/h)   |  60     |  velocidade | limite
+ *   |                            | KM/H    |
+ *   +----------------------------+---------+
+ *   |  ABC1D23                             |  placa
+ *   +--------------------------------------+
+ */
+
+#ifndef RADAR_SIGN_RENDER_H
+#define RADAR_SIGN_RENDER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+#include "../types.h"
+#include "display_format.h"
+
+/** Resolução do painel (pixels) */
+#define SIGN_WIDTH 160
+#define SIGN_HEIGHT 80
+
+/** Cores RGB565 */
+#define SIGN_COLOR_BLACK  0x0000U
+#define SIGN_COLOR_WHITE  0xFFFFU
+#define SIGN_COLOR_GREEN  0x07E0U
+#define SIGN_COLOR_YELLOW 0xFFE0U
+#define SIGN_COLOR_RED    0xF800U
+
+/** Fonte 5x7: avanço de 6 colunas por caractere (escala 1) */
+#define SIGN_GLYPH_W 5
+#define SIGN_GLYPH_H 7
+#define SIGN_GLYPH_ADVANCE 6
+
+/**
+ * @brief Retângulo do painel
+ */
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    uint16_t w;
+    uint16_t h;
+} sign_rect_t;
+
+/**
+ * @brief Regiões atualizadas independentemente
+ */
+typedef enum {
+    SIGN_REGION_STATUS = 0,
+    SIGN_REGION_SPEED,
+    SIGN_REGION_LIMIT,
+    SIGN_REGION_PLATE,
+    SIGN_REGION_COUNT
+} sign_region_t;
+
+static const sign_rect_t sign_regions[SIGN_REGION_COUNT] = {
+    [SIGN_REGION_STATUS] = { 0, 0, SIGN_WIDTH, 15 },
+    [SIGN_REGION_SPEED] = { 0, 15, 112, 43 },
+    [SIGN_REGION_LIMIT] = { 112, 15, 48, 43 },
+    [SIGN_REGION_PLATE] = { 0, 58, SIGN_WIDTH, 22 },
+};
+
+/** Todas as regiões sujas */
+#define SIGN_DIRTY_ALL ((1U << SIGN_REGION_COUNT) - 1U)
+
+/**
+ * @brief Painel: framebuffer e conteúdo exibido
+ */
+struct sign_panel {
+    uint16_t fb[SIGN_HEIGHT][SIGN_WIDTH]; /**< Pixels RGB565 */
+    uint32_t dirty;                       /**< Máscara de regiões a enviar */
+    bool drawn;                           /**< Algum veículo já foi desenhado */
+    display_data_msg_t shown;             /**< Dados desenhados */
+};
+
+/* Fonte 5x7 (uma coluna por byte, bit 0 = linha de cima): espaço, - . / 0-9 A-Z */
+static const uint8_t sign_font_symbols[][SIGN_GLYPH_W] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }, /* ' ' */
+    { 0x08, 0x08, 0x08, 0x08, 0x08 }, /* '-' */
+    { 0x00, 0x60, 0x60, 0x00, 0x00 }, /* '.' */
+    { 0x20, 0x10, 0x08, 0x04, 0x02 }, /* '/' */
+};
+
+static const uint8_t sign_font_digits[10][SIGN_GLYPH_W] = {
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 },
+    { 0x42, 0x61, 0x51, 0x49, 0x46 }, { 0x21, 0x41, 0x45, 0x4B, 0x31 },
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 }, { 0x27, 0x45, 0x45, 0x45, 0x39 },
+    { 0x3C, 0x4A, 0x49, 0x49, 0x30 }, { 0x01, 0x71, 0x09, 0x05, 0x03 },
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x06, 0x49, 0x49, 0x29, 0x1E },
+};
+
+static const uint8_t sign_font_letters[26][SIGN_GLYPH_W] = {
+    { 0x7E, 0x11, 0x11, 0x11, 0x7E }, { 0x7F, 0x49, 0x49, 0x49, 0x36 },
+    { 0x3E, 0x41, 0x41, 0x41, 0x22 }, { 0x7F, 0x41, 0x41, 0x22, 0x1C },
+    { 0x7F, 0x49, 0x49, 0x49, 0x41 }, { 0x7F, 0x09, 0x09, 0x09, 0x01 },
+    { 0x3E, 0x41, 0x49, 0x49, 0x7A }, { 0x7F, 0x08, 0x08, 0x08, 0x7F },
+    { 0x00, 0x41, 0x7F, 0x41, 0x00 }, { 0x20, 0x40, 0x41, 0x3F, 0x01 },
+    { 0x7F, 0x08, 0x14, 0x22, 0x41 }, { 0x7F, 0x40, 0x40, 0x40, 0x40 },
+    { 0x7F, 0x02, 0x0C, 0x02, 0x7F }, { 0x7F, 0x04, 0x08, 0x10, 0x7F },
+    { 0x3E, 0x41, 0x41, 0x41, 0x3E }, { 0x7F, 0x09, 0x09, 0x09, 0x06 },
+    { 0x3E, 0x41, 0x51, 0x21, 0x5E }, { 0x7F, 0x09, 0x19, 0x29, 0x46 },
+    { 0x46, 0x49, 0x49, 0x49, 0x31 }, { 0x01, 0x01, 0x7F, 0x01, 0x01 },
+    { 0x3F, 0x40, 0x40, 0x40, 0x3F }, { 0x1F, 0x20, 0x40, 0x20, 0x1F },
+    { 0x3F, 0x40, 0x38, 0x40, 0x3F }, { 0x63, 0x14, 0x08, 0x14, 0x63 },
+    { 0x07, 0x08, 0x70, 0x08, 0x07 }, { 0x61, 0x51, 0x49, 0x45, 0x43 },
+};
+
+/**
+ * @brief Colunas do glifo de um caractere (desconhecidos viram espaço)
+ */
+static inline const uint8_t *sign_glyph(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return sign_font_digits[c - '0'];
+    }
+    if (c >= 'a' && c <= 'z') {
+        c = (char)(c - 'a' + 'A');
+    }
+    if (c >= 'A' && c <= 'Z') {
+        return sign_font_letters[c - 'A'];
+    }
+    switch (c) {
+    case '-':
+        return sign_font_symbols[1];
+    case '.':
+        return sign_font_symbols[2];
+    case '/':
+        return sign_font_symbols[3];
+    default:
+        return sign_font_symbols[0];
+    }
+}
+
+/**
+ * @brief Preenche um retângulo (recortado ao painel)
+ */
+static inline void sign_fill_rect(struct sign_panel *panel, int x, int y, int w, int h,
+                                  uint16_t color)
+{
+    int x1 = MIN(x + w, SIGN_WIDTH);
+    int y1 = MIN(y + h, SIGN_HEIGHT);
+
+    for (int row = MAX(y, 0); row < y1; row++) {
+        for (int col = MAX(x, 0); col < x1; col++) {
+            panel->fb[row][col] = color;
+        }
+    }
+}
+
+/**
+ * @brief Desenha texto com a fonte 5x7 ampliada (apenas os pixels acesos)
+ */
+static inline void sign_draw_text(struct sign_panel *panel, int x, int y, const char *text,
+                                  int scale, uint16_t color)
+{
+    for (; *text != '\0'; text++, x += SIGN_GLYPH_ADVANCE * scale) {
+        const uint8_t *glyph = sign_glyph(*text);
+
+        for (int col = 0; col < SIGN_GLYPH_W; col++) {
+            for (int row = 0; row < SIGN_GLYPH_H; row++) {
+                if (glyph[col] & BIT(row)) {
+                    sign_fill_rect(panel, x + col * scale, y + row * scale,
+                                   scale, scale, color);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Cor do status no painel
+ */
+static inline uint16_t sign_status_color(speed_status_t status)
+{
+    switch (status) {
+    case SPEED_STATUS_WARNING:
+        return SIGN_COLOR_YELLOW;
+    case SPEED_STATUS_VIOLATION:
+        return SIGN_COLOR_RED;
+    default:
+        return SIGN_COLOR_GREEN;
+    }
+}
+
+/**
+ * @brief Escreve um número decimal (até 3 dígitos, saturado em 999)
+ */
+static inline void sign_format_uint3(char out[4], uint32_t value)
+{
+    value = MIN(value, 999U);
+    int n = (value >= 100U) ? 3 : (value >= 10U) ? 2 : 1;
+
+    out[n] = '\0';
+    for (int i = n - 1; i >= 0; i--) {
+        out[i] = (char)('0' + value % 10U);
+        value /= 10U;
+    }
+}
+
+/**
+ * @brief Redesenha uma região no framebuffer
+ */
+static inline void sign_draw_region(struct sign_panel *panel, sign_region_t region,
+                                    const display_data_msg_t *data)
+{
+    const sign_rect_t *r = &sign_regions[region];
+    uint16_t status_color = sign_status_color(data->status);
+    char number[4];
+
+    switch (region) {
+    case SIGN_REGION_STATUS:
+        sign_fill_rect(panel, r->x, r->y, r->w, r->h, status_color);
+        sign_draw_text(panel, r->x + 4, r->y + 4, get_status_text(data->status), 1,
+                       SIGN_COLOR_BLACK);
+        sign_draw_text(panel, r->x + r->w - 40, r->y + 4,
+                       get_vehicle_type_text(data->vehicle_type), 1, SIGN_COLOR_BLACK);
+        break;
+    case SIGN_REGION_SPEED:
+        /* Velocidade inteira em km/h, dígitos 25x35 na cor do status */
+        sign_fill_rect(panel, r->x, r->y, r->w, r->h, SIGN_COLOR_BLACK);
+        sign_format_uint3(number, data->speed_centi_kmh / 100U);
+        sign_draw_text(panel, r->x + 8, r->y + 4, number, 5, status_color);
+        break;
+    case SIGN_REGION_LIMIT:
+        sign_fill_rect(panel, r->x, r->y, r->w, r->h, SIGN_COLOR_BLACK);
+        sign_format_uint3(number, data->speed_limit);
+        sign_draw_text(panel, r->x + 4, r->y + 4, "LIM", 1, SIGN_COLOR_WHITE);
+        sign_draw_text(panel, r->x + 4, r->y + 15, number, 2, SIGN_COLOR_WHITE);
+        sign_draw_text(panel, r->x + 4, r->y + 33, "KM/H", 1, SIGN_COLOR_WHITE);
+        break;
+    case SIGN_REGION_PLATE: {
+        char plate[sizeof(data->plate) + 1];
+
+        memcpy(plate, data->plate, sizeof(data->plate));
+        plate[sizeof(data->plate)] = '\0';
+        sign_fill_rect(panel, r->x, r->y, r->w, r->h, SIGN_COLOR_BLACK);
+        sign_draw_text(panel, r->x + 8, r->y + 4, plate, 2,
+                       (strncmp(plate, "ERR", 3) == 0) ? SIGN_COLOR_RED : SIGN_COLOR_WHITE);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Região mudou em relação ao que está desenhado?
+ */
+static inline bool sign_region_changed(sign_region_t region, const display_data_msg_t *old,
+                                       const display_data_msg_t *data)
+{
+    switch (region) {
+    case SIGN_REGION_STATUS:
+        return old->status != data->status || old->vehicle_type != data->vehicle_type;
+    case SIGN_REGION_SPEED:
+        /* Mostra km/h inteiros na cor do status */
+        return old->speed_centi_kmh / 100U != data->speed_centi_kmh / 100U ||
+               old->status != data->status;
+    case SIGN_REGION_LIMIT:
+        return old->speed_limit != data->speed_limit;
+    case SIGN_REGION_PLATE:
+        return strncmp(old->plate, data->plate, sizeof(data->plate)) != 0;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Painel apagado, com tudo marcado para envio
+ */
+static inline void sign_panel_init(struct sign_panel *panel)
+{
+    sign_fill_rect(panel, 0, 0, SIGN_WIDTH, SIGN_HEIGHT, SIGN_COLOR_BLACK);
+    panel->dirty = SIGN_DIRTY_ALL;
+    panel->drawn = false;
+}
+
+/**
+ * @brief Redesenha as regiões alteradas e as marca como sujas
+ *
+ * @return Máscara das regiões redesenhadas nesta chamada
+ */
+static inline uint32_t sign_panel_update(struct sign_panel *panel,
+                                         const display_data_msg_t *data)
+{
+    uint32_t changed = 0;
+
+    for (int r = 0; r < SIGN_REGION_COUNT; r++) {
+        if (!panel->drawn || sign_region_changed(r, &panel->shown, data)) {
+            sign_draw_region(panel, r, data);
+            changed |= BIT(r);
+        }
+    }
+
+    panel->shown = *data;
+    panel->drawn = true;
+    panel->dirty |= changed;
+    return changed;
+}
+
+/**
+ * @brief Retira a máscara de regiões a enviar ao display
+ */
+static inline uint32_t sign_panel_take_dirty(struct sign_panel *panel)
+{
+    uint32_t dirty = panel->dirty;
+
+    panel->dirty = 0;
+    return dirty;
+}
+
+#endif /* RADAR_SIGN_RENDER_H */
@@ -0,0 +1,360 @@
+/**
+ * @file traffic_gen.h
+ * @brief Gerador de tráfego sintético (bordas dos sensores)
+ *
+ * Produz, em ordem de tempo, as bordas que os veículos gerariam nos
+ * sensores de cada faixa: cada eixo passa pelo sensor 1 e, depois de
+ * percorrer CONFIG_RADAR_SENSOR_DISTANCE_MM, pelo sensor 2. A thread do
+ * gerador injeta essas bordas nos GPIOs (gpio_emul), exercitando o
+ * caminho real ISR → edge_ring → máquina de estados.
+ *
+ * Modelo:
+ * - Chegadas por faixa: Poisson com taxa própria, ou em rajadas
+ *   (Poisson modulado: 1/3 do tempo a 2x a taxa, 2/3 a 0,5x, média igual)
+ * - Velocidade: aproximadamente normal (soma de 4 uniformes)
+ * - Classe: leve (2 eixos) ou pesado (3 ou 5 eixos), por percentual
+ * - Comboios: um veículo pode puxar 1 a 3 seguidores a 0,8-1,5 s
+ *
+ * Tudo em inteiros (sem float/libm) e sem alocação; o tempo é em us
+ * desde o início da geração.
+ */
+
+#ifndef RADAR_TRAFFIC_GEN_H
+#define RADAR_TRAFFIC_GEN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+#include "../types.h"
+
+#define TRAFFIC_GEN_MAX_LANES 4
+#define TRAFFIC_GEN_MAX_AXLES 5
+
+/** Bordas agendadas e ainda não entregues (todas as faixas) */
+#define TRAFFIC_GEN_MAX_EDGES 64
+
+/** Rajadas: permanência média em cada regime */
+#define TRAFFIC_GEN_BURST_HIGH_US (20ULL * 1000000ULL)
+#define TRAFFIC_GEN_BURST_LOW_US (40ULL * 1000000ULL)
+
+/** Comboios: intervalo entre veículos do comboio */
+#define TRAFFIC_GEN_PLATOON_MIN_GAP_US 800000U
+#define TRAFFIC_GEN_PLATOON_MAX_GAP_US 1500000U
+
+/**
+ * @brief Processo de chegadas
+ */
+typedef enum {
+    TRAFFIC_GEN_POISSON = 0,
+    TRAFFIC_GEN_BURSTY = 1,
+} traffic_gen_arrivals_t;
+
+/**
+ * @brief Parâmetros do gerador
+ */
+struct traffic_gen_config {
+    uint8_t lanes;                                  /**< Faixas geradas */
+    uint32_t rate_vph[TRAFFIC_GEN_MAX_LANES];       /**< Veículos/hora por faixa (0 = sem tráfego) */
+    traffic_gen_arrivals_t arrivals;                /**< Processo de chegadas */
+    uint32_t speed_mean_kmh;                        /**< Velocidade média */
+    uint32_t speed_sd_kmh;                          /**< Desvio padrão da velocidade */
+    uint32_t heavy_percent;                         /**< Veículos pesados (%) */
+    uint32_t platoon_percent;                       /**< Veículos que puxam comboio (%) */
+    uint32_t sensor_distance_mm;                    /**< Distância entre os sensores */
+};
+
+/**
+ * @brief Borda a injetar
+ */
+typedef struct {
+    uint64_t time_us;   /**< Instante desde o início da geração */
+    uint8_t lane_id;    /**< Faixa */
+    uint8_t sensor;     /**< 1 ou 2 */
+} traffic_gen_edge_t;
+
+/**
+ * @brief Veículo gerado (verdade de referência)
+ */
+typedef struct {
+    uint64_t arrival_us;          /**< Primeiro eixo no sensor 1 */
+    uint32_t speed_centi_kmh;     /**< Velocidade */
+    vehicle_type_t vehicle_type;  /**< Classe */
+    uint8_t axle_count;           /**< Eixos */
+    uint8_t lane_id;              /**< Faixa */
+} traffic_gen_vehicle_t;
+
+struct traffic_gen_lane {
+    uint64_t next_arrival_us;     /**< Próximo veículo (UINT64_MAX = sem tráfego) */
+    uint64_t regime_end_us;       /**< Fim do regime de rajada atual */
+    bool burst_high;              /**< Regime de rajada atual */
+    uint8_t platoon_left;         /**< Seguidores restantes do comboio */
+    uint32_t platoon_speed;       /**< Velocidade do líder (0,01 km/h) */
+};
+
+struct traffic_gen {
+    struct traffic_gen_config cfg;
+    uint32_t rng;                                   /**< Estado do xorshift32 */
+    struct traffic_gen_lane lanes[TRAFFIC_GEN_MAX_LANES];
+    traffic_gen_edge_t edges[TRAFFIC_GEN_MAX_EDGES];
+    uint8_t edge_count;
+    traffic_gen_vehicle_t last;                     /**< Último veículo expandido */
+    uint32_t vehicles;                              /**< Veículos gerados */
+    uint32_t dropped;                               /**< Veículos sem espaço para as bordas */
+};
+
+/**
+ * @brief Geometria das classes: distância de cada eixo ao primeiro (mm)
+ */
+typedef struct {
+    vehicle_type_t type;
+    uint8_t axles;
+    uint16_t offset_mm[TRAFFIC_GEN_MAX_AXLES];
+} traffic_gen_shape_t;
+
+static const traffic_gen_shape_t traffic_gen_shapes[] = {
+    { VEHICLE_TYPE_LIGHT, 2, { 0, 2700 } },
+    { VEHICLE_TYPE_HEAVY, 3, { 0, 4000, 5300 } },
+    { VEHICLE_TYPE_HEAVY, 5, { 0, 3500, 4800, 10800, 12100 } },
+};
+
+static inline uint32_t traffic_gen_rand(struct traffic_gen *gen)
+{
+    uint32_t x = gen->rng;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    gen->rng = x;
+    return x;
+}
+
+/**
+ * @brief Inteiro uniforme em [0, n)
+ */
+static inline uint32_t traffic_gen_uniform(struct traffic_gen *gen, uint32_t n)
+{
+    return (uint32_t)(((uint64_t)traffic_gen_rand(gen) * n) >> 32);
+}
+
+/**
+ * @brief -ln(u / 2^32) em Q16.16 (u > 0), por log2 com tabela
+ */
+static inline uint32_t traffic_gen_neg_ln_q16(uint32_t u)
+{
+    /* log2(1 + i/16) em Q16 */
+    static const uint32_t log2_table[17] = {
+        0, 5732, 11136, 16248, 21098, 25711, 30109, 34312, 38336,
+        42196, 45904, 49472, 52911, 56229, 59434, 62534, 65536,
+    };
+    int msb = 31 - __builtin_clz(u);
+    /* Mantissa em [1, 2) como Q16 */
+    uint32_t m = (uint32_t)(((uint64_t)u << 16) >> msb);
+    uint32_t idx = (m - 65536U) >> 12;
+    uint32_t frac = (m - 65536U) & 0xFFFU;
+    uint32_t log2_m = log2_table[idx] +
+                      (((log2_table[idx + 1] - log2_table[idx]) * frac) >> 12);
+    uint32_t log2_u = ((uint32_t)msb << 16) + log2_m;
+
+    /* -ln(u / 2^32) = (32 - log2(u)) * ln 2 */
+    return (uint32_t)((((uint64_t)32U << 16) - log2_u) * 45426U >> 16);
+}
+
+/**
+ * @brief Intervalo exponencial com média mean_us
+ */
+static inline uint64_t traffic_gen_exponential(struct traffic_gen *gen, uint64_t mean_us)
+{
+    uint32_t u = traffic_gen_rand(gen);   /* xorshift32 nunca retorna 0 */
+
+    return (mean_us * traffic_gen_neg_ln_q16(u)) >> 16;
+}
+
+/**
+ * @brief Velocidade aproximadamente normal (0,01 km/h), limitada a 10-200 km/h
+ */
+static inline uint32_t traffic_gen_speed(struct traffic_gen *gen)
+{
+    int32_t sum = 0;
+
+    for (int i = 0; i < 4; i++) {
+        sum += (int32_t)traffic_gen_uniform(gen, 1000);
+    }
+
+    /* Soma de 4 uniformes: média 2000, desvio 577 (x1000) */
+    int32_t z_milli = (sum - 2000) * 1732 / 1000;
+    int32_t speed = (int32_t)gen->cfg.speed_mean_kmh * 100 +
+                    (int32_t)gen->cfg.speed_sd_kmh * z_milli / 10;
+
+    return (uint32_t)CLAMP(speed, 1000, 20000);
+}
+
+/**
+ * @brief Tempo (us) para percorrer distance_mm a speed_centi_kmh
+ */
+static inline uint64_t traffic_gen_travel_us(uint32_t distance_mm, uint32_t speed_centi_kmh)
+{
+    return (uint64_t)distance_mm * 360000U / speed_centi_kmh;
+}
+
+/**
+ * @brief Próxima chegada de uma faixa a partir de now_us
+ */
+static inline uint64_t traffic_gen_next_arrival(struct traffic_gen *gen, uint8_t lane_id,
+                                                uint64_t now_us)
+{
+    struct traffic_gen_lane *lane = &gen->lanes[lane_id];
+    uint32_t rate = gen->cfg.rate_vph[lane_id];
+
+    if (rate == 0) {
+        return UINT64_MAX;
+    }
+
+    uint64_t mean_us = 3600ULL * 1000000ULL / rate;
+
+    if (gen->cfg.arrivals != TRAFFIC_GEN_BURSTY) {
+        return now_us + traffic_gen_exponential(gen, mean_us);
+    }
+
+    /* Poisson modulado: sem memória, então redesenha ao trocar de regime */
+    while (1) {
+        uint64_t regime_mean = lane->burst_high ? mean_us / 2 : mean_us * 2;
+        uint64_t t = now_us + traffic_gen_exponential(gen, regime_mean);
+
+        if (t < lane->regime_end_us) {
+            return t;
+        }
+
+        now_us = lane->regime_end_us;
+        lane->burst_high = !lane->burst_high;
+        lane->regime_end_us = now_us + traffic_gen_exponential(
+            gen, lane->burst_high ? TRAFFIC_GEN_BURST_HIGH_US : TRAFFIC_GEN_BURST_LOW_US);
+    }
+}
+
+/**
+ * @brief Inicializa o gerador (mesma semente, mesma sequência)
+ */
+static inline void traffic_gen_init(struct traffic_gen *gen,
+                                    const struct traffic_gen_config *cfg, uint32_t seed)
+{
+    memset(gen, 0, sizeof(*gen));
+    gen->cfg = *cfg;
+    gen->cfg.lanes = MIN(cfg->lanes, (uint8_t)TRAFFIC_GEN_MAX_LANES);
+    gen->rng = (seed != 0) ? seed : 0x2545F491U;
+
+    for (uint8_t l = 0; l < gen->cfg.lanes; l++) {
+        gen->lanes[l].regime_end_us = traffic_gen_exponential(gen, TRAFFIC_GEN_BURST_LOW_US);
+        gen->lanes[l].next_arrival_us = traffic_gen_next_arrival(gen, l, 0);
+    }
+    for (uint8_t l = gen->cfg.lanes; l < TRAFFIC_GEN_MAX_LANES; l++) {
+        gen->lanes[l].next_arrival_us = UINT64_MAX;
+    }
+}
+
+/**
+ * @brief Expande o próximo veículo da faixa em bordas e agenda o seguinte
+ */
+static inline void traffic_gen_spawn(struct traffic_gen *gen, uint8_t lane_id)
+{
+    struct traffic_gen_lane *lane = &gen->lanes[lane_id];
+    uint64_t arrival = lane->next_arrival_us;
+    const traffic_gen_shape_t *shape;
+    uint32_t speed;
+
+    if (traffic_gen_uniform(gen, 100) < gen->cfg.heavy_percent) {
+        shape = &traffic_gen_shapes[1 + traffic_gen_uniform(gen, 2)];
+    } else {
+        shape = &traffic_gen_shapes[0];
+    }
+
+    if (lane->platoon_left > 0) {
+        /* Seguidor: até 3 km/h mais lento que o líder */
+        speed = MAX(lane->platoon_speed - traffic_gen_uniform(gen, 300), 1000U);
+        lane->platoon_left--;
+    } else {
+        speed = traffic_gen_speed(gen);
+        if (traffic_gen_uniform(gen, 100) < gen->cfg.platoon_percent) {
+            lane->platoon_left = (uint8_t)(1 + traffic_gen_uniform(gen, 3));
+            lane->platoon_speed = speed;
+        }
+    }
+
+    if (gen->edge_count + 2 * shape->axles <= TRAFFIC_GEN_MAX_EDGES) {
+        for (uint8_t a = 0; a < shape->axles; a++) {
+            uint64_t s1 = arrival + traffic_gen_travel_us(shape->offset_mm[a], speed);
+            uint64_t s2 = s1 + traffic_gen_travel_us(gen->cfg.sensor_distance_mm, speed);
+
+            gen->edges[gen->edge_count++] = (traffic_gen_edge_t){ s1, lane_id, 1 };
+            gen->edges[gen->edge_count++] = (traffic_gen_edge_t){ s2, lane_id, 2 };
+        }
+
+        gen->last = (traffic_gen_vehicle_t){
+            .arrival_us = arrival,
+            .speed_centi_kmh = speed,
+            .vehicle_type = shape->type,
+            .axle_count = shape->axles,
+            .lane_id = lane_id,
+        };
+        gen->vehicles++;
+    } else {
+        gen->dropped++;
+    }
+
+    /* Próximo veículo nunca antes do último eixo deste liberar o sensor 1 */
+    uint64_t clear = arrival + traffic_gen_travel_us(shape->offset_mm[shape->axles - 1], speed);
+
+    if (lane->platoon_left > 0) {
+        uint64_t gap = TRAFFIC_GEN_PLATOON_MIN_GAP_US +
+                       traffic_gen_uniform(gen, TRAFFIC_GEN_PLATOON_MAX_GAP_US -
+                                                TRAFFIC_GEN_PLATOON_MIN_GAP_US);
+        lane->next_arrival_us = arrival + gap;
+    } else {
+        lane->next_arrival_us = traffic_gen_next_arrival(gen, lane_id, arrival);
+    }
+    lane->next_arrival_us = MAX(lane->next_arrival_us, clear + 1);
+}
+
+/**
+ * @brief Retira a próxima borda (em ordem de tempo, todas as faixas)
+ *
+ * @return false se nenhuma faixa tem tráfego
+ */
+static inline bool traffic_gen_next_edge(struct traffic_gen *gen, traffic_gen_edge_t *out)
+{
+    while (1) {
+        int earliest_lane = -1;
+        int earliest_edge = -1;
+
+        for (uint8_t l = 0; l < gen->cfg.lanes; l++) {
+            if (gen->lanes[l].next_arrival_us != UINT64_MAX &&
+                (earliest_lane < 0 ||
+                 gen->lanes[l].next_arrival_us < gen->lanes[earliest_lane].next_arrival_us)) {
+                earliest_lane = l;
+            }
+        }
+        for (int e = 0; e < gen->edge_count; e++) {
+            if (earliest_edge < 0 || gen->edges[e].time_us < gen->edges[earliest_edge].time_us) {
+                earliest_edge = e;
+            }
+        }
+
+        /* Um veículo que chega antes da próxima borda pode gerar bordas anteriores */
+        if (earliest_lane >= 0 &&
+            (earliest_edge < 0 ||
+             gen->lanes[earliest_lane].next_arrival_us <= gen->edges[earliest_edge].time_us)) {
+            traffic_gen_spawn(gen, (uint8_t)earliest_lane);
+            continue;
+        }
+
+        if (earliest_edge < 0) {
+            return false;
+        }
+
+        *out = gen->edges[earliest_edge];
+        gen->edges[earliest_edge] = gen->edges[--gen->edge_count];
+        return true;
+    }
+}
+
+#endif /* RADAR_TRAFFIC_GEN_H */
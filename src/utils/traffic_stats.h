@@ -0,0 +1,300 @@
+/**
+ * @file traffic_stats.h
+ * @brief Estatísticas de tráfego agregadas em fluxo
+ *
+ * Para cada faixa, mantém buckets por minuto (última hora), por hora
+ * (último dia) e por dia (última semana) com volume, mistura de
+ * classes, infrações, histograma de velocidades e headway (intervalo
+ * entre veículos consecutivos da faixa).
+ *
+ * Cada veículo atualiza os três buckets correntes da sua faixa em
+ * O(1), sem alocação. Os buckets ficam em anéis de tamanho fixo e
+ * guardam o número do período que representam: um bucket de período
+ * antigo é zerado quando reutilizado, então não há varredura ao
+ * avançar o tempo. Consultas copiam um único bucket (O(1)).
+ */
+
+#ifndef RADAR_TRAFFIC_STATS_H
+#define RADAR_TRAFFIC_STATS_H
+
+#include <zephyr/kernel.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include "../types.h"
+
+#ifdef CONFIG_RADAR_TRAFFIC_MAX_LANES
+#define TRAFFIC_MAX_LANES CONFIG_RADAR_TRAFFIC_MAX_LANES
+#else
+#define TRAFFIC_MAX_LANES 2
+#endif
+
+/** Histograma de velocidade: faixas de 10 km/h, a última é >= 150 km/h */
+#define TRAFFIC_SPEED_BIN_KMH 10
+#define TRAFFIC_SPEED_BINS 16
+
+/** Buckets retidos por resolução */
+#define TRAFFIC_MINUTE_BUCKETS 60
+#define TRAFFIC_HOUR_BUCKETS 24
+#define TRAFFIC_DAY_BUCKETS 7
+
+/** Período ainda não usado */
+#define TRAFFIC_PERIOD_NONE UINT32_MAX
+
+/**
+ * @brief Resolução de um bucket
+ */
+typedef enum {
+    TRAFFIC_RES_MINUTE = 0,
+    TRAFFIC_RES_HOUR = 1,
+    TRAFFIC_RES_DAY = 2,
+    TRAFFIC_RES_COUNT
+} traffic_resolution_t;
+
+/**
+ * @brief Agregado de um período em uma faixa
+ */
+typedef struct {
+    uint32_t period;                         /**< Minuto/hora/dia desde o boot */
+    uint32_t vehicles;                       /**< Veículos no período */
+    uint32_t by_class[VEHICLE_TYPE_COUNT];   /**< Veículos por tipo */
+    uint32_t violations;                     /**< Infrações */
+    uint32_t speed_hist[TRAFFIC_SPEED_BINS]; /**< Veículos por faixa de velocidade */
+    uint32_t speed_max_centi_kmh;            /**< Maior velocidade */
+    uint64_t speed_sum_centi_kmh;            /**< Soma das velocidades (média) */
+    uint32_t headways;                       /**< Intervalos medidos */
+    uint32_t headway_min_ms;                 /**< Menor intervalo */
+    uint64_t headway_sum_ms;                 /**< Soma dos intervalos (média) */
+} traffic_bucket_t;
+
+/**
+ * @brief Anéis de buckets de uma faixa
+ */
+struct traffic_lane_stats {
+    traffic_bucket_t minutes[TRAFFIC_MINUTE_BUCKETS];
+    traffic_bucket_t hours[TRAFFIC_HOUR_BUCKETS];
+    traffic_bucket_t days[TRAFFIC_DAY_BUCKETS];
+    int64_t last_vehicle_ms;                 /**< Último veículo (headway), < 0 = nenhum */
+};
+
+struct traffic_stats {
+    struct k_spinlock lock;                  /**< Protege atualização e cópia */
+    struct traffic_lane_stats lanes[TRAFFIC_MAX_LANES];
+};
+
+static inline void traffic_bucket_reset(traffic_bucket_t *bucket, uint32_t period)
+{
+    memset(bucket, 0, sizeof(*bucket));
+    bucket->period = period;
+    bucket->headway_min_ms = UINT32_MAX;
+}
+
+/**
+ * @brief Bucket do anel para um período (sem validar o período)
+ */
+static inline traffic_bucket_t *traffic_ring_slot(struct traffic_lane_stats *lane,
+                                                  traffic_resolution_t res, uint32_t period)
+{
+    switch (res) {
+    case TRAFFIC_RES_MINUTE:
+        return &lane->minutes[period % TRAFFIC_MINUTE_BUCKETS];
+    case TRAFFIC_RES_HOUR:
+        return &lane->hours[period % TRAFFIC_HOUR_BUCKETS];
+    default:
+        return &lane->days[period % TRAFFIC_DAY_BUCKETS];
+    }
+}
+
+/**
+ * @brief Buckets retidos de uma resolução
+ */
+static inline uint32_t traffic_ring_size(traffic_resolution_t res)
+{
+    static const uint32_t sizes[TRAFFIC_RES_COUNT] = {
+        TRAFFIC_MINUTE_BUCKETS, TRAFFIC_HOUR_BUCKETS, TRAFFIC_DAY_BUCKETS,
+    };
+
+    return sizes[res];
+}
+
+/**
+ * @brief Duração de cada resolução (ms)
+ */
+static inline uint32_t traffic_period_ms(traffic_resolution_t res)
+{
+    switch (res) {
+    case TRAFFIC_RES_MINUTE:
+        return 60U * 1000U;
+    case TRAFFIC_RES_HOUR:
+        return 60U * 60U * 1000U;
+    default:
+        return 24U * 60U * 60U * 1000U;
+    }
+}
+
+/**
+ * @brief Faixa do histograma para uma velocidade
+ */
+static inline uint32_t traffic_speed_bin(uint32_t speed_centi_kmh)
+{
+    uint32_t bin = speed_centi_kmh / (TRAFFIC_SPEED_BIN_KMH * 100U);
+
+    return MIN(bin, (uint32_t)(TRAFFIC_SPEED_BINS - 1));
+}
+
+/**
+ * @brief Inicializa as estatísticas vazias
+ */
+static inline void traffic_stats_init(struct traffic_stats *stats)
+{
+    for (int l = 0; l < TRAFFIC_MAX_LANES; l++) {
+        struct traffic_lane_stats *lane = &stats->lanes[l];
+
+        for (int r = 0; r < TRAFFIC_RES_COUNT; r++) {
+            for (uint32_t i = 0; i < traffic_ring_size(r); i++) {
+                traffic_bucket_reset(traffic_ring_slot(lane, r, i), TRAFFIC_PERIOD_NONE);
+            }
+        }
+        lane->last_vehicle_ms = -1;
+    }
+}
+
+/**
+ * @brief Contabiliza um veículo (O(1))
+ *
+ * @param now_ms k_uptime_get() da detecção (não decrescente por faixa)
+ * @return -EINVAL se a faixa está fora de TRAFFIC_MAX_LANES
+ */
+static inline int traffic_stats_record(struct traffic_stats *stats, uint8_t lane_id,
+                                       int64_t now_ms, vehicle_type_t vehicle_type,
+                                       uint32_t speed_centi_kmh, bool violation)
+{
+    if (lane_id >= TRAFFIC_MAX_LANES) {
+        return -EINVAL;
+    }
+
+    struct traffic_lane_stats *lane = &stats->lanes[lane_id];
+    k_spinlock_key_t key = k_spin_lock(&stats->lock);
+
+    int64_t headway = (lane->last_vehicle_ms >= 0) ? now_ms - lane->last_vehicle_ms : -1;
+
+    lane->last_vehicle_ms = now_ms;
+
+    for (int r = 0; r < TRAFFIC_RES_COUNT; r++) {
+        uint32_t period = (uint32_t)(now_ms / traffic_period_ms(r));
+        traffic_bucket_t *bucket = traffic_ring_slot(lane, r, period);
+
+        if (bucket->period != period) {
+            traffic_bucket_reset(bucket, period);
+        }
+
+        bucket->vehicles++;
+        if (vehicle_type < VEHICLE_TYPE_COUNT) {
+            bucket->by_class[vehicle_type]++;
+        }
+        if (violation) {
+            bucket->violations++;
+        }
+        bucket->speed_hist[traffic_speed_bin(speed_centi_kmh)]++;
+        bucket->speed_sum_centi_kmh += speed_centi_kmh;
+        bucket->speed_max_centi_kmh = MAX(bucket->speed_max_centi_kmh, speed_centi_kmh);
+
+        if (headway >= 0) {
+            uint32_t headway_ms = (uint32_t)MIN(headway, (int64_t)UINT32_MAX);
+
+            bucket->headways++;
+            bucket->headway_sum_ms += headway_ms;
+            bucket->headway_min_ms = MIN(bucket->headway_min_ms, headway_ms);
+        }
+    }
+
+    k_spin_unlock(&stats->lock, key);
+    return 0;
+}
+
+/**
+ * @brief Copia o bucket de um período (O(1))
+ *
+ * @param periods_ago 0 = período corrente, 1 = anterior, ...
+ * @param out Bucket copiado; zerado (com o período pedido) se não houve
+ *        veículos no período
+ * @return 0, -EINVAL para faixa inválida ou -ENOENT se o período já
+ *         saiu do anel (mais antigo que a retenção da resolução)
+ */
+static inline int traffic_stats_get(struct traffic_stats *stats, uint8_t lane_id,
+                                    traffic_resolution_t res, int64_t now_ms,
+                                    uint32_t periods_ago, traffic_bucket_t *out)
+{
+    if (lane_id >= TRAFFIC_MAX_LANES || res >= TRAFFIC_RES_COUNT) {
+        return -EINVAL;
+    }
+
+    uint32_t current = (uint32_t)(now_ms / traffic_period_ms(res));
+
+    if (periods_ago >= traffic_ring_size(res) || periods_ago > current) {
+        return -ENOENT;
+    }
+
+    uint32_t period = current - periods_ago;
+    k_spinlock_key_t key = k_spin_lock(&stats->lock);
+    const traffic_bucket_t *bucket = traffic_ring_slot(&stats->lanes[lane_id], res, period);
+
+    if (bucket->period == period) {
+        *out = *bucket;
+    } else {
+        traffic_bucket_reset(out, period);
+    }
+
+    k_spin_unlock(&stats->lock, key);
+    return 0;
+}
+
+/**
+ * @brief Velocidade média do bucket (0,01 km/h)
+ */
+static inline uint32_t traffic_bucket_mean_speed(const traffic_bucket_t *bucket)
+{
+    return (bucket->vehicles != 0)
+        ? (uint32_t)(bucket->speed_sum_centi_kmh / bucket->vehicles)
+        : 0;
+}
+
+/**
+ * @brief Headway médio do bucket (ms)
+ */
+static inline uint32_t traffic_bucket_mean_headway(const traffic_bucket_t *bucket)
+{
+    return (bucket->headways != 0)
+        ? (uint32_t)(bucket->headway_sum_ms / bucket->headways)
+        : 0;
+}
+
+/**
+ * @brief Percentil de velocidade pelo histograma
+ *
+ * @param percent 1 a 100
+ * @return Limite superior (km/h) da faixa que contém o percentil, ou 0
+ *         sem veículos
+ */
+static inline uint32_t traffic_bucket_speed_percentile(const traffic_bucket_t *bucket,
+                                                       uint32_t percent)
+{
+    uint32_t target = (bucket->vehicles * percent + 99U) / 100U;
+    uint32_t seen = 0;
+
+    if (bucket->vehicles == 0) {
+        return 0;
+    }
+
+    for (uint32_t bin = 0; bin < TRAFFIC_SPEED_BINS; bin++) {
+        seen += bucket->speed_hist[bin];
+        if (seen >= target) {
+            return (bin + 1) * TRAFFIC_SPEED_BIN_KMH;
+        }
+    }
+
+    return TRAFFIC_SPEED_BINS * TRAFFIC_SPEED_BIN_KMH;
+}
+
+#endif /* RADAR_TRAFFIC_STATS_H */
@@ -0,0 +1,126 @@
+/**
+ * @file vehicle_pool.h
+ * @brief Registros de veículo com contagem de referências
+ *
+ * Cada veículo é alocado uma vez, de um k_mem_slab, quando a detecção
+ * termina; os estágios trocam apenas o ponteiro. Quem envia o ponteiro
+ * a outro estágio entrega uma referência (vehicle_record_ref antes do
+ * envio, vehicle_record_unref se o envio falhar); quem recebe solta a
+ * sua ao terminar. A última referência devolve o bloco ao slab.
+ *
+ * Todas as funções podem ser chamadas de qualquer thread.
+ */
+
+#ifndef RADAR_VEHICLE_POOL_H
+#define RADAR_VEHICLE_POOL_H
+
+#include <zephyr/kernel.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "../types.h"
+
+#ifdef CONFIG_RADAR_VEHICLE_POOL_SIZE
+#define VEHICLE_POOL_SIZE CONFIG_RADAR_VEHICLE_POOL_SIZE
+#else
+#define VEHICLE_POOL_SIZE 32
+#endif
+
+/**
+ * @brief Aloca um registro zerado com uma referência (sem espera)
+ *
+ * @return NULL se o pool está esgotado
+ */
+static inline vehicle_record_t *vehicle_record_alloc(struct k_mem_slab *slab)
+{
+    void *mem;
+
+    if (k_mem_slab_alloc(slab, &mem, K_NO_WAIT) != 0) {
+        return NULL;
+    }
+
+    vehicle_record_t *vehicle = mem;
+
+    memset(vehicle, 0, sizeof(*vehicle));
+    vehicle->slab = slab;
+    atomic_set(&vehicle->refs, 1);
+    return vehicle;
+}
+
+/**
+ * @brief Adiciona uma referência (para entregar o ponteiro a outro estágio)
+ */
+static inline vehicle_record_t *vehicle_record_ref(vehicle_record_t *vehicle)
+{
+    atomic_inc(&vehicle->refs);
+    return vehicle;
+}
+
+/**
+ * @brief Solta uma referência; a última devolve o registro ao pool
+ */
+static inline void vehicle_record_unref(vehicle_record_t *vehicle)
+{
+    /* atomic_dec retorna o valor anterior */
+    if (atomic_dec(&vehicle->refs) == 1) {
+        k_mem_slab_free(vehicle->slab, vehicle);
+    }
+}
+
+/**
+ * @brief Grava a placa e a publica (uma única vez por veículo)
+ *
+ * A placa é escrita antes de VEHICLE_FLAG_PLATE: quem vê o flag lê a
+ * placa completa.
+ */
+static inline void vehicle_record_set_plate(vehicle_record_t *vehicle, const char *plate,
+                                            uint32_t now_ms)
+{
+    strncpy(vehicle->plate, plate, sizeof(vehicle->plate) - 1);
+    vehicle->plate[sizeof(vehicle->plate) - 1] = '\0';
+    vehicle->captured_ms = now_ms;
+    atomic_or(&vehicle->flags, VEHICLE_FLAG_PLATE);
+}
+
+static inline bool vehicle_record_has_plate(const vehicle_record_t *vehicle)
+{
+    return (atomic_get(&vehicle->flags) & VEHICLE_FLAG_PLATE) != 0;
+}
+
+/**
+ * @brief Monta o quadro do display a partir do registro
+ */
+static inline void vehicle_record_to_display(const vehicle_record_t *vehicle,
+                                             display_data_msg_t *out)
+{
+    out->seq = vehicle->seq;
+    out->speed_centi_kmh = vehicle->speed_centi_kmh;
+    out->vehicle_type = vehicle->vehicle_type;
+    out->status = vehicle->status;
+    out->speed_limit = vehicle->speed_limit;
+    out->lane_id = vehicle->lane_id;
+    out->isr_cyc = vehicle->isr_cyc;
+    out->compute_cyc = vehicle->compute_cyc;
+
+    if (vehicle_record_has_plate(vehicle)) {
+        memcpy(out->plate, vehicle->plate, sizeof(out->plate));
+    } else {
+        out->plate[0] = '\0';
+    }
+}
+
+/**
+ * @brief Monta o registro do journal (veículo com placa capturada)
+ */
+static inline void vehicle_record_to_violation(const vehicle_record_t *vehicle,
+                                               violation_record_t *out)
+{
+    out->uptime_ms = vehicle->captured_ms;
+    out->speed_centi_kmh = vehicle->speed_centi_kmh;
+    out->speed_limit = (uint16_t)vehicle->speed_limit;
+    out->vehicle_type = (uint8_t)vehicle->vehicle_type;
+    out->lane_id = vehicle->lane_id;
+    memcpy(out->plate, vehicle->plate, sizeof(out->plate));
+}
+
+#endif /* RADAR_VEHICLE_POOL_H */
@@ -0,0 +1,251 @@
+/**
+ * @file violation_journal.h
+ * @brief Journal de infrações em flash (NVS)
+ *
+ * As infrações são agrupadas em lotes de JOURNAL_BATCH_RECORDS
+ * registros (um lote cabe em uma página de programação de 256 bytes)
+ * e cada lote é gravado com uma única escrita NVS. Os lotes ocupam os
+ * IDs JOURNAL_ID_FIRST_BATCH + (seq % JOURNAL_MAX_BATCHES): quando o
+ * journal enche, o lote mais antigo é substituído. O NVS grava em
+ * anel pelos setores, distribuindo o desgaste.
+ *
+ * Um cabeçalho (JOURNAL_ID_HEADER) guarda a próxima sequência e o
+ * número de boots. O lote é gravado antes do cabeçalho que avança a
+ * sequência; um reset entre as duas escritas deixa o cabeçalho para
+ * trás, então a recuperação confere se o lote da sequência do
+ * cabeçalho já existe e avança a partir dele (normalmente uma leitura
+ * a mais), sem varrer o journal.
+ *
+ * Não é thread-safe: use a partir de uma única thread.
+ */
+
+#ifndef RADAR_VIOLATION_JOURNAL_H
+#define RADAR_VIOLATION_JOURNAL_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/fs/nvs.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include "../types.h"
+
+#ifdef CONFIG_RADAR_JOURNAL_MAX_BATCHES
+#define JOURNAL_MAX_BATCHES CONFIG_RADAR_JOURNAL_MAX_BATCHES
+#else
+#define JOURNAL_MAX_BATCHES 32
+#endif
+
+/** Registros por lote (8 + 12 * 20 = 248 bytes) */
+#define JOURNAL_BATCH_RECORDS 12
+
+/** IDs NVS (0 é evitado) */
+#define JOURNAL_ID_HEADER 1
+#define JOURNAL_ID_FIRST_BATCH 2
+
+/** Identifica o formato do journal ("RJ" + versão 1) */
+#define JOURNAL_MAGIC 0x524A0001U
+
+/**
+ * @brief Cabeçalho persistido do journal
+ */
+typedef struct {
+    uint32_t magic;      /**< JOURNAL_MAGIC */
+    uint32_t next_seq;   /**< Sequência do próximo lote */
+    uint32_t boot_count; /**< Boots desde a criação do journal */
+} journal_header_t;
+
+/**
+ * @brief Lote de infrações (gravado só até records[count])
+ */
+typedef struct {
+    uint32_t seq;        /**< Sequência do lote */
+    uint16_t boot;       /**< Boot em que o lote foi gravado */
+    uint8_t count;       /**< Registros válidos */
+    uint8_t reserved;
+    violation_record_t records[JOURNAL_BATCH_RECORDS];
+} journal_batch_t;
+
+BUILD_ASSERT(sizeof(violation_record_t) == 20, "violation_record_t deve ter 20 bytes");
+BUILD_ASSERT(sizeof(journal_batch_t) <= 256, "Lote deve caber em uma página de 256 bytes");
+
+/**
+ * @brief Estado do journal em RAM
+ */
+struct violation_journal {
+    struct nvs_fs *fs;       /**< Sistema NVS já montado */
+    journal_header_t header; /**< Cópia do cabeçalho persistido */
+    journal_batch_t pending; /**< Lote em formação */
+};
+
+/** Bytes gravados para um lote com count registros */
+#define JOURNAL_BATCH_BYTES(count) \
+    (offsetof(journal_batch_t, records) + (size_t)(count) * sizeof(violation_record_t))
+
+static inline int violation_journal_write_header(struct violation_journal *journal)
+{
+    ssize_t rc = nvs_write(journal->fs, JOURNAL_ID_HEADER, &journal->header,
+                           sizeof(journal->header));
+
+    return (rc < 0) ? (int)rc : 0;
+}
+
+/**
+ * @brief Avança next_seq sobre lotes gravados depois do último cabeçalho
+ *
+ * O lote da sequência s vive em FIRST_BATCH + s % MAX_BATCHES; se ele
+ * já tem seq == next_seq, a gravação do cabeçalho foi interrompida.
+ * Sem isso o próximo flush sobrescreveria o lote recém-salvo.
+ *
+ * @return Lotes recuperados
+ */
+static inline uint32_t violation_journal_recover_seq(struct violation_journal *journal)
+{
+    uint32_t recovered = 0;
+    uint32_t seq;
+
+    while (recovered < JOURNAL_MAX_BATCHES) {
+        uint32_t id = JOURNAL_ID_FIRST_BATCH + (journal->header.next_seq % JOURNAL_MAX_BATCHES);
+
+        /* Lê só o seq do início do lote (nvs_read devolve o tamanho do item) */
+        if (nvs_read(journal->fs, id, &seq, sizeof(seq)) < (ssize_t)sizeof(seq) ||
+            seq != journal->header.next_seq) {
+            break;
+        }
+        journal->header.next_seq++;
+        recovered++;
+    }
+
+    return recovered;
+}
+
+/**
+ * @brief Recupera o journal de um NVS montado
+ *
+ * Lê o cabeçalho e confere o lote seguinte (violation_journal_recover_seq).
+ * Um cabeçalho ausente ou de outro formato inicia um journal vazio.
+ * Incrementa o contador de boots.
+ *
+ * @return 0 ou erro negativo do NVS
+ */
+static inline int violation_journal_init(struct violation_journal *journal, struct nvs_fs *fs)
+{
+    journal->fs = fs;
+
+    ssize_t rc = nvs_read(fs, JOURNAL_ID_HEADER, &journal->header, sizeof(journal->header));
+
+    if (rc != sizeof(journal->header) || journal->header.magic != JOURNAL_MAGIC) {
+        journal->header.magic = JOURNAL_MAGIC;
+        journal->header.next_seq = 0;
+        journal->header.boot_count = 0;
+    }
+
+    violation_journal_recover_seq(journal);
+    journal->header.boot_count++;
+    journal->pending.count = 0;
+
+    return violation_journal_write_header(journal);
+}
+
+/**
+ * @brief Lote em formação cheio (gravação pendente ou que falhou)
+ */
+static inline bool violation_journal_full(const struct violation_journal *journal)
+{
+    return journal->pending.count >= JOURNAL_BATCH_RECORDS;
+}
+
+/**
+ * @brief Adiciona uma infração ao lote em formação (só RAM)
+ *
+ * Com o lote cheio o registro não cabe e é descartado: o chamador
+ * confere violation_journal_full() e só adiciona depois de gravar.
+ *
+ * @return true se o lote ficou cheio e deve ser gravado
+ */
+static inline bool violation_journal_add(struct violation_journal *journal,
+                                         const violation_record_t *record)
+{
+    if (journal->pending.count < JOURNAL_BATCH_RECORDS) {
+        journal->pending.records[journal->pending.count++] = *record;
+    }
+
+    return violation_journal_full(journal);
+}
+
+/**
+ * @brief Registros no lote em formação (ainda não gravados)
+ */
+static inline uint32_t violation_journal_pending(const struct violation_journal *journal)
+{
+    return journal->pending.count;
+}
+
+/**
+ * @brief Grava o lote em formação (uma escrita de lote + cabeçalho)
+ *
+ * @return 0 (também sem nada a gravar) ou erro negativo do NVS; em
+ *         erro o lote é mantido para nova tentativa
+ */
+static inline int violation_journal_flush(struct violation_journal *journal)
+{
+    journal_batch_t *batch = &journal->pending;
+
+    if (batch->count == 0) {
+        return 0;
+    }
+
+    batch->seq = journal->header.next_seq;
+    batch->boot = (uint16_t)journal->header.boot_count;
+    batch->reserved = 0;
+
+    ssize_t rc = nvs_write(journal->fs,
+                           JOURNAL_ID_FIRST_BATCH + (batch->seq % JOURNAL_MAX_BATCHES),
+                           batch, JOURNAL_BATCH_BYTES(batch->count));
+    if (rc < 0) {
+        return (int)rc;
+    }
+
+    journal->header.next_seq++;
+    batch->count = 0;
+
+    return violation_journal_write_header(journal);
+}
+
+/**
+ * @brief Lotes gravados disponíveis (no máximo JOURNAL_MAX_BATCHES)
+ */
+static inline uint32_t violation_journal_batches(const struct violation_journal *journal)
+{
+    return MIN(journal->header.next_seq, (uint32_t)JOURNAL_MAX_BATCHES);
+}
+
+/**
+ * @brief Lê um lote gravado
+ *
+ * @param index 0 = lote mais antigo disponível
+ * @return 0, -ENOENT se index está fora do journal ou -EIO se o lote
+ *         gravado não confere
+ */
+static inline int violation_journal_read(const struct violation_journal *journal,
+                                         uint32_t index, journal_batch_t *out)
+{
+    uint32_t available = violation_journal_batches(journal);
+
+    if (index >= available) {
+        return -ENOENT;
+    }
+
+    uint32_t seq = journal->header.next_seq - available + index;
+    ssize_t rc = nvs_read(journal->fs, JOURNAL_ID_FIRST_BATCH + (seq % JOURNAL_MAX_BATCHES),
+                          out, sizeof(*out));
+
+    if (rc < (ssize_t)JOURNAL_BATCH_BYTES(0) || out->seq != seq ||
+        out->count > JOURNAL_BATCH_RECORDS || rc != (ssize_t)JOURNAL_BATCH_BYTES(out->count)) {
+        return -EIO;
+    }
+
+    return 0;
+}
+
+#endif /* RADAR_VIOLATION_JOURNAL_H */
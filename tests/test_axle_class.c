@@ -0,0 +1,181 @@
+/**
+ * @file test_axle_class.c
+ * @brief Testes unitários da classificação por espaçamento entre eixos
+ *
+ * Testa as funções:
+ * - axle_spacings_mm
+ * - classify_axles
+ * - vehicle_class_type
+ * - vehicle_class_name
+ */
+
+#include <zephyr/ztest.h>
+#include "../src/utils/axle_class.h"
+#include "../src/utils/traffic_gen.h"
+
+/**
+ * @brief Intervalos (us) de um veículo com os espaçamentos dados a speed_kmh
+ */
+static void gaps_for(const uint32_t *spacing_mm, uint8_t axle_count, uint32_t speed_kmh,
+                     uint32_t *gap_us)
+{
+    for (uint8_t i = 0; i < axle_count - 1; i++) {
+        gap_us[i] = spacing_mm[i] * 3600U / speed_kmh;
+    }
+}
+
+/**
+ * @brief Tempo entre eixos vira distância com a velocidade medida
+ */
+ZTEST(axle_class_tests, test_spacings_from_speed)
+{
+    /* 2,7 m a 80 km/h = 121,5 ms */
+    uint32_t gap_us[] = { 121500 };
+    uint16_t spacing[VEHICLE_MAX_AXLES - 1];
+
+    zassert_equal(axle_spacings_mm(gap_us, 2, 8000, spacing), 1);
+    zassert_equal(spacing[0], 2700);
+
+    /* Saturação em UINT16_MAX (veículo quase parado) */
+    gap_us[0] = 60000000;
+    axle_spacings_mm(gap_us, 2, 1000, spacing);
+    zassert_equal(spacing[0], UINT16_MAX);
+
+    /* Sem espaçamentos: um eixo ou eixos além do armazenado */
+    zassert_equal(axle_spacings_mm(gap_us, 1, 8000, spacing), 0);
+    zassert_equal(axle_spacings_mm(gap_us, VEHICLE_MAX_AXLES + 1, 8000, spacing), 0);
+}
+
+/**
+ * @brief A mesma geometria dá a mesma classe a qualquer velocidade
+ */
+ZTEST(axle_class_tests, test_speed_normalized)
+{
+    static const uint32_t truck5_mm[] = { 3500, 1300, 6000, 1300 };
+    static const uint32_t speeds[] = { 20, 40, 80, 120 };
+    uint32_t gap_us[4];
+    uint16_t spacing[VEHICLE_MAX_AXLES - 1];
+
+    for (size_t i = 0; i < ARRAY_SIZE(speeds); i++) {
+        gaps_for(truck5_mm, 5, speeds[i], gap_us);
+        axle_spacings_mm(gap_us, 5, speeds[i] * 100, spacing);
+        zassert_equal(classify_axles(spacing, 5), VEHICLE_CLASS_TRUCK_5,
+                      "Classe a %u km/h", speeds[i]);
+    }
+}
+
+/**
+ * @brief Uma geometria típica de cada linha da tabela
+ */
+ZTEST(axle_class_tests, test_class_table)
+{
+    static const uint16_t car[] = { 2600 };
+    static const uint16_t car_trailer[] = { 2700, 3200 };
+    static const uint16_t car_trailer_tandem[] = { 2700, 3200, 1000 };
+    static const uint16_t bus[] = { 6500 };
+    static const uint16_t bus_tag[] = { 6200, 1400 };
+    static const uint16_t truck2[] = { 4800 };
+    static const uint16_t truck3[] = { 4000, 1300 };
+    static const uint16_t truck9[] = { 3600, 1300, 5500, 1300, 1300, 6500, 1300, 1300 };
+
+    zassert_equal(classify_axles(car, 2), VEHICLE_CLASS_CAR);
+    zassert_equal(classify_axles(car_trailer, 3), VEHICLE_CLASS_CAR_TRAILER);
+    zassert_equal(classify_axles(car_trailer_tandem, 4), VEHICLE_CLASS_CAR_TRAILER);
+    zassert_equal(classify_axles(bus, 2), VEHICLE_CLASS_BUS);
+    zassert_equal(classify_axles(bus_tag, 3), VEHICLE_CLASS_BUS);
+    zassert_equal(classify_axles(truck2, 2), VEHICLE_CLASS_TRUCK_2);
+    zassert_equal(classify_axles(truck3, 3), VEHICLE_CLASS_TRUCK_3);
+    zassert_equal(classify_axles(truck9, 9), VEHICLE_CLASS_TRUCK_9);
+}
+
+/**
+ * @brief Automóvel com reboque e caminhão com o mesmo primeiro espaçamento
+ *        se separam pelo segundo (engate x tandem)
+ */
+ZTEST(axle_class_tests, test_car_trailer_truck_boundary)
+{
+    static const uint16_t truck3_short[] = { 3000, 1300 };
+    static const uint16_t truck4_short[] = { 2800, 1300, 1300 };
+    static const uint16_t hitch_min[] = { 3000, 2500 };
+    static const uint16_t below_hitch[] = { 3000, 2499 };
+    static const uint16_t trailer_wide_tandem[] = { 3000, 3500, 1600 };
+    static const uint16_t wheelbase_max[] = { 3400, 3200 };
+    static const uint16_t wheelbase_over[] = { 3401, 3200 };
+
+    zassert_equal(classify_axles(truck3_short, 3), VEHICLE_CLASS_TRUCK_3);
+    zassert_equal(classify_axles(truck4_short, 4), VEHICLE_CLASS_TRUCK_4);
+    zassert_equal(classify_axles(hitch_min, 3), VEHICLE_CLASS_CAR_TRAILER);
+    zassert_equal(classify_axles(below_hitch, 3), VEHICLE_CLASS_TRUCK_3);
+    zassert_equal(classify_axles(trailer_wide_tandem, 4), VEHICLE_CLASS_TRUCK_4,
+                  "Tandem acima de 1500 mm não é de reboque leve");
+    zassert_equal(classify_axles(wheelbase_max, 3), VEHICLE_CLASS_CAR_TRAILER);
+    zassert_equal(classify_axles(wheelbase_over, 3), VEHICLE_CLASS_TRUCK_3);
+}
+
+/**
+ * @brief Fora de todas as janelas: classe desconhecida, tipo por eixos
+ */
+ZTEST(axle_class_tests, test_unknown_falls_back_to_axle_count)
+{
+    static const uint16_t motorcycle[] = { 1400 };
+    static const uint16_t odd[] = { 9000, 9000 };
+    uint16_t ten[VEHICLE_MAX_AXLES - 1] = { 3600, 1300, 1300, 1300, 1300, 1300, 1300,
+                                            1300, 1300 };
+
+    zassert_equal(classify_axles(motorcycle, 2), VEHICLE_CLASS_UNKNOWN);
+    zassert_equal(vehicle_class_type(VEHICLE_CLASS_UNKNOWN, 2), VEHICLE_TYPE_LIGHT);
+    zassert_equal(classify_axles(odd, 3), VEHICLE_CLASS_UNKNOWN);
+    zassert_equal(vehicle_class_type(VEHICLE_CLASS_UNKNOWN, 3), VEHICLE_TYPE_HEAVY);
+    zassert_equal(classify_axles(ten, 10), VEHICLE_CLASS_UNKNOWN, "Tabela vai até 9 eixos");
+    zassert_equal(classify_axles(ten, 1), VEHICLE_CLASS_UNKNOWN);
+}
+
+/**
+ * @brief Limite de cada classe: só automóvel usa o de leves
+ */
+ZTEST(axle_class_tests, test_class_limits)
+{
+    zassert_equal(vehicle_class_type(VEHICLE_CLASS_CAR, 2), VEHICLE_TYPE_LIGHT);
+    zassert_equal(vehicle_class_type(VEHICLE_CLASS_CAR_TRAILER, 3), VEHICLE_TYPE_HEAVY);
+    zassert_equal(vehicle_class_type(VEHICLE_CLASS_BUS, 2), VEHICLE_TYPE_HEAVY,
+                  "Ônibus de 2 eixos usa o limite de pesados");
+    zassert_equal(vehicle_class_type(VEHICLE_CLASS_TRUCK_2, 2), VEHICLE_TYPE_HEAVY);
+    zassert_equal(vehicle_class_type(VEHICLE_CLASS_TRUCK_9, 9), VEHICLE_TYPE_HEAVY);
+}
+
+/**
+ * @brief Geometrias do gerador de tráfego caem nas classes esperadas
+ */
+ZTEST(axle_class_tests, test_traffic_gen_shapes)
+{
+    static const vehicle_class_t expected[] = {
+        VEHICLE_CLASS_CAR, VEHICLE_CLASS_TRUCK_3, VEHICLE_CLASS_TRUCK_5
+    };
+    uint16_t spacing[VEHICLE_MAX_AXLES - 1];
+
+    BUILD_ASSERT(ARRAY_SIZE(expected) == ARRAY_SIZE(traffic_gen_shapes));
+
+    for (size_t s = 0; s < ARRAY_SIZE(traffic_gen_shapes); s++) {
+        const traffic_gen_shape_t *shape = &traffic_gen_shapes[s];
+
+        for (uint8_t i = 0; i < shape->axles - 1; i++) {
+            spacing[i] = shape->offset_mm[i + 1] - shape->offset_mm[i];
+        }
+        zassert_equal(classify_axles(spacing, shape->axles), expected[s], "Forma %zu", s);
+        zassert_equal(vehicle_class_type(expected[s], shape->axles), shape->type);
+    }
+}
+
+/**
+ * @brief Nomes para todas as classes
+ */
+ZTEST(axle_class_tests, test_class_names)
+{
+    for (int i = 0; i < VEHICLE_CLASS_COUNT; i++) {
+        zassert_not_null(vehicle_class_name(i));
+    }
+    zassert_equal(strcmp(vehicle_class_name(VEHICLE_CLASS_BUS), "ONIBUS"), 0);
+    zassert_equal(strcmp(vehicle_class_name(VEHICLE_CLASS_COUNT), "?"), 0);
+}
+
+ZTEST_SUITE(axle_class_tests, NULL, NULL, NULL, NULL, NULL);
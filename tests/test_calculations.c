@@ -4,8 +4,11 @@
  * 
  * Testa as funções:
  * - calculate_speed_kmh
+ * - calculate_speed_centi_kmh
+ * - calculate_speed_centi_kmh_fast
  * - classify_vehicle
  * - determine_speed_status
+ * - determine_speed_status_centi
  * - get_speed_limit
  */
 
@@ -41,6 +44,68 @@ ZTEST(calculations_tests, test_calculate_speed_edge_cases)
     zassert_true(speed > 0, "Velocidade alta deve ser calculada");
 }
 
+/**
+ * @brief Testa cálculo de velocidade em ponto fixo (0,01 km/h)
+ */
+ZTEST(calculations_tests, test_calculate_speed_centi)
+{
+    /* 1000mm em 30000us = 120,00 km/h */
+    uint32_t speed = calculate_speed_centi_kmh(30000, 1000);
+    zassert_equal(speed, 12000, "Velocidade deveria ser 120,00 km/h");
+    
+    /* 1000mm em 30500us = 118,03 km/h (inteiro em ms daria 116 ou 120) */
+    speed = calculate_speed_centi_kmh(30500, 1000);
+    zassert_equal(speed, 11803, "Velocidade deveria ser 118,03 km/h");
+    
+    /* 1000mm em 1s = 3,60 km/h */
+    speed = calculate_speed_centi_kmh(1000000, 1000);
+    zassert_equal(speed, 360, "Velocidade deveria ser 3,60 km/h");
+    
+    /* Distância curta: 250mm em 7500us = 120,00 km/h */
+    speed = calculate_speed_centi_kmh(7500, 250);
+    zassert_equal(speed, 12000, "Velocidade deveria ser 120,00 km/h");
+    
+    /* Divisão por zero */
+    speed = calculate_speed_centi_kmh(0, 1000);
+    zassert_equal(speed, 0, "Divisão por zero deve retornar 0");
+    
+    /* Saturação em vez de overflow */
+    speed = calculate_speed_centi_kmh(1, 100000);
+    zassert_equal(speed, UINT32_MAX, "Velocidade deve saturar");
+}
+
+/**
+ * @brief Testa que a versão sem divisão é idêntica à de referência
+ */
+ZTEST(calculations_tests, test_calculate_speed_centi_fast_bit_exact)
+{
+    static const uint32_t distances[] = { 100, 250, 1000, 2700, 11930 };
+    
+    /* Faixa de tempos de 0 a 200 ms, us a us, na distância padrão */
+    for (uint32_t t = 0; t <= 200000; t++) {
+        zassert_equal(calculate_speed_centi_kmh_fast(t, 1000),
+                      calculate_speed_centi_kmh(t, 1000),
+                      "Divergência em t=%u us", t);
+    }
+    
+    /* Outras distâncias e tempos longos (passo crescente) */
+    for (size_t i = 0; i < ARRAY_SIZE(distances); i++) {
+        for (uint32_t t = 1; t < UINT32_MAX / 2; t += 1 + t / 64) {
+            zassert_equal(calculate_speed_centi_kmh_fast(t, distances[i]),
+                          calculate_speed_centi_kmh(t, distances[i]),
+                          "Divergência em d=%u mm, t=%u us", distances[i], t);
+        }
+        zassert_equal(calculate_speed_centi_kmh_fast(UINT32_MAX, distances[i]),
+                      calculate_speed_centi_kmh(UINT32_MAX, distances[i]),
+                      "Divergência em t máximo");
+    }
+    
+    /* Fora da faixa (numerador >= 2^32): usa a função de referência */
+    zassert_equal(calculate_speed_centi_kmh_fast(1000, 20000),
+                  calculate_speed_centi_kmh(1000, 20000),
+                  "Fallback deve ser idêntico");
+}
+
 /**
  * @brief Testa classificação de veículos
  */
@@ -85,6 +150,24 @@ ZTEST(calculations_tests, test_determine_speed_status)
     zassert_equal(status, SPEED_STATUS_VIOLATION, "80 km/h deve ser infração");
 }
 
+/**
+ * @brief Testa status com velocidade em centésimos de km/h
+ */
+ZTEST(calculations_tests, test_determine_speed_status_centi)
+{
+    uint32_t limit = 60;
+    uint32_t warning_threshold = 90; /* 90% de 60 = 54,00 km/h */
+    
+    zassert_equal(determine_speed_status_centi(5399, limit, warning_threshold),
+                  SPEED_STATUS_NORMAL, "53,99 km/h deve ser normal");
+    zassert_equal(determine_speed_status_centi(5400, limit, warning_threshold),
+                  SPEED_STATUS_WARNING, "54,00 km/h deve ser alerta");
+    zassert_equal(determine_speed_status_centi(5999, limit, warning_threshold),
+                  SPEED_STATUS_WARNING, "59,99 km/h deve ser alerta");
+    zassert_equal(determine_speed_status_centi(6000, limit, warning_threshold),
+                  SPEED_STATUS_VIOLATION, "60,00 km/h deve ser infração");
+}
+
 /**
  * @brief Testa obtenção do limite correto
  */
@@ -0,0 +1,106 @@
+/**
+ * @file test_capture_inflight.c
+ * @brief Testes unitários da fila de capturas em andamento
+ *
+ * Testa as funções:
+ * - capture_inflight_push / capture_inflight_pop (ordem FIFO, fila cheia)
+ * - capture_inflight_drop_last
+ * - evento atrasado depois do prazo (descartado, sem casar com a próxima)
+ */
+
+#include <zephyr/ztest.h>
+#include "../src/utils/capture_inflight.h"
+
+#define TEST_TIMEOUT_MS 2000
+
+static struct capture_inflight q;
+
+static void capture_inflight_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    capture_inflight_init(&q);
+}
+
+/**
+ * @brief Eventos no prazo casam com as requisições em ordem
+ */
+ZTEST(capture_inflight_tests, test_fifo_order)
+{
+    uint32_t expired;
+
+    zassert_equal(capture_inflight_pop(&q, 0, &expired), 0, "Fila vazia");
+    zassert_equal(expired, 0);
+
+    zassert_true(capture_inflight_push(&q, 1, TEST_TIMEOUT_MS));
+    zassert_true(capture_inflight_push(&q, 2, 100 + TEST_TIMEOUT_MS));
+
+    zassert_equal(capture_inflight_pop(&q, 500, &expired), 1);
+    zassert_equal(capture_inflight_pop(&q, 600, &expired), 2);
+    zassert_equal(expired, 0);
+    zassert_equal(q.count, 0);
+}
+
+/**
+ * @brief Fila cheia recusa; drop_last desfaz o último push
+ */
+ZTEST(capture_inflight_tests, test_full_and_drop_last)
+{
+    uint32_t expired;
+
+    for (uint32_t i = 1; i <= CAPTURE_INFLIGHT_MAX; i++) {
+        zassert_true(capture_inflight_push(&q, i, TEST_TIMEOUT_MS));
+    }
+    zassert_false(capture_inflight_push(&q, 99, TEST_TIMEOUT_MS), "Fila cheia");
+
+    capture_inflight_drop_last(&q);
+    zassert_true(capture_inflight_push(&q, 100, TEST_TIMEOUT_MS), "Posição liberada");
+
+    for (uint32_t i = 1; i < CAPTURE_INFLIGHT_MAX; i++) {
+        zassert_equal(capture_inflight_pop(&q, 0, &expired), i);
+    }
+    zassert_equal(capture_inflight_pop(&q, 0, &expired), 100, "Substitui o desfeito");
+}
+
+/**
+ * @brief Evento atrasado de uma requisição vencida não vai para a seguinte
+ *
+ * A requisição 1 vence; o evento dela chega depois, com a 2 ainda no
+ * prazo. Casar com a 2 poria a placa do veículo 1 no veículo 2.
+ */
+ZTEST(capture_inflight_tests, test_late_event_after_expiry)
+{
+    uint32_t expired;
+
+    zassert_true(capture_inflight_push(&q, 1, TEST_TIMEOUT_MS));
+    zassert_true(capture_inflight_push(&q, 2, 1500 + TEST_TIMEOUT_MS));
+
+    /* Evento atrasado do veículo 1 */
+    zassert_equal(capture_inflight_pop(&q, TEST_TIMEOUT_MS + 100, &expired), 0,
+                  "Evento atrasado deve ser descartado");
+    zassert_equal(expired, 1, "Requisição vencida descartada");
+
+    /* O evento do veículo 2 casa com a requisição 2 */
+    zassert_equal(capture_inflight_pop(&q, TEST_TIMEOUT_MS + 200, &expired), 2);
+    zassert_equal(expired, 0);
+}
+
+/**
+ * @brief Várias requisições vencidas são descartadas de uma vez
+ */
+ZTEST(capture_inflight_tests, test_all_expired)
+{
+    uint32_t expired;
+
+    zassert_true(capture_inflight_push(&q, 1, TEST_TIMEOUT_MS));
+    zassert_true(capture_inflight_push(&q, 2, 100 + TEST_TIMEOUT_MS));
+
+    zassert_equal(capture_inflight_pop(&q, 10000, &expired), 0);
+    zassert_equal(expired, 2);
+    zassert_equal(q.count, 0, "Fila esvaziada");
+
+    /* Prazo é inclusivo: evento exatamente no prazo ainda casa */
+    zassert_true(capture_inflight_push(&q, 3, 10000 + TEST_TIMEOUT_MS));
+    zassert_equal(capture_inflight_pop(&q, 10000 + TEST_TIMEOUT_MS, &expired), 3);
+}
+
+ZTEST_SUITE(capture_inflight_tests, NULL, NULL, capture_inflight_before, NULL, NULL);
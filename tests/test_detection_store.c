@@ -0,0 +1,212 @@
+/**
+ * @file test_detection_store.c
+ * @brief Testes unitários do armazenamento colunar de detecções
+ *
+ * Testa as funções:
+ * - detection_store_append
+ * - detection_store_set_plate
+ * - detection_store_get_plate
+ * - detection_store_count_violations
+ * - detection_store_max_speed_by_class
+ */
+
+#include <zephyr/ztest.h>
+#include "../src/utils/detection_store.h"
+#include "../src/utils/plate_validator.h"
+
+static struct detection_store store;
+
+static void detection_store_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    detection_store_init(&store);
+}
+
+/**
+ * @brief Testa consultas no armazenamento vazio
+ */
+ZTEST(detection_store_tests, test_empty_store)
+{
+    uint32_t max_speed[VEHICLE_TYPE_COUNT];
+
+    zassert_equal(detection_store_count_violations(&store, 1000, 60000, -1), 0,
+                  "Sem detecções, sem infrações");
+    zassert_equal(detection_store_max_speed_by_class(&store, max_speed), 0,
+                  "Nada deve ser varrido");
+    zassert_equal(max_speed[VEHICLE_TYPE_LIGHT], 0, "Máximo deve ser 0");
+    zassert_equal(max_speed[VEHICLE_TYPE_HEAVY], 0, "Máximo deve ser 0");
+}
+
+/**
+ * @brief Testa contagem de infrações por janela de tempo e faixa
+ */
+ZTEST(detection_store_tests, test_count_violations_window)
+{
+    /* t=1000: infração faixa 0 (antiga) */
+    detection_store_append(&store, 1000, 7000, 60, VEHICLE_TYPE_LIGHT, 0);
+    /* t=50000: normal */
+    detection_store_append(&store, 50000, 5000, 60, VEHICLE_TYPE_LIGHT, 0);
+    /* t=60000: infração exatamente no limite, faixa 1 */
+    detection_store_append(&store, 60000, 4000, 40, VEHICLE_TYPE_HEAVY, 1);
+    /* t=65000: infração faixa 0 */
+    detection_store_append(&store, 65000, 6500, 60, VEHICLE_TYPE_LIGHT, 0);
+
+    zassert_equal(detection_store_count_violations(&store, 70000, 60000, -1), 2,
+                  "Duas infrações no último minuto");
+    zassert_equal(detection_store_count_violations(&store, 70000, 60000, 0), 1,
+                  "Uma infração na faixa 0");
+    zassert_equal(detection_store_count_violations(&store, 70000, 60000, 1), 1,
+                  "Uma infração na faixa 1");
+    zassert_equal(detection_store_count_violations(&store, 70000, 70000, -1), 3,
+                  "Janela maior inclui a infração antiga");
+}
+
+/**
+ * @brief Testa a janela quando o uptime de 32 bits dá a volta
+ */
+ZTEST(detection_store_tests, test_count_violations_uptime_wrap)
+{
+    detection_store_append(&store, UINT32_MAX - 500, 9000, 60, VEHICLE_TYPE_LIGHT, 0);
+    detection_store_append(&store, 200, 9000, 60, VEHICLE_TYPE_LIGHT, 0);
+
+    zassert_equal(detection_store_count_violations(&store, 1000, 5000, -1), 2,
+                  "Idade deve ser calculada módulo 2^32");
+}
+
+/**
+ * @brief Testa velocidade máxima por classe
+ */
+ZTEST(detection_store_tests, test_max_speed_by_class)
+{
+    uint32_t max_speed[VEHICLE_TYPE_COUNT];
+
+    detection_store_append(&store, 10, 5500, 60, VEHICLE_TYPE_LIGHT, 0);
+    detection_store_append(&store, 20, 8123, 60, VEHICLE_TYPE_LIGHT, 1);
+    detection_store_append(&store, 30, 3900, 40, VEHICLE_TYPE_HEAVY, 0);
+    detection_store_append(&store, 40, 7000, 60, VEHICLE_TYPE_LIGHT, 0);
+
+    zassert_equal(detection_store_max_speed_by_class(&store, max_speed), 4,
+                  "Quatro registros varridos");
+    zassert_equal(max_speed[VEHICLE_TYPE_LIGHT], 8123, "Máximo leve incorreto");
+    zassert_equal(max_speed[VEHICLE_TYPE_HEAVY], 3900, "Máximo pesado incorreto");
+}
+
+/**
+ * @brief Testa sobrescrita das detecções mais antigas
+ */
+ZTEST(detection_store_tests, test_overwrite_oldest)
+{
+    uint32_t max_speed[VEHICLE_TYPE_COUNT];
+
+    /* Uma detecção rápida que será sobrescrita */
+    detection_store_append(&store, 0, 15000, 60, VEHICLE_TYPE_LIGHT, 0);
+
+    for (uint32_t i = 1; i <= DETECTION_STORE_CAPACITY; i++) {
+        detection_store_append(&store, i, 5000, 60, VEHICLE_TYPE_LIGHT, 0);
+    }
+
+    zassert_equal(detection_store_max_speed_by_class(&store, max_speed),
+                  DETECTION_STORE_CAPACITY, "Varredura limitada à capacidade");
+    zassert_equal(max_speed[VEHICLE_TYPE_LIGHT], 5000,
+                  "Detecção sobrescrita não deve aparecer");
+}
+
+/**
+ * @brief Testa saturação das colunas compactas
+ */
+ZTEST(detection_store_tests, test_speed_saturates)
+{
+    uint32_t max_speed[VEHICLE_TYPE_COUNT];
+
+    detection_store_append(&store, 0, 100000, 60, VEHICLE_TYPE_HEAVY, 0);
+    detection_store_max_speed_by_class(&store, max_speed);
+
+    zassert_equal(max_speed[VEHICLE_TYPE_HEAVY], UINT16_MAX,
+                  "Velocidade deve saturar em 655,35 km/h");
+    zassert_equal(detection_store_count_violations(&store, 0, 1000, -1), 1,
+                  "Velocidade saturada continua infração");
+}
+
+/**
+ * @brief Testa o preenchimento da placa de um registro
+ */
+ZTEST(detection_store_tests, test_set_plate)
+{
+    char plate[PLATE_MAX_LEN + 1];
+    uint32_t seq = detection_store_append(&store, 0, 9000, 60, VEHICLE_TYPE_LIGHT, 0);
+    uint32_t slot = seq & (DETECTION_STORE_CAPACITY - 1);
+
+    zassert_equal(store.plate_key[slot], 0, "Registro novo sem placa");
+    zassert_true(detection_store_set_plate(&store, seq, plate_pack_key("ABC1D23")),
+                 "Registro ainda existe");
+
+    uint64_t key;
+
+    zassert_true(detection_store_get_plate(&store, seq, &key), "Registro ainda existe");
+    plate_unpack_key(key, plate);
+    zassert_str_equal(plate, "ABC1D23", "Placa deve ser reconstruída");
+    zassert_equal(DETECTION_STORE_SEQ(&store, slot), seq, "Sequência republicada");
+
+    /* Depois de sobrescrito, o registro não aceita mais a placa */
+    for (uint32_t i = 0; i < DETECTION_STORE_CAPACITY; i++) {
+        detection_store_append(&store, i, 5000, 60, VEHICLE_TYPE_LIGHT, 0);
+    }
+    zassert_false(detection_store_set_plate(&store, seq, plate_pack_key("XYZ9876")),
+                  "Registro sobrescrito deve recusar a placa");
+    zassert_equal(store.plate_key[slot], 0, "Placa do novo registro intacta");
+    zassert_false(detection_store_get_plate(&store, seq, &key),
+                  "Registro sobrescrito não devolve placa");
+}
+
+/**
+ * @brief Leitura durante a escrita da placa (geração ímpar) falha
+ */
+ZTEST(detection_store_tests, test_get_plate_during_write)
+{
+    uint32_t seq = detection_store_append(&store, 0, 9000, 60, VEHICLE_TYPE_LIGHT, 0);
+    uint32_t slot = seq & (DETECTION_STORE_CAPACITY - 1);
+    uint64_t key;
+
+    zassert_equal(atomic_get(&store.gen[slot]) & 1, 0, "Geração par após o append");
+
+    /* Estado intermediário de detection_store_set_plate(): sequência intacta */
+    atomic_inc(&store.gen[slot]);
+    zassert_false(detection_store_get_plate(&store, seq, &key), "Escrita em andamento");
+
+    atomic_inc(&store.gen[slot]);
+    zassert_true(detection_store_get_plate(&store, seq, &key));
+    zassert_equal(key, 0);
+}
+
+/**
+ * @brief Placa trocada entre as duas conferências do leitor é detectada
+ *
+ * A sequência do registro é a mesma antes e depois; só a geração acusa
+ * que a placa lida pode estar cortada ao meio.
+ */
+ZTEST(detection_store_tests, test_plate_changed_during_read)
+{
+    uint32_t seq = detection_store_append(&store, 0, 9000, 60, VEHICLE_TYPE_LIGHT, 0);
+    uint32_t slot = seq & (DETECTION_STORE_CAPACITY - 1);
+    atomic_val_t gen;
+
+    zassert_true(detection_store_set_plate(&store, seq, plate_pack_key("ABC1D23")));
+    zassert_true(detection_store_read_begin(&store, seq, &gen));
+
+    uint64_t key = store.plate_key[slot];
+
+    zassert_false(detection_store_read_retry(&store, seq, gen), "Nada mudou ainda");
+
+    zassert_true(detection_store_read_begin(&store, seq, &gen));
+    key = store.plate_key[slot];
+    zassert_true(detection_store_set_plate(&store, seq, plate_pack_key("XYZ9A87")));
+    zassert_equal(DETECTION_STORE_SEQ(&store, slot), seq, "Sequência não muda");
+    zassert_true(detection_store_read_retry(&store, seq, gen),
+                 "Placa reescrita durante a leitura deve ser descartada");
+    zassert_equal(key, plate_pack_key("ABC1D23"));
+
+    zassert_true(detection_store_get_plate(&store, seq, &key));
+    zassert_equal(key, plate_pack_key("XYZ9A87"), "Nova leitura pega a placa nova");
+}
+
+ZTEST_SUITE(detection_store_tests, NULL, NULL, detection_store_before, NULL, NULL);
@@ -0,0 +1,122 @@
+/**
+ * @file test_display_coalesce.c
+ * @brief Testes unitários da fusão de quadros do display por faixa
+ *
+ * Testa as funções:
+ * - display_coalescer_offer (novo, placa do mesmo veículo, atrasada)
+ * - display_coalescer_take (mais recente entre faixas, quadros pulados)
+ */
+
+#include <zephyr/ztest.h>
+#include <string.h>
+#include "../src/utils/display_coalesce.h"
+
+static struct display_coalescer coalescer;
+
+static display_data_msg_t frame(uint32_t seq, uint8_t lane, uint32_t speed)
+{
+    display_data_msg_t msg = {
+        .seq = seq,
+        .speed_centi_kmh = speed,
+        .vehicle_type = VEHICLE_TYPE_LIGHT,
+        .status = SPEED_STATUS_NORMAL,
+        .speed_limit = 60,
+        .plate = {0},
+        .lane_id = lane
+    };
+
+    return msg;
+}
+
+static void display_coalesce_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    display_coalescer_init(&coalescer);
+}
+
+/**
+ * @brief Testa que só o último veículo da faixa é desenhado
+ */
+ZTEST(display_coalesce_tests, test_latest_wins)
+{
+    display_data_msg_t out;
+
+    zassert_false(display_coalescer_take(&coalescer, &out), "Nada pendente");
+
+    for (uint32_t seq = 1; seq <= 5; seq++) {
+        display_data_msg_t msg = frame(seq, 0, 4000 + seq);
+
+        zassert_equal(display_coalescer_offer(&coalescer, &msg), DISPLAY_OFFER_NEW);
+    }
+
+    zassert_true(display_coalescer_pending(&coalescer));
+    zassert_true(display_coalescer_take(&coalescer, &out));
+    zassert_equal(out.seq, 5, "Último veículo");
+    zassert_equal(out.speed_centi_kmh, 4005);
+    zassert_equal(coalescer.skipped, 4, "Quatro quadros substituídos");
+    zassert_false(display_coalescer_pending(&coalescer));
+}
+
+/**
+ * @brief Testa a placa do mesmo veículo e a placa atrasada
+ */
+ZTEST(display_coalesce_tests, test_plate_merge_and_stale)
+{
+    display_data_msg_t out;
+    display_data_msg_t speed = frame(10, 1, 7000);
+    display_data_msg_t plate = speed;
+
+    strcpy(plate.plate, "ABC1D23");
+
+    display_coalescer_offer(&coalescer, &speed);
+    zassert_equal(display_coalescer_offer(&coalescer, &plate), DISPLAY_OFFER_MERGED);
+    zassert_true(display_coalescer_take(&coalescer, &out));
+    zassert_str_equal(out.plate, "ABC1D23", "Placa fundida ao quadro");
+    zassert_equal(coalescer.skipped, 0, "Placa não conta como pulado");
+
+    /* Placa já desenhada volta a ser pendente só se mudar de veículo */
+    display_data_msg_t next = frame(11, 1, 5000);
+
+    display_coalescer_offer(&coalescer, &next);
+    zassert_equal(display_coalescer_offer(&coalescer, &plate), DISPLAY_OFFER_STALE,
+                  "Placa de veículo substituído na faixa");
+    zassert_true(display_coalescer_take(&coalescer, &out));
+    zassert_equal(out.seq, 11);
+    zassert_str_equal(out.plate, "");
+}
+
+/**
+ * @brief Testa a escolha entre faixas
+ */
+ZTEST(display_coalesce_tests, test_newest_across_lanes)
+{
+    display_data_msg_t out;
+    display_data_msg_t lane0 = frame(21, 0, 5000);
+    display_data_msg_t lane1 = frame(20, 1, 6000);
+
+    display_coalescer_offer(&coalescer, &lane0);
+    display_coalescer_offer(&coalescer, &lane1);
+
+    zassert_true(display_coalescer_take(&coalescer, &out));
+    zassert_equal(out.seq, 21, "Veículo mais recente entre as faixas");
+    zassert_equal(coalescer.skipped, 1, "Faixa mais antiga coberta");
+    zassert_equal(coalescer.latest[1].seq, 20, "Estado da faixa preservado");
+}
+
+/**
+ * @brief Testa o wrap-around do seq
+ */
+ZTEST(display_coalesce_tests, test_seq_wraparound)
+{
+    display_data_msg_t out;
+    display_data_msg_t before = frame(UINT32_MAX, 0, 5000);
+    display_data_msg_t after = frame(0, 0, 5100);
+
+    display_coalescer_offer(&coalescer, &before);
+    zassert_equal(display_coalescer_offer(&coalescer, &after), DISPLAY_OFFER_NEW);
+    zassert_equal(display_coalescer_offer(&coalescer, &before), DISPLAY_OFFER_STALE);
+    zassert_true(display_coalescer_take(&coalescer, &out));
+    zassert_equal(out.seq, 0);
+}
+
+ZTEST_SUITE(display_coalesce_tests, NULL, NULL, display_coalesce_before, NULL, NULL);
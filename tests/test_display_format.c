@@ -0,0 +1,60 @@
+/**
+ * @file test_display_format.c
+ * @brief Testes unitários da formatação do display
+ * 
+ * Testa as funções:
+ * - format_display_frame
+ * - get_status_text
+ */
+
+#include <zephyr/ztest.h>
+#include "../src/utils/display_format.h"
+
+/**
+ * @brief Testa quadro sem placa
+ */
+ZTEST(display_format_tests, test_frame_without_plate)
+{
+    char buf[DISPLAY_FRAME_MAX_LEN];
+    display_data_msg_t data = {
+        .seq = 1,
+        .speed_centi_kmh = 5612,
+        .vehicle_type = VEHICLE_TYPE_LIGHT,
+        .status = SPEED_STATUS_WARNING,
+        .speed_limit = 60,
+        .plate = {0}
+    };
+    
+    int len = format_display_frame(buf, sizeof(buf), &data);
+    
+    zassert_true(len > 0 && len < (int)sizeof(buf), "Quadro deve caber no buffer");
+    zassert_not_null(strstr(buf, " 56.12 km/h"), "Velocidade com 2 casas");
+    zassert_not_null(strstr(buf, ANSI_COLOR_YELLOW), "Alerta em amarelo");
+    zassert_is_null(strstr(buf, "Placa:"), "Sem linha de placa");
+}
+
+/**
+ * @brief Testa quadro com código de erro da câmera
+ */
+ZTEST(display_format_tests, test_frame_with_error_plate)
+{
+    char buf[DISPLAY_FRAME_MAX_LEN];
+    display_data_msg_t data = {
+        .seq = 2,
+        .speed_centi_kmh = 7000,
+        .vehicle_type = VEHICLE_TYPE_HEAVY,
+        .status = SPEED_STATUS_VIOLATION,
+        .speed_limit = 40,
+        .plate = "ERR016"
+    };
+    
+    int len = format_display_frame(buf, sizeof(buf), &data);
+    
+    zassert_true(len > 0 && len < (int)sizeof(buf), "Quadro deve caber no buffer");
+    zassert_not_null(strstr(buf, ANSI_COLOR_RED "ERR016"), "Erro em vermelho");
+    zassert_not_null(strstr(buf, "PESADO"), "Tipo do veículo");
+    zassert_equal(strcmp(get_status_text(SPEED_STATUS_VIOLATION), "INFRACAO"), 0,
+                  "Texto de infração");
+}
+
+ZTEST_SUITE(display_format_tests, NULL, NULL, NULL, NULL, NULL);
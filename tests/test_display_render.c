@@ -0,0 +1,115 @@
+/**
+ * @file test_display_render.c
+ * @brief Testes unitários da renderização incremental do display
+ * 
+ * Testa as funções:
+ * - display_render_template
+ * - display_render_update (primeiro quadro, sem mudança, só placa)
+ */
+
+#include <zephyr/ztest.h>
+#include "../src/utils/display_render.h"
+
+static struct display_renderer renderer;
+
+static const display_data_msg_t vehicle = {
+    .seq = 1,
+    .speed_centi_kmh = 7012,
+    .vehicle_type = VEHICLE_TYPE_LIGHT,
+    .status = SPEED_STATUS_VIOLATION,
+    .speed_limit = 60,
+    .plate = {0}
+};
+
+static void display_render_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    display_renderer_init(&renderer);
+}
+
+/**
+ * @brief Testa o template fixo
+ */
+ZTEST(display_render_tests, test_template)
+{
+    char buf[DISPLAY_TEMPLATE_MAX_LEN];
+    size_t len = display_render_template(buf, sizeof(buf));
+
+    zassert_true(len > 0 && len < sizeof(buf), "Template deve caber no buffer");
+    zassert_equal(strlen(buf), len, "Comprimento retornado");
+    zassert_not_null(strstr(buf, "| Velocidade:                            |"),
+                     "Linha de velocidade vazia");
+    zassert_not_null(strstr(buf, "\x1b[10r"), "Rolagem abaixo do quadro");
+    zassert_equal(display_render_template(buf, 16), 0, "Buffer pequeno");
+}
+
+/**
+ * @brief Testa o primeiro quadro (todos os campos)
+ */
+ZTEST(display_render_tests, test_first_update_writes_all_fields)
+{
+    char buf[DISPLAY_UPDATE_MAX_LEN];
+    size_t len = display_render_update(&renderer, &vehicle, buf, sizeof(buf));
+
+    zassert_true(len > 0 && len < sizeof(buf), "Atualização deve caber no buffer");
+    zassert_equal(strncmp(buf, ANSI_SAVE_CURSOR, strlen(ANSI_SAVE_CURSOR)), 0,
+                  "Salva o cursor dos logs");
+    zassert_not_null(strstr(buf, "\x1b[4;15HLEVE "), "Tipo na linha 4");
+    zassert_not_null(strstr(buf, "\x1b[5;15H" ANSI_BOLD ANSI_COLOR_RED " 70.12 km/h"),
+                     "Velocidade em vermelho na linha 5");
+    zassert_not_null(strstr(buf, "\x1b[6;15H 60 km/h"), "Limite na linha 6");
+    zassert_not_null(strstr(buf, "\x1b[7;15H" ANSI_BOLD ANSI_COLOR_RED "INFRACAO"),
+                     "Status na linha 7");
+    zassert_not_null(strstr(buf, "\x1b[8;15H"), "Placa (vazia) na linha 8");
+    zassert_not_null(strstr(buf, ANSI_RESTORE_CURSOR), "Restaura o cursor");
+}
+
+/**
+ * @brief Testa que só a placa é reescrita após a captura
+ */
+ZTEST(display_render_tests, test_plate_only_update)
+{
+    char buf[DISPLAY_UPDATE_MAX_LEN];
+    display_data_msg_t captured = vehicle;
+
+    display_render_update(&renderer, &vehicle, buf, sizeof(buf));
+
+    /* Mesmos dados: nada a emitir */
+    zassert_equal(display_render_update(&renderer, &vehicle, buf, sizeof(buf)), 0,
+                  "Sem mudanças, sem bytes");
+
+    strcpy(captured.plate, "ABC1D23");
+    size_t len = display_render_update(&renderer, &captured, buf, sizeof(buf));
+
+    zassert_true(len > 0, "Placa mudou");
+    zassert_not_null(strstr(buf, "\x1b[8;15H" ANSI_BOLD "ABC1D23"), "Placa na linha 8");
+    zassert_is_null(strstr(buf, "\x1b[5;"), "Velocidade não é reescrita");
+    zassert_is_null(strstr(buf, "\x1b[4;"), "Tipo não é reescrito");
+    zassert_true(len < 64, "Atualização de placa curta");
+}
+
+/**
+ * @brief Testa que um novo veículo apaga a placa anterior
+ */
+ZTEST(display_render_tests, test_new_vehicle_clears_plate)
+{
+    char buf[DISPLAY_UPDATE_MAX_LEN];
+    display_data_msg_t captured = vehicle;
+    display_data_msg_t next = vehicle;
+
+    strcpy(captured.plate, "ERR016");
+    display_render_update(&renderer, &captured, buf, sizeof(buf));
+    zassert_not_null(strstr(buf, ANSI_COLOR_RED "ERR016"), "Erro em vermelho");
+
+    next.seq = 2;
+    next.speed_centi_kmh = 4500;
+    next.status = SPEED_STATUS_NORMAL;
+    display_render_update(&renderer, &next, buf, sizeof(buf));
+
+    zassert_not_null(strstr(buf, "\x1b[8;15H" ANSI_BOLD "                           "),
+                     "Placa anterior apagada");
+    zassert_not_null(strstr(buf, ANSI_COLOR_GREEN " 45.00 km/h"), "Nova velocidade");
+    zassert_is_null(strstr(buf, "\x1b[6;"), "Limite igual não é reescrito");
+}
+
+ZTEST_SUITE(display_render_tests, NULL, NULL, display_render_before, NULL, NULL);
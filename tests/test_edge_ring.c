@@ -0,0 +1,82 @@
+/**
+ * @file test_edge_ring.c
+ * @brief Testes unitários da fila de bordas dos sensores
+ *
+ * Testa as funções:
+ * - edge_ring_push
+ * - edge_ring_pop
+ * - edge_ring_take_dropped
+ */
+
+#include <zephyr/ztest.h>
+#include "../src/utils/edge_ring.h"
+
+static struct edge_ring ring;
+
+static void edge_ring_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    edge_ring_init(&ring);
+}
+
+/**
+ * @brief Testa ordem FIFO e fila vazia
+ */
+ZTEST(edge_ring_tests, test_fifo_order)
+{
+    edge_event_t ev;
+
+    zassert_false(edge_ring_pop(&ring, &ev), "Fila nova deve estar vazia");
+
+    for (uint8_t i = 0; i < 5; i++) {
+        edge_event_t in = { .timestamp = 1000 + i, .lane_id = i, .sensor = 1 + (i % 2) };
+        zassert_true(edge_ring_push(&ring, &in), "Push deve ser aceito");
+    }
+
+    for (uint8_t i = 0; i < 5; i++) {
+        zassert_true(edge_ring_pop(&ring, &ev), "Deve haver evento");
+        zassert_equal(ev.timestamp, 1000 + i, "Ordem FIFO incorreta");
+        zassert_equal(ev.lane_id, i, "Faixa incorreta");
+        zassert_equal(ev.sensor, 1 + (i % 2), "Sensor incorreto");
+    }
+
+    zassert_false(edge_ring_pop(&ring, &ev), "Fila deve ficar vazia");
+}
+
+/**
+ * @brief Testa fila cheia e contador de descartes
+ */
+ZTEST(edge_ring_tests, test_overflow_counts_drops)
+{
+    edge_event_t ev = { .timestamp = 0, .lane_id = 0, .sensor = 1 };
+
+    for (int i = 0; i < EDGE_RING_SIZE; i++) {
+        zassert_true(edge_ring_push(&ring, &ev), "Fila ainda não está cheia");
+    }
+
+    zassert_false(edge_ring_push(&ring, &ev), "Fila cheia deve recusar");
+    zassert_false(edge_ring_push(&ring, &ev), "Fila cheia deve recusar");
+    zassert_equal(edge_ring_take_dropped(&ring), 2, "Devem ser 2 descartes");
+    zassert_equal(edge_ring_take_dropped(&ring), 0, "Contador deve ser zerado");
+
+    /* Liberar uma posição permite novo push */
+    zassert_true(edge_ring_pop(&ring, &ev), "Deve haver evento");
+    zassert_true(edge_ring_push(&ring, &ev), "Push após pop deve ser aceito");
+}
+
+/**
+ * @brief Testa a volta dos índices ao redor do buffer
+ */
+ZTEST(edge_ring_tests, test_wrap_around)
+{
+    edge_event_t ev;
+
+    for (uint32_t i = 0; i < 10 * EDGE_RING_SIZE; i++) {
+        edge_event_t in = { .timestamp = i, .lane_id = 0, .sensor = 2 };
+        zassert_true(edge_ring_push(&ring, &in), "Push deve ser aceito");
+        zassert_true(edge_ring_pop(&ring, &ev), "Pop deve retornar evento");
+        zassert_equal(ev.timestamp, i, "Evento incorreto após wrap-around");
+    }
+}
+
+ZTEST_SUITE(edge_ring_tests, NULL, NULL, edge_ring_before, NULL, NULL);
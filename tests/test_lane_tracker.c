@@ -0,0 +1,697 @@
+/**
+ * @file test_lane_tracker.c
+ * @brief Testes unitários do rastreador de veículos em trânsito
+ *
+ * Testa as funções:
+ * - lane_tracker_sensor1 / lane_tracker_sensor2 (casamento por ordem de eixo)
+ * - lane_tracker_close / lane_tracker_take_complete
+ * - lane_tracker_expire
+ * - Entrada de descarte com a FIFO cheia e ressincronização por trânsito
+ * - lane_vehicle_transit
+ * - lane_vehicle_travel (agrupamento pela velocidade do primeiro eixo)
+ * - lane_tracker_group_gap (fallback, folga, limites, separação em rodovia)
+ * - Tráfego denso do gerador: velocidades conferidas com a referência,
+ *   inclusive com uma borda perdida e com o intervalo adaptativo e
+ *   veículos pesados
+ */
+
+#include <zephyr/ztest.h>
+#include <stdlib.h>
+#include "../src/utils/lane_tracker.h"
+#include "../src/utils/traffic_gen.h"
+#include "../src/utils/axle_class.h"
+
+/* Tempos em us nos testes (o rastreador não depende da unidade) */
+#define GAP 300000ULL
+#define MAX_TRANSIT 2000000ULL
+
+static struct lane_tracker tr;
+
+static void lane_tracker_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    lane_tracker_init(&tr);
+}
+
+/**
+ * @brief Veículo simples: eixos casados em ordem, fecha após o intervalo
+ */
+ZTEST(lane_tracker_tests, test_single_vehicle)
+{
+    lane_vehicle_t v;
+
+    zassert_equal(lane_tracker_sensor1(&tr, 1000, GAP), LANE_S1_NEW_VEHICLE);
+    zassert_equal(lane_tracker_sensor1(&tr, 101000, GAP), LANE_S1_AXLE);
+    zassert_true(lane_tracker_sensor2(&tr, 46000));
+    zassert_true(lane_tracker_sensor2(&tr, 148000));
+
+    /* Todos os eixos casados, mas o grupo ainda pode receber eixos */
+    zassert_false(lane_tracker_take_complete(&tr, &v));
+    zassert_false(lane_tracker_close(&tr, 101000 + GAP, GAP));
+    zassert_true(lane_tracker_close(&tr, 101001 + GAP, GAP));
+
+    zassert_true(lane_tracker_take_complete(&tr, &v));
+    zassert_equal(v.axles, 2);
+    zassert_equal(lane_vehicle_transit(&v), (45000 + 47000) / 2, "Média dos eixos");
+    zassert_equal(v.last_s2, 148000);
+    zassert_equal(tr.count, 0);
+}
+
+/**
+ * @brief Veículo mais longo que a distância entre sensores
+ *
+ * O primeiro eixo chega ao sensor 2 antes do segundo passar pelo
+ * sensor 1: as bordas se intercalam, mas continua um só veículo.
+ */
+ZTEST(lane_tracker_tests, test_long_vehicle_interleaved)
+{
+    lane_vehicle_t v;
+
+    lane_tracker_sensor1(&tr, 0, GAP);
+    zassert_true(lane_tracker_sensor2(&tr, 45000));
+    zassert_equal(lane_tracker_sensor1(&tr, 120000, GAP), LANE_S1_AXLE);
+    zassert_true(lane_tracker_sensor2(&tr, 165000));
+    zassert_equal(lane_tracker_sensor1(&tr, 200000, GAP), LANE_S1_AXLE);
+    zassert_true(lane_tracker_sensor2(&tr, 245000));
+
+    lane_tracker_close(&tr, 200001 + GAP, GAP);
+    zassert_true(lane_tracker_take_complete(&tr, &v));
+    zassert_equal(v.axles, 3);
+    zassert_equal(lane_vehicle_transit(&v), 45000);
+}
+
+/**
+ * @brief Veículos próximos: bordas do sensor 2 do primeiro chegam depois
+ *        do primeiro eixo do segundo no sensor 1
+ */
+ZTEST(lane_tracker_tests, test_pipelined_vehicles)
+{
+    lane_vehicle_t v;
+
+    /* A: 3 eixos a 1 s do sensor 2 */
+    lane_tracker_sensor1(&tr, 0, GAP);
+    lane_tracker_sensor1(&tr, 200000, GAP);
+    lane_tracker_sensor1(&tr, 260000, GAP);
+
+    /* B começa antes de qualquer eixo de A chegar ao sensor 2 */
+    zassert_equal(lane_tracker_sensor1(&tr, 700000, GAP), LANE_S1_NEW_VEHICLE);
+    zassert_equal(tr.count, 2);
+    zassert_equal(lane_tracker_sensor1(&tr, 800000, GAP), LANE_S1_AXLE);
+    zassert_true(lane_tracker_sensor2(&tr, 1000000));
+    zassert_true(lane_tracker_sensor2(&tr, 1200000));
+    zassert_false(lane_tracker_take_complete(&tr, &v), "A ainda tem eixo pendente");
+    zassert_true(lane_tracker_sensor2(&tr, 1260000));
+
+    /* A sai com a velocidade dele, sem as bordas de B */
+    zassert_true(lane_tracker_take_complete(&tr, &v));
+    zassert_equal(v.axles, 3);
+    zassert_equal(lane_vehicle_transit(&v), 1000000);
+
+    /* Bordas seguintes são de B (0,5 s) */
+    zassert_true(lane_tracker_sensor2(&tr, 1200000 + 1));
+    zassert_true(lane_tracker_sensor2(&tr, 1300000));
+    zassert_false(lane_tracker_take_complete(&tr, &v), "B ainda aberto");
+    lane_tracker_close(&tr, 800001 + GAP, GAP);
+    zassert_true(lane_tracker_take_complete(&tr, &v));
+    zassert_equal(v.axles, 2);
+    zassert_equal(lane_vehicle_transit(&v), 500000);
+}
+
+/**
+ * @brief Sensor 2 sem eixo pendente é ignorado
+ */
+ZTEST(lane_tracker_tests, test_sensor2_without_sensor1)
+{
+    zassert_false(lane_tracker_sensor2(&tr, 1000));
+
+    lane_tracker_sensor1(&tr, 2000, GAP);
+    zassert_true(lane_tracker_sensor2(&tr, 3000));
+    zassert_false(lane_tracker_sensor2(&tr, 4000), "Eixo já casado");
+}
+
+/**
+ * @brief FIFO cheia: o novo veículo vai para a entrada de descarte, que
+ *        absorve suas bordas no sensor 2 sem deslocar o veículo seguinte
+ */
+ZTEST(lane_tracker_tests, test_fifo_full)
+{
+    lane_vehicle_t v;
+
+    for (int i = 0; i < LANE_TRACKER_DEPTH; i++) {
+        zassert_equal(lane_tracker_sensor1(&tr, i * 1000000ULL, GAP), LANE_S1_NEW_VEHICLE);
+    }
+
+    /* Descartado: 2 eixos; o último veículo real é fechado */
+    uint64_t t = LANE_TRACKER_DEPTH * 1000000ULL;
+
+    zassert_equal(lane_tracker_sensor1(&tr, t, GAP), LANE_S1_FULL);
+    zassert_equal(lane_tracker_sensor1(&tr, t + 100000, GAP), LANE_S1_FULL);
+    zassert_equal(tr.count, LANE_TRACKER_DEPTH + 1);
+    zassert_true(lane_tracker_at(&tr, LANE_TRACKER_DEPTH - 1)->state ==
+                 SENSOR_STATE_MEASURING_SPEED, "Último veículo deve ser fechado");
+
+    /* Outro veículo com a FIFO cheia cai no mesmo descarte */
+    zassert_equal(lane_tracker_sensor1(&tr, t + 1000000, GAP), LANE_S1_FULL);
+    zassert_equal(tr.count, LANE_TRACKER_DEPTH + 1);
+
+    /* Sensor 2 dos veículos reais (trânsito de 5 s, todos ainda entre os sensores) */
+    for (int i = 0; i < LANE_TRACKER_DEPTH; i++) {
+        zassert_true(lane_tracker_sensor2(&tr, i * 1000000ULL + 5000000));
+    }
+    for (int i = 0; i < LANE_TRACKER_DEPTH; i++) {
+        zassert_true(lane_tracker_take_complete(&tr, &v));
+        zassert_equal(lane_vehicle_transit(&v), 5000000);
+    }
+
+    /* Um veículo real entra atrás do descarte */
+    zassert_equal(lane_tracker_sensor1(&tr, t + 2000000, GAP), LANE_S1_NEW_VEHICLE);
+
+    /* Bordas dos eixos descartados são absorvidas, não casadas com o novo */
+    zassert_true(lane_tracker_sensor2(&tr, t + 5000000));
+    zassert_true(lane_tracker_sensor2(&tr, t + 5100000));
+    zassert_true(lane_tracker_sensor2(&tr, t + 6000000));
+    zassert_false(lane_tracker_take_complete(&tr, &v), "Novo veículo ainda aberto");
+    zassert_true(lane_tracker_sensor2(&tr, t + 2000000 + 400000));
+
+    lane_tracker_close(&tr, t + 2000001 + GAP, GAP);
+    zassert_true(lane_tracker_take_complete(&tr, &v));
+    zassert_false(v.discard);
+    zassert_equal(v.axles, 1);
+    zassert_equal(lane_vehicle_transit(&v), 400000);
+    zassert_equal(tr.count, 0);
+}
+
+/**
+ * @brief Borda perdida no sensor 2: o eixo fica sem tempo e as bordas
+ *        seguintes continuam nos eixos certos
+ */
+ZTEST(lane_tracker_tests, test_lost_sensor2_edge_resync)
+{
+    lane_vehicle_t v;
+
+    /* A: 3 eixos, 400 ms entre sensores; a borda do segundo se perde */
+    lane_tracker_sensor1(&tr, 0, GAP);
+    lane_tracker_sensor1(&tr, 300000, GAP);
+    lane_tracker_sensor1(&tr, 600000, GAP);
+    zassert_true(lane_tracker_sensor2(&tr, 400000));
+    zassert_true(lane_tracker_sensor2(&tr, 1000000));
+    zassert_equal(lane_tracker_at(&tr, 0)->matched, 3);
+
+    lane_tracker_close(&tr, 600001 + GAP, GAP);
+    zassert_true(lane_tracker_take_complete(&tr, &v));
+    zassert_equal(v.axles, 3);
+    zassert_equal(v.timed, 2);
+    zassert_equal(lane_vehicle_transit(&v), 400000);
+
+    /* B: a borda do último eixo se perde; a seguinte já é de C */
+    lane_tracker_sensor1(&tr, 2000000, GAP);
+    lane_tracker_sensor1(&tr, 2150000, GAP);
+    lane_tracker_sensor1(&tr, 3000000, GAP);
+    zassert_true(lane_tracker_sensor2(&tr, 2400000));
+    zassert_true(lane_tracker_sensor2(&tr, 3500000));
+
+    zassert_true(lane_tracker_take_complete(&tr, &v));
+    zassert_equal(v.axles, 2);
+    zassert_equal(lane_vehicle_transit(&v), 400000);
+
+    lane_tracker_close(&tr, 3000001 + GAP, GAP);
+    zassert_true(lane_tracker_take_complete(&tr, &v));
+    zassert_equal(lane_vehicle_transit(&v), 500000);
+}
+
+/**
+ * @brief Borda cedo demais para o eixo pendente é ignorada
+ */
+ZTEST(lane_tracker_tests, test_spurious_sensor2_edge)
+{
+    lane_vehicle_t v;
+
+    lane_tracker_sensor1(&tr, 0, GAP);
+    lane_tracker_sensor1(&tr, 300000, GAP);
+    zassert_true(lane_tracker_sensor2(&tr, 400000));
+
+    /* Segundo eixo só pode chegar perto de 700 ms */
+    zassert_false(lane_tracker_sensor2(&tr, 401000), "Repique da borda anterior");
+    zassert_true(lane_tracker_sensor2(&tr, 700000));
+
+    lane_tracker_close(&tr, 300001 + GAP, GAP);
+    zassert_true(lane_tracker_take_complete(&tr, &v));
+    zassert_equal(lane_vehicle_transit(&v), 400000);
+}
+
+/**
+ * @brief Veículo cujo sensor 2 se perdeu expira e não desloca os seguintes
+ */
+ZTEST(lane_tracker_tests, test_expire_missing_sensor2)
+{
+    lane_vehicle_t v;
+
+    /* A: 2 eixos, só um chega ao sensor 2 */
+    lane_tracker_sensor1(&tr, 0, GAP);
+    lane_tracker_sensor1(&tr, 100000, GAP);
+    lane_tracker_sensor2(&tr, 50000);
+    lane_tracker_close(&tr, 100001 + GAP, GAP);
+
+    zassert_false(lane_tracker_expire(&tr, 100000 + MAX_TRANSIT, MAX_TRANSIT));
+    zassert_true(lane_tracker_expire(&tr, 100001 + MAX_TRANSIT, MAX_TRANSIT));
+    zassert_equal(tr.count, 0);
+
+    /* B é medido normalmente */
+    lane_tracker_sensor1(&tr, 3000000, GAP);
+    lane_tracker_sensor2(&tr, 3040000);
+    lane_tracker_close(&tr, 3000001 + GAP, GAP);
+    zassert_true(lane_tracker_take_complete(&tr, &v));
+    zassert_equal(lane_vehicle_transit(&v), 40000);
+}
+
+/**
+ * @brief Eixos além de LANE_TRACKER_MAX_AXLES são contados, não cronometrados
+ */
+ZTEST(lane_tracker_tests, test_axles_beyond_storage)
+{
+    lane_vehicle_t v;
+    int axles = LANE_TRACKER_MAX_AXLES + 2;
+
+    for (int i = 0; i < axles; i++) {
+        lane_tracker_sensor1(&tr, i * 10000ULL, GAP);
+    }
+    for (int i = 0; i < axles; i++) {
+        lane_tracker_sensor2(&tr, i * 10000ULL + 30000);
+    }
+    lane_tracker_close(&tr, (axles - 1) * 10000ULL + GAP + 1, GAP);
+
+    zassert_true(lane_tracker_take_complete(&tr, &v));
+    zassert_equal(v.axles, axles);
+    zassert_equal(lane_vehicle_transit(&v), 30000);
+}
+
+/**
+ * @brief Velocidade do primeiro eixo converte espaçamento em tempo
+ */
+ZTEST(lane_tracker_tests, test_travel_from_first_axle)
+{
+    lane_tracker_sensor1(&tr, 0, GAP);
+    lane_vehicle_t *open = lane_tracker_open(&tr);
+
+    zassert_equal(lane_vehicle_travel(open, 10000, 1000), 0, "Velocidade desconhecida");
+
+    /* 1000 mm em 36 ms (100 km/h): 10 m em 360 ms */
+    lane_tracker_sensor2(&tr, 36000);
+    zassert_equal(lane_vehicle_travel(open, 10000, 1000), 360000);
+
+    /* Eixos seguintes não mudam a referência */
+    lane_tracker_sensor1(&tr, 97000, GAP);
+    lane_tracker_sensor2(&tr, 140000);
+    zassert_equal(open->first_transit, 36000);
+    zassert_equal(lane_vehicle_travel(open, 10000, 0), 0, "Distância inválida");
+}
+
+/* Intervalo de agrupamento com os valores da aplicação (us, 1 m entre sensores) */
+static const lane_group_params_t group_params = {
+    .fallback = 662000,
+    .min_gap = 100000,
+    .max_gap = 3000000,
+    .max_spacing_mm = AXLE_CLASS_MAX_SPACING_MM,
+    .distance_mm = 1000,
+};
+
+/**
+ * @brief Sem veículo aberto ou sem o primeiro eixo no sensor 2: fallback
+ */
+ZTEST(lane_tracker_tests, test_group_gap_fallback)
+{
+    zassert_equal(lane_tracker_group_gap(&tr, &group_params), 662000);
+
+    lane_tracker_sensor1(&tr, 0, group_params.fallback);
+    zassert_equal(lane_tracker_group_gap(&tr, &group_params), 662000, "Velocidade desconhecida");
+
+    /* Fechado: o próximo veículo ainda não tem velocidade */
+    lane_tracker_sensor2(&tr, 36000);
+    lane_tracker_close(&tr, UINT64_MAX, 0);
+    zassert_equal(lane_tracker_group_gap(&tr, &group_params), 662000);
+}
+
+/**
+ * @brief Borda do primeiro eixo no sensor 2 troca o fallback pelo tempo
+ *        do maior espaçamento mais 1/8 (o prazo deve ser rearmado)
+ */
+ZTEST(lane_tracker_tests, test_group_gap_from_first_axle)
+{
+    lane_tracker_sensor1(&tr, 0, lane_tracker_group_gap(&tr, &group_params));
+    zassert_equal(lane_tracker_group_gap(&tr, &group_params), 662000);
+
+    /* 100 km/h: 1 m em 36 ms, 13 m em 468 ms, +1/8 = 526,5 ms */
+    lane_tracker_sensor2(&tr, 36000);
+    zassert_equal(lane_tracker_group_gap(&tr, &group_params), 468000 + 58500);
+
+    /* Eixos seguintes não mudam o intervalo */
+    lane_tracker_sensor1(&tr, 97200, lane_tracker_group_gap(&tr, &group_params));
+    lane_tracker_sensor2(&tr, 133200);
+    zassert_equal(lane_tracker_group_gap(&tr, &group_params), 468000 + 58500);
+}
+
+/**
+ * @brief Intervalo limitado a [min_gap, max_gap]
+ */
+ZTEST(lane_tracker_tests, test_group_gap_clamp)
+{
+    lane_group_params_t params = group_params;
+
+    /* 5 km/h: 1 m em 720 ms, 13 m passaria de 10 s */
+    lane_tracker_sensor1(&tr, 0, params.fallback);
+    lane_tracker_sensor2(&tr, 720000);
+    zassert_equal(lane_tracker_group_gap(&tr, &params), 3000000);
+
+    /* Espaçamento curto a 100 km/h: 1 m em 36 ms, +1/8 < 100 ms */
+    lane_tracker_init(&tr);
+    params.max_spacing_mm = 1000;
+    lane_tracker_sensor1(&tr, 0, params.fallback);
+    lane_tracker_sensor2(&tr, 36000);
+    zassert_equal(lane_tracker_group_gap(&tr, &params), 100000);
+}
+
+/**
+ * @brief Rodovia: carros a 100 km/h com 600 ms entre o último eixo de um
+ *        e o primeiro do seguinte se fundiriam com o valor estático
+ *        (662 ms), mas são separados pela velocidade
+ */
+ZTEST(lane_tracker_tests, test_group_gap_highway_separation)
+{
+    lane_vehicle_t v;
+
+    /* A: 2,7 m entre eixos a 100 km/h (97,2 ms), 36 ms entre sensores */
+    lane_tracker_sensor1(&tr, 0, lane_tracker_group_gap(&tr, &group_params));
+    lane_tracker_sensor2(&tr, 36000);
+    lane_tracker_sensor1(&tr, 97200, lane_tracker_group_gap(&tr, &group_params));
+    lane_tracker_sensor2(&tr, 133200);
+
+    uint64_t b_arrival = 97200 + 600000;
+
+    zassert_true(b_arrival - 97200 <= group_params.fallback, "Estático fundiria");
+    zassert_equal(lane_tracker_sensor1(&tr, b_arrival,
+                                       lane_tracker_group_gap(&tr, &group_params)),
+                  LANE_S1_NEW_VEHICLE);
+    zassert_true(lane_tracker_take_complete(&tr, &v));
+    zassert_equal(v.axles, 2);
+    zassert_equal(tr.count, 1);
+}
+
+/* Tráfego denso do gerador: chegadas de Poisson, só veículos leves */
+#define DENSE_VEHICLES 300
+#define DENSE_DISTANCE_MM 10000
+#define DENSE_GAP_US 250000ULL
+
+typedef struct {
+    uint64_t time_us;
+    uint8_t sensor;
+    uint16_t vehicle;   /**< Índice em dense_truth */
+    uint8_t axle;
+} dense_edge_t;
+
+static traffic_gen_vehicle_t dense_truth[DENSE_VEHICLES];
+static dense_edge_t dense_edges[DENSE_VEHICLES * TRAFFIC_GEN_MAX_AXLES * 2];
+static lane_vehicle_t dense_out[DENSE_VEHICLES];
+static struct traffic_gen dense_gen;
+
+static const struct traffic_gen_config dense_cfg = {
+    .lanes = 1,
+    .rate_vph = { 1800 },
+    .arrivals = TRAFFIC_GEN_POISSON,
+    .speed_mean_kmh = 80,
+    .speed_sd_kmh = 5,
+    .heavy_percent = 0,
+    .platoon_percent = 0,
+    .sensor_distance_mm = DENSE_DISTANCE_MM,
+};
+
+/*
+ * Intervalo adaptativo da aplicação na distância do tráfego denso. O
+ * primeiro eixo chega ao sensor 2 (~450 ms) antes de o fallback poder
+ * fechar o grupo: o agrupamento esperado depende só da velocidade.
+ */
+static const lane_group_params_t dense_group = {
+    .fallback = 662000,
+    .min_gap = 100000,
+    .max_gap = 3000000,
+    .max_spacing_mm = AXLE_CLASS_MAX_SPACING_MM,
+    .distance_mm = DENSE_DISTANCE_MM,
+};
+
+static const traffic_gen_shape_t *dense_shape(const traffic_gen_vehicle_t *v)
+{
+    for (size_t s = 0; s < ARRAY_SIZE(traffic_gen_shapes); s++) {
+        if (traffic_gen_shapes[s].axles == v->axle_count) {
+            return &traffic_gen_shapes[s];
+        }
+    }
+    zassert_unreachable("Forma de %u eixos", v->axle_count);
+    return NULL;
+}
+
+/**
+ * @brief Intervalo de agrupamento de um veículo (fixo ou pela velocidade)
+ */
+static uint64_t dense_gap(const traffic_gen_vehicle_t *v, const lane_group_params_t *group)
+{
+    if (group == NULL) {
+        return DENSE_GAP_US;
+    }
+
+    uint64_t gap = traffic_gen_travel_us(DENSE_DISTANCE_MM, v->speed_centi_kmh) *
+                   group->max_spacing_mm / DENSE_DISTANCE_MM;
+
+    gap += gap / 8;
+    return CLAMP(gap, group->min_gap, group->max_gap);
+}
+
+static int dense_edge_cmp(const void *a, const void *b)
+{
+    const dense_edge_t *ea = a;
+    const dense_edge_t *eb = b;
+
+    return (ea->time_us > eb->time_us) - (ea->time_us < eb->time_us);
+}
+
+static void dense_drain(int *out_count)
+{
+    while (lane_tracker_take_complete(&tr, &dense_out[*out_count])) {
+        (*out_count)++;
+    }
+}
+
+/**
+ * @brief Gera a referência e as bordas ordenadas no tempo
+ *
+ * @return Número de bordas
+ */
+static int dense_build(const struct traffic_gen_config *cfg)
+{
+    int n_edges = 0;
+
+    traffic_gen_init(&dense_gen, cfg, 4242);
+    for (int i = 0; i < DENSE_VEHICLES; i++) {
+        traffic_gen_spawn(&dense_gen, 0);
+        dense_gen.edge_count = 0;
+        dense_truth[i] = dense_gen.last;
+
+        const traffic_gen_shape_t *shape = dense_shape(&dense_truth[i]);
+
+        for (uint8_t a = 0; a < shape->axles; a++) {
+            uint32_t speed = dense_truth[i].speed_centi_kmh;
+            uint64_t s1 = dense_truth[i].arrival_us +
+                          traffic_gen_travel_us(shape->offset_mm[a], speed);
+
+            dense_edges[n_edges++] = (dense_edge_t){ s1, 1, i, a };
+            dense_edges[n_edges++] = (dense_edge_t){
+                s1 + traffic_gen_travel_us(DENSE_DISTANCE_MM, speed), 2, i, a };
+        }
+    }
+    qsort(dense_edges, n_edges, sizeof(dense_edges[0]), dense_edge_cmp);
+    return n_edges;
+}
+
+/**
+ * @brief Passa as bordas pelo rastreador, exceto a de índice lost
+ *
+ * @param group Intervalo adaptativo, ou NULL para DENSE_GAP_US fixo
+ * @return Veículos entregues em dense_out
+ */
+static int dense_run(int n_edges, int lost, const lane_group_params_t *group)
+{
+    int out_count = 0;
+    uint8_t max_in_flight = 0;
+
+    for (int i = 0; i < n_edges; i++) {
+        uint64_t now = dense_edges[i].time_us;
+
+        if (i == lost) {
+            continue;
+        }
+
+        /* Timer de agrupamento: fecha antes da borda seguinte */
+        uint64_t gap = (group != NULL) ? lane_tracker_group_gap(&tr, group) : DENSE_GAP_US;
+
+        lane_tracker_close(&tr, now, gap);
+        dense_drain(&out_count);
+
+        if (dense_edges[i].sensor == 1) {
+            zassert_not_equal(lane_tracker_sensor1(&tr, now, gap), LANE_S1_FULL);
+        } else {
+            zassert_true(lane_tracker_sensor2(&tr, now), "Borda %d ignorada", i);
+        }
+        max_in_flight = MAX(max_in_flight, tr.count);
+        dense_drain(&out_count);
+    }
+    lane_tracker_close(&tr, UINT64_MAX, 0);
+    dense_drain(&out_count);
+    zassert_equal(tr.count, 0);
+
+    /*
+     * Com o intervalo adaptativo o grupo espera 13 m de espaçamento, mais
+     * que os 10 m entre sensores: o anterior já saiu quando o seguinte chega
+     */
+    if (group == NULL) {
+        zassert_true(max_in_flight >= 2, "Teste deve ter veículos simultâneos");
+    }
+    return out_count;
+}
+
+/**
+ * @brief Instante do último eixo de um veículo no sensor 1
+ */
+static uint64_t dense_last_s1(const traffic_gen_vehicle_t *v)
+{
+    const traffic_gen_shape_t *shape = dense_shape(v);
+
+    return v->arrival_us + traffic_gen_travel_us(shape->offset_mm[shape->axles - 1],
+                                                 v->speed_centi_kmh);
+}
+
+/**
+ * @brief Confere as saídas com a referência, agrupando veículos colados
+ *
+ * O grupo usa o intervalo do seu primeiro veículo (o primeiro eixo dá a
+ * velocidade).
+ *
+ * @return Veículos isolados conferidos
+ */
+static int dense_check(int out_count, const lane_group_params_t *group)
+{
+    int out = 0;
+    int singles = 0;
+
+    for (int i = 0; i < DENSE_VEHICLES; out++) {
+        int first = i;
+        uint32_t axles = 0;
+        uint64_t gap = dense_gap(&dense_truth[first], group);
+
+        do {
+            axles += dense_truth[i].axle_count;
+            i++;
+        } while (i < DENSE_VEHICLES &&
+                 dense_truth[i].arrival_us - dense_last_s1(&dense_truth[i - 1]) <= gap);
+
+        zassert_true(out < out_count, "Veículo %d não detectado", first);
+        zassert_equal(dense_out[out].axles, axles, "Eixos do veículo %d", first);
+        if (i - first == 1) {
+            uint64_t expected = traffic_gen_travel_us(DENSE_DISTANCE_MM,
+                                                      dense_truth[first].speed_centi_kmh);
+
+            zassert_equal(lane_vehicle_transit(&dense_out[out]), expected,
+                          "Tempo do veículo %d", first);
+            singles++;
+        }
+    }
+    zassert_equal(out, out_count, "Veículos a mais detectados");
+    return singles;
+}
+
+/**
+ * @brief Veículos em sequência densa, com eixos de um ainda entre os
+ *        sensores quando o seguinte chega: velocidade de cada um confere
+ *
+ * Veículos cujo primeiro eixo chega até DENSE_GAP_US depois do último
+ * eixo do anterior são indistinguíveis por intervalo e se fundem; o
+ * teste calcula esses grupos a partir da referência.
+ */
+ZTEST(lane_tracker_tests, test_dense_traffic_speeds)
+{
+    int singles = dense_check(dense_run(dense_build(&dense_cfg), -1, NULL), NULL);
+
+    zassert_true(singles > DENSE_VEHICLES / 2, "Poucos veículos isolados: %d", singles);
+}
+
+/**
+ * @brief Tráfego denso com leves e pesados e o intervalo de agrupamento
+ *        pela velocidade: nenhum caminhão é partido (espaçamentos de até
+ *        6 m) e cada grupo sai com os eixos e o tempo da referência
+ */
+ZTEST(lane_tracker_tests, test_dense_traffic_adaptive_gap)
+{
+    struct traffic_gen_config cfg = dense_cfg;
+
+    cfg.rate_vph[0] = 1200;
+    cfg.heavy_percent = 30;
+
+    int singles = dense_check(dense_run(dense_build(&cfg), -1, &dense_group), &dense_group);
+    int heavy = 0;
+
+    for (int i = 0; i < DENSE_VEHICLES; i++) {
+        heavy += (dense_truth[i].vehicle_type == VEHICLE_TYPE_HEAVY);
+    }
+    zassert_true(heavy > DENSE_VEHICLES / 5, "Poucos pesados: %d", heavy);
+    zassert_true(singles > DENSE_VEHICLES / 2, "Poucos veículos isolados: %d", singles);
+}
+
+/**
+ * @brief Tráfego denso com a borda do sensor 2 do último eixo de um
+ *        veículo perdida: só esse eixo fica sem tempo
+ *
+ * Sem ressincronização, a borda do veículo seguinte fecharia o veículo
+ * e todas as bordas dali em diante cairiam no veículo anterior.
+ */
+ZTEST(lane_tracker_tests, test_dense_traffic_lost_edge)
+{
+    const traffic_gen_shape_t *shape = &traffic_gen_shapes[0];
+    int n_edges = dense_build(&dense_cfg);
+    int lost = -1;
+
+    /*
+     * Veículo no meio do tráfego cuja próxima borda no sensor 2 chega
+     * bem depois da tolerância do último eixo: a perda é detectável
+     */
+    for (int v = DENSE_VEHICLES / 2; v < DENSE_VEHICLES - 1 && lost < 0; v++) {
+        uint32_t speed = dense_truth[v].speed_centi_kmh;
+        uint64_t transit = traffic_gen_travel_us(DENSE_DISTANCE_MM, speed);
+        uint64_t last_s1 = dense_truth[v].arrival_us +
+                           traffic_gen_travel_us(shape->offset_mm[shape->axles - 1], speed);
+        uint64_t next_s2 = dense_truth[v + 1].arrival_us +
+                           traffic_gen_travel_us(DENSE_DISTANCE_MM,
+                                                 dense_truth[v + 1].speed_centi_kmh);
+
+        if (dense_truth[v + 1].arrival_us - last_s1 <= DENSE_GAP_US ||
+            next_s2 - last_s1 <= 2 * transit) {
+            continue;
+        }
+        for (int i = 0; i < n_edges; i++) {
+            if (dense_edges[i].vehicle == v && dense_edges[i].sensor == 2 &&
+                dense_edges[i].axle == shape->axles - 1) {
+                lost = i;
+            }
+        }
+    }
+    zassert_true(lost >= 0, "Nenhum veículo adequado");
+
+    int out_count = dense_run(n_edges, lost, NULL);
+
+    dense_check(out_count, NULL);
+
+    int timed = 0;
+
+    for (int i = 0; i < out_count; i++) {
+        timed += dense_out[i].timed;
+    }
+    zassert_equal(timed, n_edges / 2 - 1, "Só o eixo perdido fica sem tempo");
+}
+
+ZTEST_SUITE(lane_tracker_tests, NULL, NULL, lane_tracker_before, NULL, NULL);
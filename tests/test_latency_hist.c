@@ -0,0 +1,133 @@
+/**
+ * @file test_latency_hist.c
+ * @brief Testes unitários dos histogramas de latência
+ *
+ * Testa as funções:
+ * - latency_bucket_index / latency_bucket_lower_us / latency_bucket_upper_us
+ * - latency_hist_record
+ * - latency_hist_percentile / latency_hist_summary
+ * - latency_hist_reset
+ */
+
+#include <zephyr/ztest.h>
+#include <string.h>
+#include "../src/utils/latency_hist.h"
+
+static struct latency_hist hist;
+
+static void latency_hist_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    latency_hist_reset(&hist);
+}
+
+/**
+ * @brief Cada valor cai no bucket cujos limites o contêm
+ */
+ZTEST(latency_hist_tests, test_bucket_bounds_contain_value)
+{
+    static const uint32_t values[] = {
+        0, 1, 3, 4, 5, 7, 8, 15, 16, 100, 1000, 4095, 4096, 30000, 1000000, 50000000
+    };
+
+    for (size_t i = 0; i < ARRAY_SIZE(values); i++) {
+        uint32_t index = latency_bucket_index(values[i]);
+
+        zassert_true(latency_bucket_lower_us(index) <= values[i],
+                     "Limite inferior acima de %u", values[i]);
+        zassert_true(latency_bucket_upper_us(index) >= values[i],
+                     "Limite superior abaixo de %u", values[i]);
+    }
+
+    /* Buckets contíguos e crescentes */
+    for (uint32_t i = 1; i < LATENCY_HIST_BUCKETS; i++) {
+        zassert_equal(latency_bucket_lower_us(i), latency_bucket_upper_us(i - 1) + 1,
+                      "Buckets %u e %u não são contíguos", i - 1, i);
+    }
+}
+
+/**
+ * @brief Valores acima do último limite acumulam no último bucket
+ */
+ZTEST(latency_hist_tests, test_overflow_goes_to_last_bucket)
+{
+    zassert_equal(latency_bucket_index(UINT32_MAX), LATENCY_HIST_BUCKETS - 1,
+                  "Excesso deve cair no último bucket");
+
+    latency_hist_record(&hist, UINT32_MAX);
+
+    zassert_equal(latency_hist_percentile(&hist, 50), UINT32_MAX,
+                  "Percentil limitado ao máximo exato");
+}
+
+/**
+ * @brief Erro relativo do percentil limitado a 25%
+ */
+ZTEST(latency_hist_tests, test_percentile_resolution)
+{
+    for (uint32_t us = 10; us < 10000000; us = us * 3 + 1) {
+        latency_hist_reset(&hist);
+        latency_hist_record(&hist, us);
+        latency_hist_record(&hist, us + 1000000000);
+
+        uint32_t p50 = latency_hist_percentile(&hist, 50);
+
+        zassert_true(p50 >= us, "p50 abaixo da amostra (%u < %u)", p50, us);
+        zassert_true(p50 - us <= us / 4, "p50 %u longe demais de %u", p50, us);
+    }
+}
+
+/**
+ * @brief p50, p99 e máximo de uma distribuição conhecida
+ */
+ZTEST(latency_hist_tests, test_summary)
+{
+    latency_summary_t s;
+
+    latency_hist_summary(&hist, &s);
+    zassert_equal(s.count, 0, "Histograma novo deve estar vazio");
+    zassert_equal(s.p50_us, 0, "p50 sem amostras deve ser 0");
+    zassert_equal(s.max_us, 0, "Máximo sem amostras deve ser 0");
+
+    /* 98 amostras de 100 us, uma de 5 ms e uma de 20 ms */
+    for (int i = 0; i < 98; i++) {
+        latency_hist_record(&hist, 100);
+    }
+    latency_hist_record(&hist, 5000);
+    latency_hist_record(&hist, 20000);
+
+    latency_hist_summary(&hist, &s);
+    zassert_equal(s.count, 100, "Contagem incorreta");
+    zassert_within(s.p50_us, 100, 25, "p50 incorreto: %u", s.p50_us);
+    zassert_within(s.p99_us, 5000, 1250, "p99 incorreto: %u", s.p99_us);
+    zassert_equal(s.max_us, 20000, "Máximo deve ser exato");
+}
+
+/**
+ * @brief Reset zera contagem, buckets e máximo
+ */
+ZTEST(latency_hist_tests, test_reset)
+{
+    latency_summary_t s;
+
+    latency_hist_record(&hist, 1234);
+    latency_hist_reset(&hist);
+    latency_hist_summary(&hist, &s);
+
+    zassert_equal(s.count, 0, "Contagem deve ser zerada");
+    zassert_equal(s.p99_us, 0, "Buckets devem ser zerados");
+    zassert_equal(s.max_us, 0, "Máximo deve ser zerado");
+}
+
+/**
+ * @brief Toda transição tem nome
+ */
+ZTEST(latency_hist_tests, test_span_names)
+{
+    for (int i = 0; i < LATENCY_SPAN_COUNT; i++) {
+        zassert_not_equal(strcmp(latency_span_name(i), "?"), 0,
+                          "Transição %d sem nome", i);
+    }
+}
+
+ZTEST_SUITE(latency_hist_tests, NULL, NULL, latency_hist_before, NULL, NULL);
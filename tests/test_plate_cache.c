@@ -0,0 +1,148 @@
+/**
+ * @file test_plate_cache.c
+ * @brief Testes unitários do cache de placas recentes
+ *
+ * Testa as funções:
+ * - plate_cache_record (nova, reincidente, duplicata)
+ * - plate_cache_lookup
+ * - expiração por TTL e substituição com a tabela cheia
+ * - uma posição por placa (entrada expirada da placa é reaproveitada)
+ */
+
+#include <zephyr/ztest.h>
+#include <stdio.h>
+#include "../src/utils/plate_cache.h"
+#include "../src/utils/plate_validator.h"
+
+#define TEST_TTL_MS 60000
+#define TEST_DUP_WINDOW_MS 5000
+
+static struct plate_cache cache;
+
+static void plate_cache_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    plate_cache_init(&cache, TEST_TTL_MS, TEST_DUP_WINDOW_MS);
+}
+
+/**
+ * @brief Testa placa nova, reincidente e duplicata
+ */
+ZTEST(plate_cache_tests, test_new_repeat_duplicate)
+{
+    uint64_t key = plate_pack_key("ABC1D23");
+    const plate_cache_entry_t *entry;
+
+    zassert_is_null(plate_cache_lookup(&cache, key, 0), "Cache novo vazio");
+
+    zassert_equal(plate_cache_record(&cache, key, 1000, 7000, &entry), PLATE_CACHE_NEW);
+    zassert_equal(entry->count, 1, "Primeira captura");
+
+    /* Mesma placa 2 s depois: mesma passagem capturada duas vezes */
+    zassert_equal(plate_cache_record(&cache, key, 3000, 7200, &entry),
+                  PLATE_CACHE_DUPLICATE);
+    zassert_equal(entry->count, 1, "Duplicata não conta");
+    zassert_equal(entry->max_speed_centi_kmh, 7200, "Velocidade máxima atualizada");
+
+    /* 20 s depois: nova infração do mesmo veículo */
+    zassert_equal(plate_cache_record(&cache, key, 23000, 6500, &entry),
+                  PLATE_CACHE_REPEAT);
+    zassert_equal(entry->count, 2, "Reincidência conta");
+    zassert_equal(entry->first_seen_ms, 1000, "Primeira captura preservada");
+    zassert_equal(entry->last_seen_ms, 23000, "Última captura atualizada");
+    zassert_equal(entry->max_speed_centi_kmh, 7200, "Máximo preservado");
+
+    entry = plate_cache_lookup(&cache, key, 24000);
+    zassert_not_null(entry, "Placa deve estar no cache");
+    zassert_equal(entry->count, 2);
+}
+
+/**
+ * @brief Testa expiração por TTL
+ */
+ZTEST(plate_cache_tests, test_ttl_expiry)
+{
+    uint64_t key = plate_pack_key("AB123CD");
+
+    plate_cache_record(&cache, key, 0, 6500, NULL);
+    zassert_not_null(plate_cache_lookup(&cache, key, TEST_TTL_MS), "Ainda dentro do TTL");
+    zassert_is_null(plate_cache_lookup(&cache, key, TEST_TTL_MS + 1), "Expirada");
+
+    zassert_equal(plate_cache_record(&cache, key, TEST_TTL_MS + 1, 6000, NULL),
+                  PLATE_CACHE_NEW, "Placa expirada volta como nova");
+}
+
+/**
+ * @brief Testa substituição quando a janela de sondagem está cheia
+ */
+ZTEST(plate_cache_tests, test_full_table_evicts_oldest)
+{
+    char plate[8];
+    uint32_t now = 0;
+
+    /* Enche a tabela além da capacidade, uma placa a cada 10 ms */
+    for (int i = 0; i < 4 * PLATE_CACHE_SIZE; i++, now += 10) {
+        snprintf(plate, sizeof(plate), "ABC%04d", i);
+        plate_cache_record(&cache, plate_pack_key(plate), now, 6000, NULL);
+    }
+
+    /* A mais recente sempre permanece */
+    snprintf(plate, sizeof(plate), "ABC%04d", 4 * PLATE_CACHE_SIZE - 1);
+    zassert_not_null(plate_cache_lookup(&cache, plate_pack_key(plate), now),
+                     "Placa mais recente deve estar no cache");
+
+    /* Nenhuma placa aparece duas vezes */
+    for (int i = 0; i < PLATE_CACHE_SIZE; i++) {
+        for (int j = i + 1; j < PLATE_CACHE_SIZE; j++) {
+            if (cache.entries[i].key != 0) {
+                zassert_not_equal(cache.entries[i].key, cache.entries[j].key,
+                                  "Chave duplicada na tabela");
+            }
+        }
+    }
+}
+
+/**
+ * @brief Testa reuso de posição expirada pela mesma placa
+ */
+ZTEST(plate_cache_tests, test_expired_slot_reused)
+{
+    uint64_t key = plate_pack_key("XYZ9A87");
+    const plate_cache_entry_t *first;
+    const plate_cache_entry_t *second;
+
+    plate_cache_record(&cache, key, 0, 6000, &first);
+    plate_cache_record(&cache, key, 2 * TEST_TTL_MS, 6100, &second);
+
+    zassert_equal_ptr(first, second, "Posição expirada deve ser reaproveitada");
+    zassert_equal(second->count, 1, "Histórico reiniciado após expirar");
+    zassert_equal(second->max_speed_centi_kmh, 6100);
+}
+
+/**
+ * @brief Entrada expirada da placa mais adiante na sondagem é substituída,
+ *        mesmo com posição livre antes dela
+ */
+ZTEST(plate_cache_tests, test_stale_duplicate_replaced)
+{
+    uint64_t key = plate_pack_key("QRS4T56");
+    uint32_t home = plate_cache_slot(key);
+    plate_cache_entry_t *stale = &cache.entries[(home + 2) & (PLATE_CACHE_SIZE - 1)];
+    const plate_cache_entry_t *entry;
+
+    /* Posições home e home + 1 livres, entrada velha da placa em home + 2 */
+    *stale = (plate_cache_entry_t){ .key = key, .last_seen_ms = 0, .count = 3 };
+
+    zassert_equal(plate_cache_record(&cache, key, 2 * TEST_TTL_MS, 7000, &entry),
+                  PLATE_CACHE_NEW);
+    zassert_equal_ptr(entry, stale, "Entrada velha deve ser reaproveitada");
+    zassert_equal(entry->count, 1);
+
+    for (uint32_t i = 0; i < PLATE_CACHE_MAX_PROBE; i++) {
+        const plate_cache_entry_t *e = &cache.entries[(home + i) & (PLATE_CACHE_SIZE - 1)];
+
+        zassert_true(e == stale || e->key != key, "Placa em mais de uma posição");
+    }
+}
+
+ZTEST_SUITE(plate_cache_tests, NULL, NULL, plate_cache_before, NULL, NULL);
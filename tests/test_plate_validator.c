@@ -7,6 +7,8 @@
  * - Argentina: AB123CD
  * - Paraguai: ABCD123
  * - Uruguai: ABC1234
+ * 
+ * E os formatos regionais (Brasil antigo, Chile, Bolívia).
  */
 
 #include <zephyr/ztest.h>
@@ -131,6 +133,72 @@ ZTEST(plate_validator_tests, test_edge_cases)
                   "- não é dígito");
 }
 
+/**
+ * @brief Testa formatos regionais adicionados como dados
+ */
+ZTEST(plate_validator_tests, test_regional_formats)
+{
+    mercosul_country_t country;
+    
+    /* Chile: 4 letras + 2 dígitos (6 caracteres) */
+    zassert_true(validate_mercosul_plate("BCDF12", &country),
+                 "BCDF12 deve ser válida");
+    zassert_equal(country, COUNTRY_CHILE, "Deve identificar como Chile");
+    
+    /* Bolívia: 4 dígitos + 3 letras */
+    zassert_true(validate_mercosul_plate("1234ABC", &country),
+                 "1234ABC deve ser válida");
+    zassert_equal(country, COUNTRY_BOLIVIA, "Deve identificar como Bolívia");
+    
+    /* 6 caracteres fora do padrão chileno */
+    zassert_false(validate_mercosul_plate("BCD123", &country),
+                  "BCD123 deve ser inválida (3L-3N)");
+    zassert_equal(country, COUNTRY_UNKNOWN, "País deve ser UNKNOWN");
+}
+
+/**
+ * @brief Testa ambiguidade entre formatos (prioridade da tabela)
+ */
+ZTEST(plate_validator_tests, test_format_mask)
+{
+    /* ABC1234 casa Uruguai e Brasil antigo; prioridade para Uruguai */
+    uint32_t formats = plate_match_formats("ABC1234");
+    
+    zassert_equal(formats, BIT(PLATE_FMT_URUGUAY) | BIT(PLATE_FMT_BRAZIL_LEGACY),
+                  "ABC1234 deve casar Uruguai e Brasil antigo");
+    zassert_equal(plate_format_country(PLATE_FMT_BRAZIL_LEGACY), COUNTRY_BRAZIL,
+                  "Formato antigo pertence ao Brasil");
+    
+    /* Formato Mercosul brasileiro casa apenas um padrão */
+    zassert_equal(plate_match_formats("ABC1D23"), BIT(PLATE_FMT_BRAZIL),
+                  "ABC1D23 deve casar apenas Brasil");
+    
+    /* Mais longo que qualquer padrão */
+    zassert_equal(plate_match_formats("ABCDEFGHIJ"), 0, "Placa longa não casa");
+    zassert_equal(plate_match_formats(NULL), 0, "NULL não casa");
+}
+
+/**
+ * @brief Testa remoção de espaços da placa do camera_service
+ */
+ZTEST(plate_validator_tests, test_strip_spaces)
+{
+    char plate[8];
+    
+    zassert_equal(plate_strip_spaces(plate, sizeof(plate), "ABC 1D23"), 7,
+                  "Placa limpa tem 7 caracteres");
+    zassert_equal(strcmp(plate, "ABC1D23"), 0, "Espaço deve ser removido");
+    
+    zassert_equal(plate_strip_spaces(plate, sizeof(plate), " AB 123 CD "), 7,
+                  "Espaços em qualquer posição");
+    zassert_equal(strcmp(plate, "AB123CD"), 0, "Espaços devem ser removidos");
+    
+    /* Placa longa: truncada, mas o retorno indica o tamanho real */
+    zassert_equal(plate_strip_spaces(plate, sizeof(plate), "ABC 1D234"), 8,
+                  "Retorno deve indicar truncamento");
+    zassert_equal(strcmp(plate, "ABC1D23"), 0, "Cópia truncada e terminada");
+}
+
 /**
  * @brief Testa função auxiliar get_country_name
  */
@@ -144,6 +212,10 @@ ZTEST(plate_validator_tests, test_country_names)
                   "Nome do Paraguai incorreto");
     zassert_equal(strcmp(get_country_name(COUNTRY_URUGUAY), "Uruguai"), 0,
                   "Nome do Uruguai incorreto");
+    zassert_equal(strcmp(get_country_name(COUNTRY_CHILE), "Chile"), 0,
+                  "Nome do Chile incorreto");
+    zassert_equal(strcmp(get_country_name(COUNTRY_BOLIVIA), "Bolivia"), 0,
+                  "Nome da Bolívia incorreto");
     zassert_equal(strcmp(get_country_name(COUNTRY_UNKNOWN), "Desconhecido"), 0,
                   "Nome para desconhecido incorreto");
 }
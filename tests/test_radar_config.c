@@ -0,0 +1,123 @@
+/**
+ * @file test_radar_config.c
+ * @brief Testes unitários do snapshot de configuração
+ *
+ * Testa as funções:
+ * - radar_config_get
+ * - radar_config_validate
+ * - radar_config_publish
+ * - radar_config_field / radar_config_key
+ */
+
+#include <zephyr/ztest.h>
+#include "../src/utils/radar_config.h"
+
+static struct radar_config_store store;
+
+static void radar_config_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+
+    struct radar_config_store fresh = RADAR_CONFIG_STORE_INITIALIZER(store);
+
+    /* O ponteiro do inicializador aponta para store, não para a cópia */
+    store = fresh;
+}
+
+/**
+ * @brief O snapshot inicial já está publicado com os valores padrão
+ */
+ZTEST(radar_config_tests, test_defaults_published)
+{
+    const radar_config_t *cfg = radar_config_get(&store);
+
+    zassert_not_null(cfg, "Snapshot inicial deve estar publicado");
+    zassert_equal(cfg->version, 0, "Versão inicial deve ser 0");
+    zassert_equal(cfg->sensor_distance_mm, RADAR_CONFIG_DEFAULT_DISTANCE_MM, "Distância");
+    zassert_equal(cfg->speed_limit_light_kmh, RADAR_CONFIG_DEFAULT_LIMIT_LIGHT, "Limite leve");
+    zassert_equal(cfg->speed_limit_heavy_kmh, RADAR_CONFIG_DEFAULT_LIMIT_HEAVY, "Limite pesado");
+    zassert_equal(cfg->warning_threshold_percent, RADAR_CONFIG_DEFAULT_WARNING_PERCENT,
+                  "Limiar de alerta");
+    zassert_ok(radar_config_validate(cfg), "Padrões devem ser válidos");
+}
+
+/**
+ * @brief Publicação troca o ponteiro, incrementa a versão e preserva o anterior
+ */
+ZTEST(radar_config_tests, test_publish_swaps_snapshot)
+{
+    const radar_config_t *old = radar_config_get(&store);
+    radar_config_t next = *old;
+
+    next.speed_limit_light_kmh = 80;
+    next.version = 1234;
+
+    const radar_config_t *published = radar_config_publish(&store, &next);
+
+    zassert_not_null(published, "Publicação válida deve ser aceita");
+    zassert_equal_ptr(radar_config_get(&store), published, "Ponteiro deve ser trocado");
+    zassert_equal(published->version, 1, "Versão deve ser a anterior + 1");
+    zassert_equal(published->speed_limit_light_kmh, 80, "Novo limite");
+    zassert_equal(old->speed_limit_light_kmh, RADAR_CONFIG_DEFAULT_LIMIT_LIGHT,
+                  "Snapshot anterior não pode mudar");
+}
+
+/**
+ * @brief Valores fora da faixa não são publicados
+ */
+ZTEST(radar_config_tests, test_invalid_rejected)
+{
+    const radar_config_t *old = radar_config_get(&store);
+    radar_config_t next = *old;
+
+    next.warning_threshold_percent = 100;
+    zassert_is_null(radar_config_publish(&store, &next), "Alerta 100% deve ser rejeitado");
+
+    next = *old;
+    next.sensor_distance_mm = 0;
+    zassert_is_null(radar_config_publish(&store, &next), "Distância 0 deve ser rejeitada");
+
+    next = *old;
+    next.speed_limit_heavy_kmh = RADAR_CONFIG_LIMIT_MAX_KMH + 1;
+    zassert_is_null(radar_config_publish(&store, &next), "Limite acima do máximo");
+
+    zassert_equal_ptr(radar_config_get(&store), old, "Snapshot não deve mudar");
+}
+
+/**
+ * @brief Um slot só é reutilizado após RADAR_CONFIG_SLOTS - 1 publicações
+ */
+ZTEST(radar_config_tests, test_slot_reuse)
+{
+    const radar_config_t *first = radar_config_get(&store);
+    radar_config_t next = *first;
+
+    for (int i = 1; i < RADAR_CONFIG_SLOTS; i++) {
+        next.speed_limit_heavy_kmh = 40 + i;
+        const radar_config_t *published = radar_config_publish(&store, &next);
+
+        zassert_not_equal(published, first, "Slot reutilizado cedo demais (%d)", i);
+    }
+
+    zassert_equal(first->speed_limit_heavy_kmh, RADAR_CONFIG_DEFAULT_LIMIT_HEAVY,
+                  "Snapshot antigo intacto");
+    zassert_equal(radar_config_get(&store)->version, RADAR_CONFIG_SLOTS - 1, "Versão");
+}
+
+/**
+ * @brief Cada chave aponta para o seu campo
+ */
+ZTEST(radar_config_tests, test_fields_by_key)
+{
+    radar_config_t cfg = { 0 };
+
+    zassert_equal_ptr(radar_config_field(&cfg, "distance_mm"), &cfg.sensor_distance_mm, "");
+    zassert_equal_ptr(radar_config_field(&cfg, "limit_light"), &cfg.speed_limit_light_kmh, "");
+    zassert_equal_ptr(radar_config_field(&cfg, "limit_heavy"), &cfg.speed_limit_heavy_kmh, "");
+    zassert_equal_ptr(radar_config_field(&cfg, "warning_pct"),
+                      &cfg.warning_threshold_percent, "");
+    zassert_is_null(radar_config_field(&cfg, "version"), "Versão não é ajustável");
+    zassert_is_null(radar_config_key(RADAR_CONFIG_KEY_COUNT), "Chave fora da faixa");
+}
+
+ZTEST_SUITE(radar_config_tests, NULL, NULL, radar_config_before, NULL, NULL);
@@ -0,0 +1,105 @@
+/**
+ * @file test_radar_stats.c
+ * @brief Testes unitários dos contadores do pipeline
+ *
+ * Testa as funções:
+ * - radar_stats_detection
+ * - radar_stats_class
+ * - radar_stats_total_detections
+ * - radar_stats_raise
+ * - radar_stats_reset
+ */
+
+#include <zephyr/ztest.h>
+#include "../src/utils/radar_stats.h"
+
+static struct radar_stats stats;
+
+static void radar_stats_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    radar_stats_reset(&stats);
+}
+
+/**
+ * @brief Detecções contadas por classe, por faixa e como infração
+ */
+ZTEST(radar_stats_tests, test_detection_counters)
+{
+    radar_stats_detection(&stats, VEHICLE_TYPE_LIGHT, 0, false);
+    radar_stats_detection(&stats, VEHICLE_TYPE_LIGHT, 1, true);
+    radar_stats_detection(&stats, VEHICLE_TYPE_HEAVY, 1, true);
+
+    zassert_equal(atomic_get(&stats.detections[VEHICLE_TYPE_LIGHT]), 2, "Leves incorreto");
+    zassert_equal(atomic_get(&stats.detections[VEHICLE_TYPE_HEAVY]), 1, "Pesados incorreto");
+    zassert_equal(radar_stats_total_detections(&stats), 3, "Total incorreto");
+    zassert_equal(atomic_get(&stats.violations), 2, "Infrações incorreto");
+    zassert_equal(atomic_get(&stats.lanes[0].detections), 1, "Faixa 0 incorreta");
+    zassert_equal(atomic_get(&stats.lanes[1].detections), 2, "Faixa 1 incorreta");
+    zassert_equal(atomic_get(&stats.lanes[1].violations), 2, "Infrações da faixa 1");
+}
+
+/**
+ * @brief Classes de eixos contadas; fora da faixa é ignorada
+ */
+ZTEST(radar_stats_tests, test_class_counters)
+{
+    radar_stats_class(&stats, VEHICLE_CLASS_TRUCK_5);
+    radar_stats_class(&stats, VEHICLE_CLASS_TRUCK_5);
+    radar_stats_class(&stats, VEHICLE_CLASS_COUNT);
+
+    zassert_equal(atomic_get(&stats.classes[VEHICLE_CLASS_TRUCK_5]), 2, "Classe incorreta");
+    zassert_equal(radar_stats_total_detections(&stats), 0, "Classe não é detecção");
+}
+
+/**
+ * @brief Faixa fora do limite conta no total, mas não corrompe as faixas
+ */
+ZTEST(radar_stats_tests, test_lane_out_of_range)
+{
+    radar_stats_detection(&stats, VEHICLE_TYPE_LIGHT, RADAR_STATS_MAX_LANES, true);
+
+    zassert_equal(radar_stats_total_detections(&stats), 1, "Total deve contar");
+    zassert_equal(atomic_get(&stats.violations), 1, "Infração deve contar");
+    for (int i = 0; i < RADAR_STATS_MAX_LANES; i++) {
+        zassert_equal(atomic_get(&stats.lanes[i].detections), 0, "Faixa %d alterada", i);
+    }
+}
+
+/**
+ * @brief Nível máximo só sobe
+ */
+ZTEST(radar_stats_tests, test_high_water_mark)
+{
+    radar_stats_raise(&stats.sensor_msgq_hwm, 3);
+    radar_stats_raise(&stats.sensor_msgq_hwm, 7);
+    radar_stats_raise(&stats.sensor_msgq_hwm, 5);
+
+    zassert_equal(atomic_get(&stats.sensor_msgq_hwm), 7, "Nível máximo deve ser 7");
+}
+
+/**
+ * @brief Reset zera todos os contadores
+ */
+ZTEST(radar_stats_tests, test_reset)
+{
+    radar_stats_detection(&stats, VEHICLE_TYPE_HEAVY, 0, true);
+    radar_stats_class(&stats, VEHICLE_CLASS_BUS);
+    atomic_inc(&stats.camera_ok);
+    atomic_inc(&stats.journal_drops);
+    atomic_inc(&stats.capture_drops);
+    radar_stats_raise(&stats.display_msgq_hwm, 9);
+
+    radar_stats_reset(&stats);
+
+    zassert_equal(radar_stats_total_detections(&stats), 0, "Detecções devem ser zeradas");
+    zassert_equal(atomic_get(&stats.violations), 0, "Infrações devem ser zeradas");
+    zassert_equal(atomic_get(&stats.classes[VEHICLE_CLASS_BUS]), 0, "Classes devem ser zeradas");
+    zassert_equal(atomic_get(&stats.camera_ok), 0, "Câmera deve ser zerada");
+    zassert_equal(atomic_get(&stats.journal_drops), 0, "Descartes devem ser zerados");
+    zassert_equal(atomic_get(&stats.capture_drops), 0, "Descartes devem ser zerados");
+    zassert_equal(atomic_get(&stats.display_msgq_hwm), 0, "Nível máximo deve ser zerado");
+    zassert_equal(atomic_get(&stats.lanes[0].violations), 0, "Faixa deve ser zerada");
+}
+
+ZTEST_SUITE(radar_stats_tests, NULL, NULL, radar_stats_before, NULL, NULL);
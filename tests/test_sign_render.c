@@ -0,0 +1,126 @@
+/**
+ * @file test_sign_render.c
+ * @brief Testes unitários do painel em framebuffer
+ * 
+ * Testa as funções:
+ * - sign_panel_update (regiões redesenhadas)
+ * - sign_panel_take_dirty
+ * - sign_draw_text / sign_glyph
+ */
+
+#include <zephyr/ztest.h>
+#include "../src/utils/sign_render.h"
+
+static struct sign_panel panel;
+
+static const display_data_msg_t vehicle = {
+    .seq = 1,
+    .speed_centi_kmh = 7012,
+    .vehicle_type = VEHICLE_TYPE_LIGHT,
+    .status = SPEED_STATUS_VIOLATION,
+    .speed_limit = 60,
+    .plate = {0}
+};
+
+static void sign_render_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    sign_panel_init(&panel);
+}
+
+/**
+ * @brief Conta pixels de uma cor dentro de uma região
+ */
+static uint32_t count_pixels(sign_region_t region, uint16_t color)
+{
+    const sign_rect_t *r = &sign_regions[region];
+    uint32_t count = 0;
+
+    for (int y = r->y; y < r->y + r->h; y++) {
+        for (int x = r->x; x < r->x + r->w; x++) {
+            count += (panel.fb[y][x] == color);
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Testa que as regiões cobrem o painel sem sobreposição
+ */
+ZTEST(sign_render_tests, test_regions_tile_panel)
+{
+    uint32_t area = 0;
+
+    for (int r = 0; r < SIGN_REGION_COUNT; r++) {
+        zassert_true(sign_regions[r].x + sign_regions[r].w <= SIGN_WIDTH, "Região %d", r);
+        zassert_true(sign_regions[r].y + sign_regions[r].h <= SIGN_HEIGHT, "Região %d", r);
+        area += (uint32_t)sign_regions[r].w * sign_regions[r].h;
+    }
+    zassert_equal(area, SIGN_WIDTH * SIGN_HEIGHT, "Regiões devem cobrir o painel");
+}
+
+/**
+ * @brief Testa o primeiro desenho (todas as regiões)
+ */
+ZTEST(sign_render_tests, test_first_update_draws_all)
+{
+    zassert_equal(sign_panel_take_dirty(&panel), SIGN_DIRTY_ALL, "Painel novo todo sujo");
+
+    zassert_equal(sign_panel_update(&panel, &vehicle), SIGN_DIRTY_ALL, "Tudo desenhado");
+    zassert_equal(sign_panel_take_dirty(&panel), SIGN_DIRTY_ALL);
+    zassert_equal(sign_panel_take_dirty(&panel), 0, "Máscara zerada após retirar");
+
+    /* Barra de status vermelha, velocidade em vermelho, limite em branco */
+    zassert_equal(panel.fb[0][0], SIGN_COLOR_RED, "Status em vermelho");
+    zassert_true(count_pixels(SIGN_REGION_SPEED, SIGN_COLOR_RED) > 0, "Dígitos da velocidade");
+    zassert_true(count_pixels(SIGN_REGION_LIMIT, SIGN_COLOR_WHITE) > 0, "Limite");
+    zassert_equal(count_pixels(SIGN_REGION_PLATE, SIGN_COLOR_WHITE), 0, "Sem placa");
+}
+
+/**
+ * @brief Testa que a captura da placa suja só a região da placa
+ */
+ZTEST(sign_render_tests, test_plate_only_dirty)
+{
+    display_data_msg_t captured = vehicle;
+
+    sign_panel_update(&panel, &vehicle);
+    sign_panel_take_dirty(&panel);
+
+    zassert_equal(sign_panel_update(&panel, &vehicle), 0, "Mesmos dados, nada a redesenhar");
+
+    strcpy(captured.plate, "ABC1D23");
+    zassert_equal(sign_panel_update(&panel, &captured), BIT(SIGN_REGION_PLATE),
+                  "Só a placa muda");
+    zassert_true(count_pixels(SIGN_REGION_PLATE, SIGN_COLOR_WHITE) > 0, "Placa desenhada");
+
+    /* Centésimos não aparecem no painel */
+    captured.speed_centi_kmh = 7099;
+    zassert_equal(sign_panel_update(&panel, &captured), 0, "Mesma velocidade inteira");
+
+    captured.status = SPEED_STATUS_WARNING;
+    zassert_equal(sign_panel_update(&panel, &captured),
+                  BIT(SIGN_REGION_STATUS) | BIT(SIGN_REGION_SPEED),
+                  "Status muda a barra e a cor da velocidade");
+}
+
+/**
+ * @brief Testa glifos e recorte nas bordas
+ */
+ZTEST(sign_render_tests, test_glyphs_and_clipping)
+{
+    zassert_equal_ptr(sign_glyph('a'), sign_glyph('A'), "Minúsculas como maiúsculas");
+    zassert_equal_ptr(sign_glyph('#'), sign_glyph(' '), "Desconhecido vira espaço");
+
+    /* "1": coluna central acesa de cima a baixo */
+    sign_draw_text(&panel, 0, 0, "1", 1, SIGN_COLOR_WHITE);
+    for (int row = 0; row < SIGN_GLYPH_H; row++) {
+        zassert_equal(panel.fb[row][2], SIGN_COLOR_WHITE, "Linha %d do '1'", row);
+    }
+
+    /* Texto fora do painel não escreve fora do framebuffer */
+    sign_draw_text(&panel, SIGN_WIDTH - 3, SIGN_HEIGHT - 3, "BB", 4, SIGN_COLOR_RED);
+    zassert_equal(panel.fb[SIGN_HEIGHT - 1][SIGN_WIDTH - 1], SIGN_COLOR_RED, "Recortado");
+}
+
+ZTEST_SUITE(sign_render_tests, NULL, NULL, sign_render_before, NULL, NULL);
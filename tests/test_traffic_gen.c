@@ -0,0 +1,198 @@
+/**
+ * @file test_traffic_gen.c
+ * @brief Testes unitários do gerador de tráfego sintético
+ *
+ * Testa as funções:
+ * - traffic_gen_neg_ln_q16 (precisão do logaritmo inteiro)
+ * - traffic_gen_next_edge (ordem, geometria, taxa, rajadas, comboios)
+ */
+
+#include <zephyr/ztest.h>
+#include "../src/utils/traffic_gen.h"
+
+#define HOUR_US (3600ULL * 1000000ULL)
+
+static struct traffic_gen gen;
+
+static const struct traffic_gen_config base_cfg = {
+    .lanes = 1,
+    .rate_vph = { 1200 },
+    .arrivals = TRAFFIC_GEN_POISSON,
+    .speed_mean_kmh = 60,
+    .speed_sd_kmh = 10,
+    .heavy_percent = 0,
+    .platoon_percent = 0,
+    .sensor_distance_mm = 1000,
+};
+
+/**
+ * @brief Conta os veículos (primeiro eixo no sensor 1) de uma faixa em duration_us
+ */
+static uint32_t count_vehicles(struct traffic_gen *g, uint64_t duration_us)
+{
+    traffic_gen_edge_t edge;
+
+    while (traffic_gen_next_edge(g, &edge) && edge.time_us < duration_us) {
+    }
+    return g->vehicles;
+}
+
+/**
+ * @brief Testa -ln(u) em ponto fixo contra valores conhecidos
+ */
+ZTEST(traffic_gen_tests, test_neg_ln)
+{
+    /* u = 1/2: ln 2 = 0,693 */
+    zassert_within(traffic_gen_neg_ln_q16(0x80000000U), 45426, 100);
+    /* u = 1/e^2 ≈ 0,1353: 2,0 */
+    zassert_within(traffic_gen_neg_ln_q16(581260615U), 131072, 300);
+    /* u ≈ 1: ~0 */
+    zassert_within(traffic_gen_neg_ln_q16(0xFFFFFFFFU), 0, 50);
+}
+
+/**
+ * @brief Testa a ordem das bordas e a geometria de um veículo leve
+ */
+ZTEST(traffic_gen_tests, test_edges_ordered_and_timed)
+{
+    traffic_gen_edge_t edge;
+    uint64_t last = 0;
+    uint64_t s1[2];
+    uint64_t s2[2];
+    int n1 = 0;
+    int n2 = 0;
+
+    traffic_gen_init(&gen, &base_cfg, 1234);
+
+    /* Primeiro veículo: 2 eixos, 4 bordas */
+    while (n1 + n2 < 4 && traffic_gen_next_edge(&gen, &edge)) {
+        zassert_true(edge.time_us >= last, "Bordas em ordem de tempo");
+        last = edge.time_us;
+        if (edge.sensor == 1) {
+            s1[n1++] = edge.time_us;
+        } else {
+            s2[n2++] = edge.time_us;
+        }
+    }
+
+    zassert_equal(n1, 2);
+    zassert_equal(n2, 2);
+    zassert_equal(gen.vehicles, 1);
+
+    uint32_t speed = gen.last.speed_centi_kmh;
+
+    zassert_equal(s1[0], gen.last.arrival_us);
+    zassert_equal(s2[0] - s1[0], traffic_gen_travel_us(1000, speed), "Sensor 2 a 1 m");
+    zassert_equal(s1[1] - s1[0], traffic_gen_travel_us(2700, speed), "Eixos a 2,7 m");
+
+    for (int i = 0; i < 1000; i++) {
+        zassert_true(traffic_gen_next_edge(&gen, &edge));
+        zassert_true(edge.time_us >= last, "Bordas em ordem de tempo");
+        last = edge.time_us;
+    }
+}
+
+/**
+ * @brief Testa a taxa média de chegadas Poisson e em rajadas
+ */
+ZTEST(traffic_gen_tests, test_arrival_rates)
+{
+    traffic_gen_init(&gen, &base_cfg, 42);
+    uint32_t poisson = count_vehicles(&gen, 10 * HOUR_US);
+
+    zassert_within(poisson, 12000, 600, "Poisson: 1200 veic/h (%u em 10 h)", poisson);
+
+    struct traffic_gen_config bursty_cfg = base_cfg;
+
+    bursty_cfg.arrivals = TRAFFIC_GEN_BURSTY;
+    traffic_gen_init(&gen, &bursty_cfg, 42);
+    uint32_t bursty = count_vehicles(&gen, 10 * HOUR_US);
+
+    zassert_within(bursty, 12000, 1200, "Rajadas mantêm a média (%u em 10 h)", bursty);
+}
+
+/**
+ * @brief Testa taxas por faixa, classes e faixa sem tráfego
+ */
+ZTEST(traffic_gen_tests, test_lanes_and_classes)
+{
+    struct traffic_gen_config cfg = base_cfg;
+    uint32_t per_lane[3] = {0};
+    uint32_t heavy = 0;
+    traffic_gen_edge_t edge;
+    uint32_t seen = 0;
+
+    cfg.lanes = 3;
+    cfg.rate_vph[0] = 2000;
+    cfg.rate_vph[1] = 500;
+    cfg.rate_vph[2] = 0;
+    cfg.heavy_percent = 20;
+    traffic_gen_init(&gen, &cfg, 7);
+
+    while (gen.vehicles < 5000 && traffic_gen_next_edge(&gen, &edge)) {
+        if (gen.vehicles != seen) {
+            seen = gen.vehicles;
+            per_lane[gen.last.lane_id]++;
+            if (gen.last.vehicle_type == VEHICLE_TYPE_HEAVY) {
+                heavy++;
+                zassert_true(gen.last.axle_count >= 3, "Pesado tem 3+ eixos");
+            }
+        }
+    }
+
+    zassert_equal(per_lane[2], 0, "Faixa sem tráfego");
+    zassert_within(per_lane[0] * 100 / (per_lane[0] + per_lane[1]), 80, 3, "Proporção 4:1");
+    zassert_within(heavy * 100 / 5000, 20, 3, "20%% pesados");
+    zassert_equal(gen.dropped, 0);
+}
+
+/**
+ * @brief Testa comboios: intervalos curtos entre veículos da faixa
+ */
+ZTEST(traffic_gen_tests, test_platoons)
+{
+    struct traffic_gen_config cfg = base_cfg;
+    traffic_gen_edge_t edge;
+    uint64_t prev_arrival = 0;
+    uint32_t short_gaps = 0;
+    uint32_t seen = 0;
+
+    cfg.rate_vph[0] = 60;          /* Sem comboio, intervalo médio de 60 s */
+    cfg.platoon_percent = 100;
+    traffic_gen_init(&gen, &cfg, 99);
+
+    while (gen.vehicles < 400 && traffic_gen_next_edge(&gen, &edge)) {
+        if (gen.vehicles != seen) {
+            seen = gen.vehicles;
+            if (seen > 1 && gen.last.arrival_us - prev_arrival <= TRAFFIC_GEN_PLATOON_MAX_GAP_US) {
+                short_gaps++;
+            }
+            prev_arrival = gen.last.arrival_us;
+        }
+    }
+
+    /* Cada líder puxa 1 a 3 seguidores: ao menos metade dos intervalos é curta */
+    zassert_true(short_gaps > 200, "Comboios devem gerar intervalos curtos (%u)", short_gaps);
+}
+
+/**
+ * @brief Testa que a mesma semente reproduz a mesma sequência
+ */
+ZTEST(traffic_gen_tests, test_deterministic)
+{
+    static struct traffic_gen other;
+    traffic_gen_edge_t a;
+    traffic_gen_edge_t b;
+
+    traffic_gen_init(&gen, &base_cfg, 5);
+    traffic_gen_init(&other, &base_cfg, 5);
+
+    for (int i = 0; i < 500; i++) {
+        zassert_true(traffic_gen_next_edge(&gen, &a));
+        zassert_true(traffic_gen_next_edge(&other, &b));
+        zassert_equal(a.time_us, b.time_us);
+        zassert_equal(a.sensor, b.sensor);
+    }
+}
+
+ZTEST_SUITE(traffic_gen_tests, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,153 @@
+/**
+ * @file test_traffic_stats.c
+ * @brief Testes unitários das estatísticas de tráfego
+ *
+ * Testa as funções:
+ * - traffic_stats_record
+ * - traffic_stats_get (minuto, hora, dia e retenção)
+ * - traffic_bucket_mean_speed / traffic_bucket_mean_headway
+ * - traffic_bucket_speed_percentile
+ */
+
+#include <zephyr/ztest.h>
+#include "../src/utils/traffic_stats.h"
+
+#define MIN_MS (60LL * 1000)
+#define HOUR_MS (60LL * MIN_MS)
+
+static struct traffic_stats stats;
+
+static void traffic_stats_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+    traffic_stats_init(&stats);
+}
+
+/**
+ * @brief Testa contadores, classes e headway de um minuto
+ */
+ZTEST(traffic_stats_tests, test_minute_bucket)
+{
+    traffic_bucket_t bucket;
+
+    traffic_stats_record(&stats, 0, 1000, VEHICLE_TYPE_LIGHT, 5500, false);
+    traffic_stats_record(&stats, 0, 3000, VEHICLE_TYPE_HEAVY, 4200, true);
+    traffic_stats_record(&stats, 0, 8000, VEHICLE_TYPE_LIGHT, 6100, true);
+    /* Outra faixa não interfere */
+    traffic_stats_record(&stats, 1, 2000, VEHICLE_TYPE_LIGHT, 9000, true);
+
+    zassert_ok(traffic_stats_get(&stats, 0, TRAFFIC_RES_MINUTE, 9000, 0, &bucket));
+    zassert_equal(bucket.period, 0, "Primeiro minuto");
+    zassert_equal(bucket.vehicles, 3);
+    zassert_equal(bucket.by_class[VEHICLE_TYPE_LIGHT], 2);
+    zassert_equal(bucket.by_class[VEHICLE_TYPE_HEAVY], 1);
+    zassert_equal(bucket.violations, 2);
+    zassert_equal(bucket.speed_max_centi_kmh, 6100);
+    zassert_equal(traffic_bucket_mean_speed(&bucket), (5500 + 4200 + 6100) / 3);
+
+    /* Headways: 2000 e 5000 ms (o primeiro veículo não tem) */
+    zassert_equal(bucket.headways, 2);
+    zassert_equal(bucket.headway_min_ms, 2000);
+    zassert_equal(traffic_bucket_mean_headway(&bucket), 3500);
+
+    /* Histograma: 40-50, 50-60 e 60-70 km/h */
+    zassert_equal(bucket.speed_hist[4], 1);
+    zassert_equal(bucket.speed_hist[5], 1);
+    zassert_equal(bucket.speed_hist[6], 1);
+
+    zassert_ok(traffic_stats_get(&stats, 1, TRAFFIC_RES_MINUTE, 9000, 0, &bucket));
+    zassert_equal(bucket.vehicles, 1, "Faixa 1 tem seu próprio bucket");
+    zassert_equal(bucket.headways, 0, "Sem headway no primeiro veículo");
+}
+
+/**
+ * @brief Testa agregação por hora e dia a partir de vários minutos
+ */
+ZTEST(traffic_stats_tests, test_rollup_hour_and_day)
+{
+    traffic_bucket_t bucket;
+    int64_t now = 0;
+
+    /* Um veículo por minuto durante 90 minutos */
+    for (int i = 0; i < 90; i++, now += MIN_MS) {
+        traffic_stats_record(&stats, 0, now, VEHICLE_TYPE_LIGHT, 5000, false);
+    }
+    now -= MIN_MS;
+
+    zassert_ok(traffic_stats_get(&stats, 0, TRAFFIC_RES_MINUTE, now, 0, &bucket));
+    zassert_equal(bucket.vehicles, 1, "Um veículo no minuto corrente");
+
+    zassert_ok(traffic_stats_get(&stats, 0, TRAFFIC_RES_HOUR, now, 0, &bucket));
+    zassert_equal(bucket.vehicles, 30, "Segunda hora: minutos 60 a 89");
+    zassert_ok(traffic_stats_get(&stats, 0, TRAFFIC_RES_HOUR, now, 1, &bucket));
+    zassert_equal(bucket.vehicles, 60, "Primeira hora completa");
+    zassert_equal(bucket.headway_min_ms, MIN_MS);
+
+    zassert_ok(traffic_stats_get(&stats, 0, TRAFFIC_RES_DAY, now, 0, &bucket));
+    zassert_equal(bucket.vehicles, 90, "Dia inclui todos");
+}
+
+/**
+ * @brief Testa buckets sem tráfego e retenção dos anéis
+ */
+ZTEST(traffic_stats_tests, test_empty_periods_and_retention)
+{
+    traffic_bucket_t bucket;
+
+    traffic_stats_record(&stats, 0, 0, VEHICLE_TYPE_LIGHT, 5000, false);
+
+    /* 61 minutos depois o bucket do minuto 0 saiu do anel */
+    int64_t now = 61 * MIN_MS;
+
+    zassert_equal(traffic_stats_get(&stats, 0, TRAFFIC_RES_MINUTE, now, 61, &bucket),
+                  -ENOENT, "Além da retenção por minuto");
+
+    /* Minuto corrente sem tráfego: bucket vazio com o período pedido */
+    zassert_ok(traffic_stats_get(&stats, 0, TRAFFIC_RES_MINUTE, now, 0, &bucket));
+    zassert_equal(bucket.vehicles, 0, "Minuto sem tráfego");
+    zassert_equal(bucket.period, 61);
+
+    /* Novo veículo no minuto 60 reutiliza o slot do minuto 0 */
+    traffic_stats_record(&stats, 0, 60 * MIN_MS, VEHICLE_TYPE_HEAVY, 3000, false);
+    zassert_ok(traffic_stats_get(&stats, 0, TRAFFIC_RES_MINUTE, 60 * MIN_MS, 0, &bucket));
+    zassert_equal(bucket.vehicles, 1, "Slot reutilizado deve ser zerado");
+    zassert_equal(bucket.headway_min_ms, 60 * MIN_MS, "Headway entre os dois veículos");
+
+    zassert_ok(traffic_stats_get(&stats, 0, TRAFFIC_RES_HOUR, 60 * MIN_MS, 1, &bucket));
+    zassert_equal(bucket.vehicles, 1, "Hora anterior preservada");
+
+    zassert_equal(traffic_stats_get(&stats, 0, TRAFFIC_RES_HOUR, HOUR_MS, 2, &bucket),
+                  -ENOENT, "Antes do boot");
+    zassert_equal(traffic_stats_get(&stats, TRAFFIC_MAX_LANES, TRAFFIC_RES_HOUR, 0, 0, &bucket),
+                  -EINVAL, "Faixa inválida");
+    zassert_equal(traffic_stats_record(&stats, TRAFFIC_MAX_LANES, 0, VEHICLE_TYPE_LIGHT,
+                                       5000, false),
+                  -EINVAL, "Faixa inválida");
+}
+
+/**
+ * @brief Testa percentis pelo histograma
+ */
+ZTEST(traffic_stats_tests, test_speed_percentile)
+{
+    traffic_bucket_t bucket;
+
+    zassert_ok(traffic_stats_get(&stats, 0, TRAFFIC_RES_MINUTE, 0, 0, &bucket));
+    zassert_equal(traffic_bucket_speed_percentile(&bucket, 50), 0, "Sem veículos");
+
+    /* 90 veículos a 45 km/h, 10 a 85 km/h, 1 acima de 150 km/h */
+    for (int i = 0; i < 90; i++) {
+        traffic_stats_record(&stats, 0, i, VEHICLE_TYPE_LIGHT, 4500, false);
+    }
+    for (int i = 0; i < 10; i++) {
+        traffic_stats_record(&stats, 0, 100 + i, VEHICLE_TYPE_LIGHT, 8500, true);
+    }
+    traffic_stats_record(&stats, 0, 200, VEHICLE_TYPE_LIGHT, 20000, true);
+
+    zassert_ok(traffic_stats_get(&stats, 0, TRAFFIC_RES_MINUTE, 200, 0, &bucket));
+    zassert_equal(traffic_bucket_speed_percentile(&bucket, 50), 50, "p50 na faixa 40-50");
+    zassert_equal(traffic_bucket_speed_percentile(&bucket, 95), 90, "p95 na faixa 80-90");
+    zassert_equal(traffic_bucket_speed_percentile(&bucket, 100), 160, "Máximo na última faixa");
+}
+
+ZTEST_SUITE(traffic_stats_tests, NULL, NULL, traffic_stats_before, NULL, NULL);
@@ -0,0 +1,106 @@
+/**
+ * @file test_vehicle_pool.c
+ * @brief Testes unitários dos registros de veículo com referências
+ *
+ * Testa as funções:
+ * - vehicle_record_alloc (registro zerado, pool esgotado)
+ * - vehicle_record_ref / vehicle_record_unref
+ * - vehicle_record_set_plate / vehicle_record_to_display / vehicle_record_to_violation
+ */
+
+#include <zephyr/ztest.h>
+#include <string.h>
+#include "../src/utils/vehicle_pool.h"
+
+#define TEST_POOL_SIZE 4
+
+K_MEM_SLAB_DEFINE_STATIC(test_pool, sizeof(vehicle_record_t), TEST_POOL_SIZE, 4);
+
+/**
+ * @brief Testa que a última referência devolve o registro ao pool
+ */
+ZTEST(vehicle_pool_tests, test_refcount_frees_on_last_unref)
+{
+    vehicle_record_t *vehicle = vehicle_record_alloc(&test_pool);
+
+    zassert_not_null(vehicle);
+    zassert_equal(atomic_get(&vehicle->refs), 1, "Alocado com uma referência");
+    zassert_equal(vehicle->seq, 0, "Registro zerado");
+    zassert_false(vehicle_record_has_plate(vehicle));
+
+    /* Display e câmera recebem o mesmo ponteiro */
+    zassert_equal_ptr(vehicle_record_ref(vehicle), vehicle);
+    vehicle_record_ref(vehicle);
+
+    vehicle_record_unref(vehicle);
+    vehicle_record_unref(vehicle);
+    zassert_equal(k_mem_slab_num_used_get(&test_pool), 1, "Ainda referenciado");
+
+    vehicle_record_unref(vehicle);
+    zassert_equal(k_mem_slab_num_used_get(&test_pool), 0, "Devolvido ao pool");
+}
+
+/**
+ * @brief Testa o pool esgotado
+ */
+ZTEST(vehicle_pool_tests, test_pool_exhausted)
+{
+    vehicle_record_t *vehicles[TEST_POOL_SIZE];
+
+    for (int i = 0; i < TEST_POOL_SIZE; i++) {
+        vehicles[i] = vehicle_record_alloc(&test_pool);
+        zassert_not_null(vehicles[i]);
+    }
+
+    zassert_is_null(vehicle_record_alloc(&test_pool), "Pool esgotado");
+
+    vehicle_record_unref(vehicles[0]);
+    vehicles[0] = vehicle_record_alloc(&test_pool);
+    zassert_not_null(vehicles[0], "Bloco liberado é reutilizado");
+
+    for (int i = 0; i < TEST_POOL_SIZE; i++) {
+        vehicle_record_unref(vehicles[i]);
+    }
+    zassert_equal(k_mem_slab_num_used_get(&test_pool), 0);
+}
+
+/**
+ * @brief Testa a placa e as visões do display e do journal
+ */
+ZTEST(vehicle_pool_tests, test_plate_and_views)
+{
+    vehicle_record_t *vehicle = vehicle_record_alloc(&test_pool);
+    display_data_msg_t frame;
+    violation_record_t record;
+
+    vehicle->seq = 42;
+    vehicle->lane_id = 1;
+    vehicle->vehicle_type = VEHICLE_TYPE_HEAVY;
+    vehicle->speed_centi_kmh = 5512;
+    vehicle->speed_limit = 40;
+    vehicle->status = SPEED_STATUS_VIOLATION;
+
+    vehicle_record_to_display(vehicle, &frame);
+    zassert_equal(frame.seq, 42);
+    zassert_equal(frame.lane_id, 1);
+    zassert_equal(frame.speed_centi_kmh, 5512);
+    zassert_equal(frame.plate[0], '\0', "Sem placa antes da captura");
+
+    vehicle_record_set_plate(vehicle, "ABC1D23", 1234);
+    zassert_true(vehicle_record_has_plate(vehicle));
+
+    vehicle_record_to_display(vehicle, &frame);
+    zassert_str_equal(frame.plate, "ABC1D23");
+
+    vehicle_record_to_violation(vehicle, &record);
+    zassert_equal(record.uptime_ms, 1234, "Instante da captura");
+    zassert_equal(record.speed_centi_kmh, 5512);
+    zassert_equal(record.speed_limit, 40);
+    zassert_equal(record.vehicle_type, VEHICLE_TYPE_HEAVY);
+    zassert_equal(record.lane_id, 1);
+    zassert_mem_equal(record.plate, "ABC1D23", 8);
+
+    vehicle_record_unref(vehicle);
+}
+
+ZTEST_SUITE(vehicle_pool_tests, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,226 @@
+/**
+ * @file test_violation_journal.c
+ * @brief Testes unitários do journal de infrações (flash simulada)
+ *
+ * Testa as funções:
+ * - violation_journal_init (journal novo, recuperação após reboot e após
+ *   reset entre o lote e o cabeçalho)
+ * - violation_journal_add / violation_journal_flush
+ * - violation_journal_full (lote cheio não aceita mais registros)
+ * - violation_journal_read
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+#include <string.h>
+#include "../src/utils/violation_journal.h"
+
+static struct nvs_fs fs;
+static struct violation_journal journal;
+
+/**
+ * @brief Monta o NVS como no boot (sem apagar)
+ */
+static void journal_remount(void)
+{
+    struct flash_pages_info info;
+
+    memset(&fs, 0, sizeof(fs));
+    fs.flash_device = FIXED_PARTITION_DEVICE(storage_partition);
+    fs.offset = FIXED_PARTITION_OFFSET(storage_partition);
+    zassert_ok(flash_get_page_info_by_offs(fs.flash_device, fs.offset, &info));
+    fs.sector_size = info.size;
+    fs.sector_count = FIXED_PARTITION_SIZE(storage_partition) / info.size;
+
+    zassert_ok(nvs_mount(&fs), "NVS deve montar");
+    zassert_ok(violation_journal_init(&journal, &fs), "Journal deve iniciar");
+}
+
+static void journal_before(void *fixture)
+{
+    ARG_UNUSED(fixture);
+
+    const struct device *dev = FIXED_PARTITION_DEVICE(storage_partition);
+
+    zassert_true(device_is_ready(dev), "Flash simulada deve estar pronta");
+    zassert_ok(flash_erase(dev, FIXED_PARTITION_OFFSET(storage_partition),
+                           FIXED_PARTITION_SIZE(storage_partition)));
+    journal_remount();
+}
+
+static violation_record_t make_record(uint32_t n)
+{
+    violation_record_t record = {
+        .uptime_ms = 1000 + n,
+        .speed_centi_kmh = 6000 + n,
+        .speed_limit = 60,
+        .vehicle_type = VEHICLE_TYPE_LIGHT,
+        .lane_id = (uint8_t)(n % 2),
+        .plate = "ABC1D23",
+    };
+
+    return record;
+}
+
+/**
+ * @brief Testa journal novo
+ */
+ZTEST(violation_journal_tests, test_empty_journal)
+{
+    journal_batch_t batch;
+
+    zassert_equal(journal.header.boot_count, 1, "Primeiro boot");
+    zassert_equal(violation_journal_batches(&journal), 0, "Journal vazio");
+    zassert_equal(violation_journal_read(&journal, 0, &batch), -ENOENT,
+                  "Nada para ler");
+    zassert_ok(violation_journal_flush(&journal), "Flush vazio não falha");
+    zassert_equal(violation_journal_batches(&journal), 0, "Flush vazio não grava");
+}
+
+/**
+ * @brief Testa lote cheio e leitura de volta
+ */
+ZTEST(violation_journal_tests, test_full_batch_roundtrip)
+{
+    journal_batch_t batch;
+
+    for (uint32_t i = 0; i < JOURNAL_BATCH_RECORDS; i++) {
+        violation_record_t record = make_record(i);
+        bool full = violation_journal_add(&journal, &record);
+
+        zassert_equal(full, i == JOURNAL_BATCH_RECORDS - 1,
+                      "Lote só fica cheio no último registro");
+    }
+
+    zassert_equal(violation_journal_batches(&journal), 0, "Nada gravado antes do flush");
+    zassert_ok(violation_journal_flush(&journal));
+    zassert_equal(violation_journal_pending(&journal), 0, "Lote em formação esvaziado");
+    zassert_equal(violation_journal_batches(&journal), 1, "Um lote gravado");
+
+    zassert_ok(violation_journal_read(&journal, 0, &batch));
+    zassert_equal(batch.count, JOURNAL_BATCH_RECORDS, "Lote completo");
+    for (uint32_t i = 0; i < JOURNAL_BATCH_RECORDS; i++) {
+        violation_record_t expected = make_record(i);
+
+        zassert_mem_equal(&batch.records[i], &expected, sizeof(expected),
+                          "Registro lido difere do gravado");
+    }
+}
+
+/**
+ * @brief Lote cheio não gravado não aceita registros até o flush
+ *
+ * É o estado depois de uma gravação que falhou: o chamador deve parar
+ * de adicionar (a thread do journal deixa as infrações na fila).
+ */
+ZTEST(violation_journal_tests, test_full_batch_until_flush)
+{
+    violation_record_t record;
+
+    zassert_false(violation_journal_full(&journal), "Lote vazio");
+    for (uint32_t n = 0; n < JOURNAL_BATCH_RECORDS; n++) {
+        record = make_record(n);
+        zassert_equal(violation_journal_add(&journal, &record),
+                      n == JOURNAL_BATCH_RECORDS - 1, "Cheio só no último registro");
+    }
+    zassert_true(violation_journal_full(&journal));
+
+    record = make_record(99);
+    zassert_true(violation_journal_add(&journal, &record), "Continua cheio");
+    zassert_equal(violation_journal_pending(&journal), JOURNAL_BATCH_RECORDS,
+                  "Registro excedente não entra no lote");
+
+    zassert_ok(violation_journal_flush(&journal));
+    zassert_false(violation_journal_full(&journal), "Lote gravado libera o próximo");
+}
+
+/**
+ * @brief Testa recuperação após reboot
+ */
+ZTEST(violation_journal_tests, test_recovery_after_reboot)
+{
+    journal_batch_t batch;
+    violation_record_t record = make_record(7);
+
+    violation_journal_add(&journal, &record);
+    zassert_ok(violation_journal_flush(&journal));
+
+    /* Registro só em RAM é perdido no reboot */
+    violation_journal_add(&journal, &record);
+
+    journal_remount();
+
+    zassert_equal(journal.header.boot_count, 2, "Boot deve ser contado");
+    zassert_equal(violation_journal_pending(&journal), 0, "Lote em formação não persiste");
+    zassert_equal(violation_journal_batches(&journal), 1, "Lote gravado recuperado");
+    zassert_ok(violation_journal_read(&journal, 0, &batch));
+    zassert_equal(batch.count, 1, "Lote parcial com um registro");
+    zassert_equal(batch.boot, 1, "Lote gravado no primeiro boot");
+    zassert_mem_equal(&batch.records[0], &record, sizeof(record));
+}
+
+/**
+ * @brief Reset entre o lote e o cabeçalho: o lote não é sobrescrito
+ */
+ZTEST(violation_journal_tests, test_recovery_after_torn_flush)
+{
+    journal_batch_t batch;
+    violation_record_t first = make_record(1);
+    violation_record_t second = make_record(2);
+
+    violation_journal_add(&journal, &first);
+    zassert_ok(violation_journal_flush(&journal));
+
+    /* Lote 1 gravado, cabeçalho ainda aponta para ele */
+    batch.seq = journal.header.next_seq;
+    batch.boot = (uint16_t)journal.header.boot_count;
+    batch.count = 1;
+    batch.reserved = 0;
+    batch.records[0] = second;
+    zassert_true(nvs_write(&fs, JOURNAL_ID_FIRST_BATCH + batch.seq % JOURNAL_MAX_BATCHES,
+                           &batch, JOURNAL_BATCH_BYTES(1)) > 0);
+
+    journal_remount();
+
+    zassert_equal(violation_journal_batches(&journal), 2, "Lote sem cabeçalho recuperado");
+    zassert_ok(violation_journal_read(&journal, 1, &batch));
+    zassert_mem_equal(&batch.records[0], &second, sizeof(second));
+
+    /* O próximo flush vai para o lote 2 */
+    violation_journal_add(&journal, &first);
+    zassert_ok(violation_journal_flush(&journal));
+    zassert_ok(violation_journal_read(&journal, 1, &batch));
+    zassert_mem_equal(&batch.records[0], &second, sizeof(second), "Lote 1 preservado");
+    zassert_equal(violation_journal_batches(&journal), 3);
+}
+
+/**
+ * @brief Testa substituição dos lotes mais antigos
+ */
+ZTEST(violation_journal_tests, test_wraps_oldest_batch)
+{
+    journal_batch_t batch;
+
+    for (uint32_t n = 0; n < JOURNAL_MAX_BATCHES + 3; n++) {
+        violation_record_t record = make_record(n);
+
+        violation_journal_add(&journal, &record);
+        zassert_ok(violation_journal_flush(&journal), "Flush %u falhou", n);
+    }
+
+    zassert_equal(violation_journal_batches(&journal), JOURNAL_MAX_BATCHES,
+                  "Journal limitado a JOURNAL_MAX_BATCHES");
+
+    zassert_ok(violation_journal_read(&journal, 0, &batch));
+    zassert_equal(batch.seq, 3, "Mais antigo disponível é o lote 3");
+    zassert_equal(batch.records[0].uptime_ms, 1003, "Conteúdo do lote 3");
+
+    zassert_ok(violation_journal_read(&journal, JOURNAL_MAX_BATCHES - 1, &batch));
+    zassert_equal(batch.seq, JOURNAL_MAX_BATCHES + 2, "Mais recente é o último gravado");
+
+    zassert_equal(violation_journal_read(&journal, JOURNAL_MAX_BATCHES, &batch), -ENOENT,
+                  "Fora do journal");
+}
+
+ZTEST_SUITE(violation_journal_tests, NULL, NULL, journal_before, NULL, NULL);
@@ -0,0 +1,136 @@
+/**
+ * @file test_zero_heap.c
+ * @brief Caminho de regime sem heap
+ *
+ * Percorre, milhares de vezes, o caminho de uma infração com as mesmas
+ * estruturas da aplicação: registro do pool, detection_store,
+ * traffic_stats, trigger por um canal ZBUS com MSG_SUBSCRIBER ligado em
+ * tempo de compilação, cache de placas, fusão do display e registro do
+ * journal. O heap do sistema não pode ter alocação alguma depois do boot.
+ *
+ * As threads e handlers reais são conferidos no native_sim pelo gerador
+ * de tráfego (trafgen_thread.c), com a mesma medição do heap.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/sys/sys_heap.h>
+#include "../src/utils/vehicle_pool.h"
+#include "../src/utils/detection_store.h"
+#include "../src/utils/traffic_stats.h"
+#include "../src/utils/plate_cache.h"
+#include "../src/utils/plate_validator.h"
+#include "../src/utils/display_coalesce.h"
+
+#define TEST_VIOLATIONS 5000
+
+/* Heap do sistema (CONFIG_HEAP_MEM_POOL_SIZE) */
+extern struct k_heap _system_heap;
+
+K_MEM_SLAB_DEFINE_STATIC(zero_heap_pool, sizeof(vehicle_record_t), 4, 4);
+
+ZBUS_CHAN_DEFINE(zero_heap_trigger_chan,
+                 camera_trigger_event_t,
+                 NULL,
+                 NULL,
+                 ZBUS_OBSERVERS_EMPTY,
+                 ZBUS_MSG_INIT(0));
+BUILD_ASSERT(sizeof(camera_trigger_event_t) <= CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_STATIC_DATA_SIZE);
+
+ZBUS_MSG_SUBSCRIBER_DEFINE(zero_heap_trigger_sub);
+ZBUS_CHAN_ADD_OBS(zero_heap_trigger_chan, zero_heap_trigger_sub, 3);
+
+static struct detection_store store;
+static struct traffic_stats stats;
+static struct plate_cache plates;
+static struct display_coalescer coalescer;
+
+static size_t heap_allocated_bytes(void)
+{
+    struct sys_memory_stats heap_stats;
+
+    zassert_ok(sys_heap_runtime_stats_get(&_system_heap.heap, &heap_stats));
+    return heap_stats.allocated_bytes;
+}
+
+/**
+ * @brief A medição enxerga uma alocação (controle do teste)
+ */
+ZTEST(zero_heap_tests, test_heap_stats_detect_allocation)
+{
+    size_t before = heap_allocated_bytes();
+    void *mem = k_malloc(16);
+
+    zassert_not_null(mem);
+    zassert_true(heap_allocated_bytes() > before, "Alocação deve aparecer nas estatísticas");
+    k_free(mem);
+    zassert_equal(heap_allocated_bytes(), before);
+}
+
+/**
+ * @brief Milhares de infrações sem tocar no heap
+ */
+ZTEST(zero_heap_tests, test_violation_path_without_heap)
+{
+    const struct zbus_channel *chan;
+    camera_trigger_event_t trigger;
+    display_data_msg_t frame;
+    violation_record_t record;
+    char plate[8] = "ABC1D23";
+
+    detection_store_init(&store);
+    traffic_stats_init(&stats);
+    plate_cache_init(&plates, 60000, 1000);
+    display_coalescer_init(&coalescer);
+
+    size_t before = heap_allocated_bytes();
+
+    for (uint32_t i = 0; i < TEST_VIOLATIONS; i++) {
+        uint32_t now = i * 100U;
+        vehicle_record_t *vehicle = vehicle_record_alloc(&zero_heap_pool);
+
+        zassert_not_null(vehicle, "Pool não pode vazar (veículo %u)", i);
+
+        /* Sensor e thread principal */
+        vehicle->lane_id = i % 2;
+        vehicle->vehicle_type = VEHICLE_TYPE_LIGHT;
+        vehicle->seq = i + 1;
+        vehicle->speed_centi_kmh = 7000 + i % 1000;
+        vehicle->speed_limit = 60;
+        vehicle->status = SPEED_STATUS_VIOLATION;
+        vehicle->store_seq = detection_store_append(&store, now, vehicle->speed_centi_kmh,
+                                                    vehicle->speed_limit,
+                                                    vehicle->vehicle_type, vehicle->lane_id);
+        traffic_stats_record(&stats, vehicle->lane_id, now, vehicle->vehicle_type,
+                             vehicle->speed_centi_kmh, true);
+
+        /* Trigger da câmera pelo ZBUS */
+        camera_trigger_event_t out = {
+            .request_id = i + 1,
+            .vehicle = vehicle_record_ref(vehicle),
+        };
+
+        zassert_ok(zbus_chan_pub(&zero_heap_trigger_chan, &out, K_NO_WAIT));
+        zassert_ok(zbus_sub_wait_msg(&zero_heap_trigger_sub, &chan, &trigger, K_NO_WAIT));
+        zassert_equal_ptr(trigger.vehicle, vehicle);
+        vehicle_record_unref(trigger.vehicle);
+
+        /* Estágio de captura, display e journal */
+        plate[4] = (char)('A' + i % 26);
+        vehicle_record_set_plate(vehicle, plate, now);
+        detection_store_set_plate(&store, vehicle->store_seq, plate_pack_key(plate));
+        plate_cache_record(&plates, plate_pack_key(plate), now, vehicle->speed_centi_kmh, NULL);
+
+        vehicle_record_to_display(vehicle, &frame);
+        display_coalescer_offer(&coalescer, &frame);
+        display_coalescer_take(&coalescer, &frame);
+        vehicle_record_to_violation(vehicle, &record);
+
+        vehicle_record_unref(vehicle);
+    }
+
+    zassert_equal(heap_allocated_bytes(), before, "Nenhuma alocação no heap em regime");
+    zassert_equal(k_mem_slab_num_used_get(&zero_heap_pool), 0, "Todos os registros devolvidos");
+}
+
+ZTEST_SUITE(zero_heap_tests, NULL, NULL, NULL, NULL, NULL);